@@ -37,9 +37,8 @@ int main(int argc, const char *argv[])
 		return 1;
 	}
 	
-	SvfitEventKey svfitEventKey;
-	SvfitInputs svfitInputs;
-	SvfitResults svfitResults;
+	SvfitCacheBranches inputBranches;
+	SvfitCacheBranches outputBranches;
 	SvfitTools svfitTools;
 
 	std::string inputFilename = vm["inputfile"].as<std::string>();
@@ -51,17 +50,14 @@ int main(int argc, const char *argv[])
 	std::cout << "Reading input tree \"" << treePath << "\"..." << std::endl;
 	TTree *inputTree = (TTree*)inputFile->Get(treePath.c_str());
 	
-	svfitEventKey.SetBranchAddresses(inputTree);
-	svfitInputs.SetBranchAddresses(inputTree);
-	svfitResults.SetBranchAddresses(inputTree);
+	inputBranches.SetBranchAddresses(inputTree);
+	inputBranches.ActivateResultsBranches(inputTree, false);
 
 	std::string outputFilename = vm["outputfile"].as<std::string>();
 	TFile *outputFile = new TFile(outputFilename.c_str(), "RECREATE");
 	TTree *outputTree = new TTree("svfitCache", "svfitCache");
 	
-	svfitEventKey.CreateBranches(outputTree);
-	//svfitInputs.CreateBranches(outputTree);
-	svfitResults.CreateBranches(outputTree);
+	outputBranches.CreateBranches(outputTree, false);
 
 	HttEnumTypes::SvfitCacheMissBehaviour svfitCacheMissBehaviour = HttEnumTypes::SvfitCacheMissBehaviour::recalculate;
 	bool svfitCalculated = false;
@@ -72,8 +68,8 @@ int main(int argc, const char *argv[])
 		std::cout << "Entry: " << entry+1 << " / " << nEntries << std::endl;
 		inputTree->GetEntry(entry);
 		
-		svfitResults = svfitTools.GetResults(svfitEventKey, svfitInputs, svfitCalculated, svfitCacheMissBehaviour);
-		svfitResults.SetBranchAddresses(outputTree);
+		SvfitResults const& svfitResults = svfitTools.GetResults(inputBranches.svfitEventKey, inputBranches.svfitInputs, svfitCalculated, svfitCacheMissBehaviour);
+		outputBranches.Set(inputBranches.svfitEventKey, inputBranches.svfitInputs, svfitResults);
 		outputTree->Fill();
 	}
 	
@@ -51,6 +51,10 @@ int main(int argc, char** argv) {
 	// load the pipeline with their configuration from the config file
 	myConfig.LoadConfiguration(pInit, runner, factory, rootEnv.GetRootFile());
 
+	// deactivate the input collections that are not read by any of the configured processors
+	evtProvider.DeactivateUnreadCollections(settings, factory.GetReadCollections(), factory.GetUndeclaredProcessorIds());
+	evtProvider.ConfigureTreeCache(settings);
+
 	// run all the configured pipelines and all their attached
 	// consumers
 	runner.RunPipelines(evtProvider, settings);
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <TH2.h>
+#include <TEfficiency.h>
 #include "TROOT.h"
 
 #include "Artus/Core/interface/ConsumerBase.h"
@@ -10,6 +11,15 @@
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 
+/**
+   \brief Acceptance efficiency as function of the pTs of both generator taus.
+
+   The generator weight of each event is its probability to be accepted. The sum of these probabilities
+   (and their squares for the uncertainties) is accumulated in number_of_passed_hist, the number of events
+   in number_of_entries_hist. Weights outside of (0, 1] count as not accepted. The ratio is written as
+   histogram (acc_eff_hist, binomial errors) and as TEfficiency (acc_eff, Bayesian intervals with a
+   Jeffreys prior, based on the effective number of entries).
+*/
 class AcceptanceEfficiencyConsumer : public LambdaNtupleConsumer<HttTypes> {
 public:
 
@@ -24,7 +34,6 @@ public:
 
 private:
 
-	const unsigned int nAttempts = 1000;
 	TH2D* acc_eff_hist;
 	TH2D* number_of_passed_hist;
 	TH2D* number_of_entries_hist;
@@ -9,6 +9,7 @@
 #include "Artus/Utility/interface/RootFileHelper.h"
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/KappaMetadataBinding.h"
 
 class BTagEffConsumer : public ConsumerBase<HttTypes> {
 public:
@@ -29,4 +30,8 @@ private:
 	TH2D* m_BTaggingEff_Num_b;
 	TH2D* m_BTaggingEff_Num_c;
 	TH2D* m_BTaggingEff_Num_udsg;
+
+	JetTagBinding m_jetTagBinding;
+	size_t m_combinedSecondaryVertexHandle;
+	float m_bTaggingWorkingPoint;
 };
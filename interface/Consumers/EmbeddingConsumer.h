@@ -1,15 +1,20 @@
-
 #pragma once
 
 #include <TH1.h>
 #include "TROOT.h"
-#include "TRandom3.h"
 
 #include "Artus/Core/interface/ConsumerBase.h"
 #include "Artus/Utility/interface/RootFileHelper.h"
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
 
+/**
+   \brief Consumer for the PtFlow per DeltaR distributions around the muons used for embedding.
+
+   DeltaR between a muon and a PF candidate is computed only once per pair and the PtFlow is
+   accumulated into plain fixed-bin arrays indexed by (muon type, PF class, region).
+   The contents are transferred into the booked TH1F histograms in Finish.
+*/
 class EmbeddingConsumer : public ConsumerBase<HttTypes> {
 public:
 
@@ -17,15 +22,21 @@ public:
 	typedef typename HttTypes::product_type product_type;
 	typedef typename HttTypes::setting_type setting_type;
 
+	enum MuonType { LEADING = 0, TRAILING = 1, POSITIVE = 2, NEGATIVE = 3, N_MUON_TYPES = 4 };
+	enum PfClass { CHARGED_FROM_FIRST_PV = 0, CHARGED_NOT_FROM_FIRST_PV = 1, NEUTRAL_FROM_FIRST_PV = 2, PHOTONS_FROM_FIRST_PV = 3, N_PF_CLASSES = 4 };
+	enum Region { FULL = 0, PEAK = 1, SIDEBAND = 2, N_REGIONS = 3 };
+
 	virtual std::string GetConsumerId() const override;
 	virtual void Init(setting_type const& settings) override;
 	virtual void ProcessFilteredEvent(event_type const& event, product_type const& product, setting_type const& settings) override;
 	virtual void Finish(setting_type const& settings) override;
 
-	virtual void FillPtFlowHistogram(std::map<std::string, TH1F*> histmap, std::vector<const KPFCandidate*> pf_collection, KMuon* muon, std::string region);
+	// fills the full region and the given mass region (peak or sideband) with one DeltaR evaluation per PF candidate
+	virtual void FillPtFlow(std::vector<const KPFCandidate*> const& pfCollection, RMFLV const& muonP4,
+	                        MuonType muonType, PfClass pfClass, Region massRegion);
 
 private:
-	TRandom3* randomnumbergenerator = new TRandom3(0);
+	uint64_t m_randomStreamId = 0;
 	unsigned int nDeltaRBins = 0;
 	float DeltaRMax = 0.0;
 	unsigned int nIsoPtSumBins = 0;
@@ -35,13 +46,20 @@ private:
 
 	std::vector<TH1F*> histograms;
 
-	std::map<std::string, KMuon*> Muon;
-
 	std::vector<TString> muonTypeVector = {"leading", "trailing", "positive", "negative"};
 	std::vector<TString> regionTypeVector = {"full", "peak", "sideband"};
+	std::vector<TString> pfClassVector = {"ChargedFromFirstPV", "ChargedNotFromFirstPV", "NeutralFromFirstPV", "PhotonsFromFirstPV"};
+
+	// flat storage indexed by GetHistogramIndex, bin contents are indexed additionally by the DeltaR bin
+	std::vector<TH1F*> m_ptFlowHistograms;
+	std::vector<double> m_ptFlowSumOfWeights;
+	std::vector<double> m_ptFlowSumOfSquaredWeights;
+	std::vector<unsigned long> m_ptFlowEntries;
+	// TH1::PutStats layout per histogram: sumw, sumw2, sumwx, sumwx2
+	std::vector<double> m_ptFlowStats;
 
-	std::map<std::string, std::map<std::string, TH1F*>> Muon_ChargedFromFirstPVPtFlow;
-	std::map<std::string, std::map<std::string, TH1F*>> Muon_ChargedNotFromFirstPVPtFlow;
-	std::map<std::string, std::map<std::string, TH1F*>> Muon_NeutralFromFirstPVPtFlow;
-	std::map<std::string, std::map<std::string, TH1F*>> Muon_PhotonsFromFirstPVPtFlow;
+	inline size_t GetHistogramIndex(MuonType muonType, PfClass pfClass, Region region) const
+	{
+		return (static_cast<size_t>(muonType) * N_PF_CLASSES + static_cast<size_t>(pfClass)) * N_REGIONS + static_cast<size_t>(region);
+	}
 };
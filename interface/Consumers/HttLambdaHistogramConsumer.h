@@ -0,0 +1,98 @@
+#pragma once
+
+#include <TH1.h>
+#include <TH2.h>
+
+#include "Artus/Core/interface/ConsumerBase.h"
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+
+
+/**
+   \brief Fills 1D/2D histograms of lambda quantities directly in the job instead of writing ntuples.
+
+   Config tags (all lists of "<histogram name>:<value>" entries):
+   - HistogramConsumerQuantities: one (1D) or two (2D) quantity names per histogram, in axis order
+   - HistogramConsumerBinnings: "nBins,min,max" per axis, in axis order
+   - HistogramConsumerWeights: product of weight names separated by "*" (optional, default: EventWeight)
+   - HistogramConsumerSelections: quantity that has to be non-zero for the event to be filled (optional)
+
+   Quantities are resolved to their extractors in Init. Weight factors can be lambda quantities
+   or entries in the (optional) weights of the product. Weight factors that are no lambda quantities
+   are resolved to either m_weights or m_optionalWeights with the first processed event, the job
+   is stopped if a weight factor cannot be found there. The histogram contents are accumulated
+   in preallocated fixed-bin arrays and converted to TH1D/TH2D objects in Finish.
+*/
+class HttLambdaHistogramConsumer: public ConsumerBase<HttTypes> {
+public:
+
+	typedef typename HttTypes::event_type event_type;
+	typedef typename HttTypes::product_type product_type;
+	typedef typename HttTypes::setting_type setting_type;
+
+	typedef std::function<float(event_type const&, product_type const&)> float_extractor_lambda;
+
+	virtual std::string GetConsumerId() const override
+	{
+		return "HttLambdaHistogramConsumer";
+	}
+
+	virtual void Init(setting_type const& settings) override;
+
+	virtual void ProcessFilteredEvent(event_type const& event, product_type const& product,
+	                                  setting_type const& settings) override;
+
+	virtual void Finish(setting_type const& settings) override;
+
+private:
+	struct Axis
+	{
+		std::string quantity;
+		float_extractor_lambda extractor;
+		int nBins = 1;
+		double min = 0.0;
+		double max = 1.0;
+
+		// ROOT convention: 0 is the underflow and nBins+1 the overflow bin
+		int FindBin(double value) const;
+	};
+
+	struct WeightFactor
+	{
+		enum class Source : int
+		{
+			UNRESOLVED = 0,
+			QUANTITY = 1,
+			WEIGHTS = 2,
+			OPTIONAL_WEIGHTS = 3,
+		};
+
+		std::string name;
+		Source source = Source::UNRESOLVED;
+		float_extractor_lambda extractor;
+	};
+
+	struct Histogram
+	{
+		std::string name;
+		std::vector<Axis> axes;
+		std::vector<WeightFactor> weightFactors;
+		bool weightFactorsResolved = false;
+		bool hasSelection = false;
+		float_extractor_lambda selection;
+
+		// bin contents including under- and overflow bins, the x axis runs fastest
+		std::vector<double> sumOfWeights;
+		std::vector<double> sumOfSquaredWeights;
+		double entries = 0.0;
+		// statistics in the ROOT layout of TH1::GetStats/TH1::PutStats
+		std::vector<double> stats;
+	};
+
+	static float_extractor_lambda GetExtractor(std::string const& quantity);
+	static void ResolveProductWeights(Histogram& histogram, product_type const& product);
+	static double GetWeight(Histogram const& histogram, event_type const& event, product_type const& product);
+
+	std::vector<Histogram> m_histograms;
+};
+
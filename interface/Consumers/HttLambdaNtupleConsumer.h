@@ -14,4 +14,14 @@ public:
 	typedef typename HttTypes::setting_type setting_type;
 	
 	virtual void Init(setting_type const& settings) override;
+	
+	virtual void ProcessFilteredEvent(event_type const& event, product_type const& product,
+	                                  setting_type const& settings) override;
+	
+	virtual void Finish(setting_type const& settings) override;
+
+private:
+	// names of the entries of the lheWeights array, written to the tree "lheWeightNames"
+	bool m_writeLheWeightNames = false;
+	std::vector<std::string> m_lheWeightNames;
 };
@@ -6,6 +6,7 @@
 #include "Artus/Core/interface/ConsumerBase.h"
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/SvfitTools.h"
 
 
 /**
@@ -32,6 +33,8 @@ public:
 
 private:
 	TTree* m_svfitCacheTree = 0;
+	// the branches are bound to these values, the product is copied into them before filling the tree
+	SvfitCacheBranches m_svfitCacheBranches;
 	bool m_svfitCacheTreeInitialised = false;
 	bool m_firstSvfitCacheFile = true;
 	int m_fileIndex = 0;
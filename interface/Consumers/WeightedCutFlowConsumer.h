@@ -0,0 +1,81 @@
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <TH1.h>
+
+#include "Artus/Core/interface/ConsumerBase.h"
+#include "Artus/Utility/interface/RootFileHelper.h"
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+
+/**
+   \brief Consumer for the raw and weighted cut flow of a pipeline in a single pass.
+
+   For each filter of the pipeline, in the order in which they are configured, the number of events
+   entering (passing all previous filters) and passing the filter is counted together with the sums of
+   weights and squared weights. In addition, the first failing filter of each event is recorded.
+   The weight is the product of the weights listed in CutFlowWeights (default: EventWeight), looked up in
+   the product (m_weights or m_optionalWeights) as it is at the end of the pipeline. Events passing all
+   filters carry all weights, events stopped by a filter only the weights produced before it. Missing
+   weights count as 1, a warning is printed once per weight name. Filters in tagging mode are counted
+   as entered and passed or not, but do not stop the event and are never its first failing filter.
+
+   Output histograms in the pipeline folder (one bin per filter):
+   cutFlowEntering, cutFlowPassing, cutFlowFirstFailing (with an additional last bin for events passing
+   all filters) and the corresponding *Weighted histograms.
+
+   The SharedPrefixFilter is replaced by the individual filters run within the SharedPrefixProducer.
+*/
+class WeightedCutFlowConsumer : public ConsumerBase<HttTypes> {
+public:
+
+	typedef typename HttTypes::event_type event_type;
+	typedef typename HttTypes::product_type product_type;
+	typedef typename HttTypes::setting_type setting_type;
+
+	virtual std::string GetConsumerId() const override;
+	virtual void Init(setting_type const& settings) override;
+	virtual void ProcessEvent(event_type const& event, product_type const& product, setting_type const& settings, FilterResult & result) override;
+	virtual void Finish(setting_type const& settings) override;
+
+private:
+	struct CutFlowCounts
+	{
+		unsigned long entries = 0;
+		double sumOfWeights = 0.0;
+		double sumOfSquaredWeights = 0.0;
+
+		inline void Fill(double weight)
+		{
+			++entries;
+			sumOfWeights += weight;
+			sumOfSquaredWeights += weight * weight;
+		}
+	};
+
+	std::string m_sharedPrefixFilterId;
+	std::vector<std::string> m_weightNames;
+	std::set<std::string> m_missingWeightNames;
+
+	std::vector<std::string> m_filterIds;
+	std::unordered_map<std::string, size_t> m_filterIndices;
+	// filter index per position in the filter decisions, resolved at the first occurrence of each position
+	std::vector<size_t> m_decisionFilterIndices;
+
+	std::vector<CutFlowCounts> m_entering;
+	std::vector<CutFlowCounts> m_passing;
+	std::vector<CutFlowCounts> m_firstFailing;
+	CutFlowCounts m_passingAll;
+
+	double GetWeight(event_type const& event, product_type const& product);
+	bool FillDecision(size_t decisionIndex, std::string const& filterId, bool passed, bool stopping, double weight);
+	size_t GetFilterIndex(std::string const& filterId);
+	void WriteHistogram(std::string const& name, std::vector<CutFlowCounts> const& counts,
+	                    std::vector<std::string> const& labels, bool weighted) const;
+};
+
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Artus/Core/interface/FilterBase.h"
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+
+
+/** Filter for the result of the filters run within the SharedPrefixProducer.
+ *  Has to be placed directly after the SharedPrefixProducer.
+ *  The individual decisions of these filters are kept in product.m_sharedPrefixFilterDecisions.
+ */
+class SharedPrefixFilter: public FilterBase<HttTypes> {
+public:
+
+	typedef typename HttTypes::event_type event_type;
+	typedef typename HttTypes::product_type product_type;
+	typedef typename HttTypes::setting_type setting_type;
+
+	virtual std::string GetFilterId() const override {
+		return "SharedPrefixFilter";
+	}
+
+	virtual bool DoesEventPass(event_type const& event, product_type const& product,
+	                           setting_type const& settings) const override
+	{
+		// the prefix stops at the first failing filter
+		return (product.m_sharedPrefixFilterDecisions.empty() || product.m_sharedPrefixFilterDecisions.back().second);
+	}
+};
+
@@ -1,8 +1,13 @@
 
 #pragma once
 
+#include <set>
+#include <string>
+
 #include "Artus/KappaAnalysis/interface/KappaEvent.h"
 
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEventInputs.h"
+
 /**
    HttEvent HiggsAnalysis/KITHiggsToTauTau/interface/HttEvent.h
 
@@ -31,5 +36,21 @@ public:
 	KMETs* m_mvaMetsEM = 0;
 	KMETs* m_mvaMets = 0;
 	
+	/// optional input collections deactivated by the HttEventProvider, see HttEventInputs
+	std::set<std::string> m_deactivatedCollections;
+	
+	/// checked access to an optional input collection, fails if the collection has been deactivated
+	/// and returns nullptr if it is not available otherwise
+	template<class TCollection, class TEvent>
+	TCollection* GetOptionalCollection(TCollection* TEvent::*member, std::string const& collection) const
+	{
+		TCollection* pointer = this->*member;
+		if (pointer == nullptr)
+		{
+			HttEventInputs::AssertActive(m_deactivatedCollections, collection);
+		}
+		return pointer;
+	}
+	
 };
 
@@ -0,0 +1,44 @@
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+   \brief Declaration of the optional input collections read by the producers, filters and consumers.
+
+   Collections are identified by the name of the setting holding their branch name (e.g. "PackedPFCandidates").
+   Processors are identified by their type and ID (e.g. "producer:MvaMetSelector").
+
+   Processors of this package reading optional collections implement HttEventInputs::Reader, the HttFactory
+   collects the declared collections when creating them. All other processors of this package read none of them
+   and access to the optional collections goes through HttEvent::GetOptionalCollection, which fails for
+   collections that have been deactivated. Processors of other packages used in the standard configurations
+   are declared in HttEventInputs.cc. Processors of other packages without declaration are assumed to read all
+   optional collections, such that no collection is deactivated for them.
+*/
+
+class HttEventInputs
+{
+public:
+	/// interface for the processors of this package reading optional collections
+	class Reader
+	{
+	public:
+		virtual ~Reader() {}
+		virtual std::vector<std::string> GetOptionalInputs() const = 0;
+	};
+
+	/// collections that are deactivated by the HttEventProvider if no configured processor reads them
+	static std::vector<std::string> const& GetOptionalCollections();
+
+	/// collections read by a processor of another package, nullptr for processors that are not declared
+	static std::vector<std::string> const* GetExternalProcessorCollections(std::string const& processorId);
+
+	/// fails if the collection has been deactivated, called by HttEvent::GetOptionalCollection for pointers not set
+	static void AssertActive(std::set<std::string> const& deactivatedCollections, std::string const& collection);
+
+private:
+	HttEventInputs() {};
+};
@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include <set>
+#include <string>
+
 #include "Artus/KappaAnalysis/interface/KappaEventProvider.h"
 
 #include "HttTypes.h"
@@ -18,5 +21,20 @@ public:
 	HttEventProvider(FileInterface2 & fileInterface, InputTypeEnum inpType, bool batchMode=false);
 
 	virtual void WireEvent(setting_type const& settings) override;
+
+	/// deactivate the branches of the optional collections that are not in readCollections (see HttEventInputs),
+	/// nothing is deactivated for undeclared processors of other packages.
+	/// Needs to be called after the pipelines have been configured
+	void DeactivateUnreadCollections(setting_type const& settings,
+	                                 std::set<std::string> const& readCollections,
+	                                 std::set<std::string> const& undeclaredProcessorIds);
+
+	/// configure the TTreeCache and the parallel decompression of its baskets for the input files,
+	/// to be called after DeactivateUnreadCollections such that only active branches are cached.
+	/// The entries are still read one after the other into the single event of the provider.
+	void ConfigureTreeCache(setting_type const& settings);
+
+private:
+	FileInterface2& m_inputFileInterface;
 };
 
@@ -1,9 +1,15 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
 #include "Artus/KappaAnalysis/interface/KappaFactory.h"
 
 #include "HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/SharedPrefixProducer.h"
 
 
 class HttFactory: public KappaFactory {
@@ -16,4 +22,31 @@ public:
 	virtual FilterBaseUntemplated * createFilter(std::string const& id) override;
 	virtual ConsumerBaseUntemplated * createConsumer(std::string const& id) override;
 
+	/// optional input collections read by the created processors (see HttEventInputs),
+	/// including the processors created for shared prefixes
+	std::set<std::string> const& GetReadCollections() const { return m_readCollections; }
+	/// IDs of created processors of other packages without known optional inputs ("producer:...", "filter:...", "consumer:...")
+	std::set<std::string> const& GetUndeclaredProcessorIds() const { return m_undeclaredProcessorIds; }
+	/// created processor of another package ("producer:...", "filter:...", "consumer:...")
+	bool IsExternalProcessor(std::string const& processorId) const { return (m_externalProcessorIds.count(processorId) > 0); }
+
+	/// processors shared between pipelines (see SharedPrefixProducer) by the pipeline settings they depend on,
+	/// owned by the factory for the whole job
+	std::map<std::string, std::shared_ptr<SharedPrefixProducer::SharedProcessor> >& GetSharedPrefixes() { return m_sharedPrefixes; }
+
+private:
+	// processors of this package, nullptr for unknown IDs
+	ProducerBaseUntemplated * createHttProducer(std::string const& id);
+	FilterBaseUntemplated * createHttFilter(std::string const& id);
+	ConsumerBaseUntemplated * createHttConsumer(std::string const& id);
+
+	template<class TProcessor>
+	TProcessor* DeclareInputs(TProcessor* processor);
+	void DeclareExternalInputs(std::string const& processorId);
+
+	std::set<std::string> m_readCollections;
+	std::set<std::string> m_undeclaredProcessorIds;
+	std::set<std::string> m_externalProcessorIds;
+	std::map<std::string, std::shared_ptr<SharedPrefixProducer::SharedProcessor> > m_sharedPrefixes;
+
 };
@@ -11,6 +11,7 @@
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/SvfitTools.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/DiTauPair.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/DiGenTauPair.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/LeptonPairDescriptor.h"
 #include "TVector2.h"
 #include "TVector3.h"
 
@@ -63,6 +64,7 @@ public:
 	float m_systematicShiftSigma = 0.0;
 
 	// filled by DecayChannelProducer
+	LeptonPairDescriptor m_leptonPair; // the ordered collections below are derived from it
 	std::vector<KLepton*> m_ptOrderedLeptons; // highest pt leptons first
 	std::vector<KLepton*> m_flavourOrderedLeptons; // according to channel definition
 	std::vector<KLepton*> m_chargeOrderedLeptons; // positively charged leptons first
@@ -149,9 +151,9 @@ public:
 	double pZetaMissVis = 0.0;
 
 	// filled by the SvfitProducer
-	mutable SvfitEventKey m_svfitEventKey;
-	mutable SvfitInputs m_svfitInputs;
-	mutable SvfitResults m_svfitResults;
+	SvfitEventKey m_svfitEventKey;
+	SvfitInputs m_svfitInputs;
+	SvfitResults m_svfitResults;
 	bool m_svfitCalculated = false;
 
 	// filled by the HHKinFitProducer
@@ -185,6 +187,9 @@ public:
 	KMET m_met;
 	KMET m_pfmet;
 	KMET m_mvamet;
+	// recoil response/resolution up/down variants of m_met (MetSysAllVariants), index: [MEtSys::SysType][MEtSys::SysShift]
+	// only the MET itself is varied, quantities calculated from m_met (e.g. mT, SVfit) use the nominal MET
+	RMFLV m_metSysVariants[2][2];
 
 	// filled by the TauTauRestFrameProducer
 	HttEnumTypes::TauTauRestFrameReco m_tauTauRestFrameReco = HttEnumTypes::TauTauRestFrameReco::NONE;
@@ -399,4 +404,11 @@ public:
 	
 	//filled by MetFilterFlagProducer
 	bool m_MetFilter = true;
+
+	// filled by SharedPrefixProducer: IDs and decisions of the filters run within the shared prefix
+	std::vector<std::pair<std::string, bool> > m_sharedPrefixFilterDecisions;
+
+	// filled by ScaleVariationProducer, pointing to its per-lumi names of the LHE weights
+	// (one name per entry of event.m_genEventInfo->lheWeight)
+	std::vector<std::string> const* m_lheWeightNames = nullptr;
 };
@@ -28,6 +28,15 @@ public:
 	IMPL_SETTING_DEFAULT(std::string, MvaMetsEM, "");
 	IMPL_SETTING_DEFAULT(std::string, MvaMets, "");
 
+	/// deactivate the branches of optional input collections that are not read by any configured processor (see HttEventInputs)
+	IMPL_SETTING_DEFAULT(bool, DeactivateUnreadInputCollections, false);
+
+	/// TTreeCache of the input files: size in MB (0: ROOT default), number of entries to learn the branches
+	/// to be cached from (0: ROOT default) and parallel decompression of the cached baskets (requires ROOT's implicit MT)
+	IMPL_SETTING_DEFAULT(int, InputTreeCacheSize, 0);
+	IMPL_SETTING_DEFAULT(int, InputTreeCacheLearnEntries, 0);
+	IMPL_SETTING_DEFAULT(bool, InputParallelUnzip, false);
+
 	/// htt decay channel and event category
 	IMPL_SETTING_DEFAULT(std::string, Channel, "");
 	IMPL_SETTING_DEFAULT(std::string, Category, "");
@@ -44,6 +53,7 @@ public:
 	IMPL_SETTING_DEFAULT(bool, UpdateMetWithCorrectedLeptons, false);
 	IMPL_SETTING_DEFAULT(int, MetSysType, 0);
 	IMPL_SETTING_DEFAULT(int, MetSysShift, 0);
+	IMPL_SETTING_DEFAULT(bool, MetSysAllVariants, false);
 
 	IMPL_SETTING_DEFAULT(bool, MetUncertaintyShift, false);
 	IMPL_SETTING_DEFAULT(std::string, MetUncertaintyType, "");
@@ -265,6 +275,7 @@ public:
 	IMPL_SETTING_DEFAULT(bool, GenerateSvfitInput, false);
 	IMPL_SETTING_DEFAULT(int, SvfitInputCutOff, 5000)
 	IMPL_SETTING_DEFAULT(bool, UpdateSvfitCache, false)
+	IMPL_SETTING_DEFAULT(int, SvfitInJobCacheSize, 100);
 
 	IMPL_SETTING(std::string, TauTauRestFrameReco);
 
@@ -360,6 +371,22 @@ public:
 	IMPL_SETTING_DEFAULT(float, IsoPtSumOverPtMaximum, 0.4);
 	IMPL_SETTING_DEFAULT(bool, RandomMuon, false);
 
+	// settings for the WeightedCutFlowConsumer, product of the listed weights (default: EventWeight),
+	// weights not produced for events stopped by an earlier filter count as 1
+	IMPL_SETTING_STRINGLIST_DEFAULT(CutFlowWeights, {});
+
+	// directory for binary snapshots of correction inputs (CorrectionSnapshot), disabled if empty
+	IMPL_SETTING_DEFAULT(std::string, CorrectionSnapshotDirectory, "");
+
+	// settings for the SharedPrefixProducer
+	IMPL_SETTING_STRINGLIST_DEFAULT(SharedPrefixProcessors, {});
+
+	// settings for the HttLambdaHistogramConsumer
+	IMPL_SETTING_STRINGLIST_DEFAULT(HistogramConsumerQuantities, {});
+	IMPL_SETTING_STRINGLIST_DEFAULT(HistogramConsumerBinnings, {});
+	IMPL_SETTING_STRINGLIST_DEFAULT(HistogramConsumerWeights, {});
+	IMPL_SETTING_STRINGLIST_DEFAULT(HistogramConsumerSelections, {});
+
 	// setting for mass smearing applied in DiLeptonQuantitiesProducer
 	IMPL_SETTING_DEFAULT(float, MassSmearing, 0.10);
 
@@ -371,6 +398,7 @@ public:
 
 	// settings for the ScaleVariationProducer
 	IMPL_SETTING_STRINGLIST_DEFAULT(GenEventInfoMetadataNames, {});
+	IMPL_SETTING_DEFAULT(bool, LheWeightsAsArray, false);
 
 	// settings for SimpleMuTauFakeRateWeightProducer
 	IMPL_SETTING_FLOATLIST(SimpleMuTauFakeRateWeightLoose);
@@ -380,6 +408,9 @@ public:
 	IMPL_SETTING_FLOATLIST(SimpleEleTauFakeRateWeightVLoose);
 	IMPL_SETTING_FLOATLIST(SimpleEleTauFakeRateWeightTight);
 
+	// settings for LeptonTauFakeRateWeightProducer
+	IMPL_SETTING_STRINGLIST_DEFAULT(LeptonTauFakeRateWeightTables, {});
+
 	// settings for MetFilter
 	IMPL_SETTING_STRINGLIST_DEFAULT(MetFilter, {});
         IMPL_SETTING_STRINGLIST_DEFAULT(MetFilterToFlag, {});
@@ -408,6 +439,10 @@ public:
         
         // settings for quantile mapping
         IMPL_SETTING_DEFAULT(std::string, QuantileMappingRootfile, "none")
+        IMPL_SETTING_DEFAULT(bool, UseQuantileMappingTables, true)
+        IMPL_SETTING_DEFAULT(int, QuantileMappingTableInitialPoints, 1024)
+        IMPL_SETTING_DEFAULT(int, QuantileMappingTableMaxPoints, 65536)
+        IMPL_SETTING_DEFAULT(float, QuantileMappingTableTolerance, 1e-5)
         IMPL_SETTING_DEFAULT(std::string, Prompt_e_d0_source, "none")
         IMPL_SETTING_DEFAULT(std::string, Prompt_e_dZ_source, "none")
         IMPL_SETTING_DEFAULT(std::string, Prompt_m_d0_source, "none")
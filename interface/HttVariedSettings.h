@@ -0,0 +1,37 @@
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+   \brief Declaration of the settings that are varied between the pipelines of one channel (e.g. systematic shifts).
+
+   Settings are identified by their name in the pipeline configuration (e.g. "TauEnergyCorrectionShift").
+   Processors are identified by their type and ID (e.g. "producer:JetCorrectionsProducer").
+
+   Processors of this package reading varied settings implement HttVariedSettings::Reader, all other processors
+   of this package do not read any of them. Processors of other packages are declared in HttVariedSettings.cc.
+   The SharedPrefixProducer shares processors between pipelines only where all settings that are not declared
+   by the shared processors are identical, a setting declared by one processor therefore has to be declared
+   by all processors reading it. Processors of other packages without declaration are never shared.
+*/
+
+class HttVariedSettings
+{
+public:
+	/// interface for the processors of this package reading varied settings
+	class Reader
+	{
+	public:
+		virtual ~Reader() {}
+		virtual std::vector<std::string> GetVariedSettings() const = 0;
+	};
+
+	/// varied settings read by a processor of another package, nullptr for processors that are not declared
+	static std::vector<std::string> const* GetExternalProcessorSettings(std::string const& processorId);
+
+private:
+	HttVariedSettings() {};
+};
+
@@ -1,8 +1,11 @@
 
 #pragma once
 
+#include <memory>
+
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEnumTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/CorrectionSnapshot.h"
 
 
 /** Abstract producer for scale factors effData/effMC
@@ -33,18 +36,20 @@ private:
 	std::string (setting_type::*GetEfficiencyMode)(void) const;
 	std::string m_weightName;
 	
-	std::map<std::string, std::vector<TH2F*> > efficienciesDataByHltName;
-	std::map<size_t, std::vector<TH2F*> > efficienciesDataByIndex;
-	std::map<std::string, std::vector<TH2F*> > efficienciesMcByHltName;
-	std::map<size_t, std::vector<TH2F*> > efficienciesMcByIndex;
+	// the lookups read from the mapped snapshot if it is loaded
+	std::unique_ptr<CorrectionSnapshot> m_snapshot;
+	std::map<std::string, std::vector<CorrectionSnapshot::BinnedLookup> > efficienciesDataByHltName;
+	std::map<size_t, std::vector<CorrectionSnapshot::BinnedLookup> > efficienciesDataByIndex;
+	std::map<std::string, std::vector<CorrectionSnapshot::BinnedLookup> > efficienciesMcByHltName;
+	std::map<size_t, std::vector<CorrectionSnapshot::BinnedLookup> > efficienciesMcByIndex;
 	
 	HttEnumTypes::DataMcScaleFactorProducerMode m_scaleFactorMode = HttEnumTypes::DataMcScaleFactorProducerMode::NONE;
 	
-	std::vector<double> GetEfficienciesFromHistograms(std::vector<TH2F*> const& histograms, KLepton* lepton) const;
+	std::vector<double> GetEfficienciesFromHistograms(std::vector<CorrectionSnapshot::BinnedLookup> const& histograms, KLepton* lepton) const;
 	
 	std::vector<std::vector<double> > GetEfficiencies(
-			std::map<std::string, std::vector<TH2F*> > const& efficienciesByHltName,
-			std::map<size_t, std::vector<TH2F*> > const& efficienciesByIndex,
+			std::map<std::string, std::vector<CorrectionSnapshot::BinnedLookup> > const& efficienciesByHltName,
+			std::map<size_t, std::vector<CorrectionSnapshot::BinnedLookup> > const& efficienciesByIndex,
 			event_type const& event, product_type const& product,
 			setting_type const& settings
 	) const;
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/ObjectOverlapIndex.h"
 
 
 /** Producer that defines the decay channel.
@@ -25,7 +26,8 @@ public:
 protected:
 	HttEnumTypes::DecayChannel m_decayChannel;
 	
-	void FillGenLeptonCollections(product_type& product) const;
+	// fills the ordered (gen) lepton collections from the legs and orderings in product.m_leptonPair
+	void FillLeptonCollections(product_type& product) const;
 };
 
 
@@ -57,5 +59,10 @@ public:
 
 	virtual void Produce(event_type const& event, product_type& product,
 	                     setting_type const& settings) const override;
+
+private:
+	// signal electrons/muons for the cleaning of the loose ones, refilled in every event
+	mutable ObjectOverlapIndex m_signalElectronIndex;
+	mutable ObjectOverlapIndex m_signalMuonIndex;
 };
 
@@ -2,6 +2,7 @@
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEnumTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEventInputs.h"
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 
 /**
@@ -11,7 +12,7 @@
    - ZProducer
 */
 
-class EmbeddingGlobalQuantitiesProducer : public ProducerBase<HttTypes> {
+class EmbeddingGlobalQuantitiesProducer : public ProducerBase<HttTypes>, public HttEventInputs::Reader {
 public:
 
 	typedef typename HttTypes::event_type event_type;
@@ -21,6 +22,10 @@ public:
 	virtual std::string GetProducerId() const override {
 		return "EmbeddingGlobalQuantitiesProducer";
 	}
+
+	virtual std::vector<std::string> GetOptionalInputs() const override {
+		return { "PackedPFCandidates" };
+	}
 	
 	virtual void Init(setting_type const& settings) override;
 	virtual void Produce(event_type const& event, product_type& product,
@@ -4,6 +4,7 @@
 #include "Artus/KappaAnalysis/interface/Producers/ElectronCorrectionsProducer.h"
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttVariedSettings.h"
 
 
 /**
@@ -12,7 +13,7 @@
    Required config tags
    - ElectronEnergyCorrection (possible value: fall2015)
 */
-class HttElectronCorrectionsProducer: public ElectronCorrectionsProducer
+class HttElectronCorrectionsProducer: public ElectronCorrectionsProducer, public HttVariedSettings::Reader
 {
 
 public:
@@ -37,6 +38,8 @@ public:
 	
 	virtual void Init(setting_type const& settings) override;
 
+	virtual std::vector<std::string> GetVariedSettings() const override;
+
 
 protected:
 
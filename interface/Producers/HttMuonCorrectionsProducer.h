@@ -4,6 +4,7 @@
 #include "Artus/KappaAnalysis/interface/Producers/MuonCorrectionsProducer.h"
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttVariedSettings.h"
 
 
 /**
@@ -13,7 +14,7 @@
    - MuonEnergyCorrection (possible value: fall2015)
 */
 
-class HttMuonCorrectionsProducer: public MuonCorrectionsProducer
+class HttMuonCorrectionsProducer: public MuonCorrectionsProducer, public HttVariedSettings::Reader
 {
 
 public:
@@ -25,6 +26,13 @@ public:
 	typedef typename HttTypes::product_type spec_product_type;
 	typedef typename HttTypes::setting_type spec_setting_type;
 
+	virtual void Init(setting_type const& settings) override;
+
+	virtual std::vector<std::string> GetVariedSettings() const override;
+
+	/// corrections of the base producer followed by the random smearing (RandomMuonEnergySmearing)
+	virtual void Produce(event_type const& event, product_type& product,
+	                     setting_type const& settings) const override;
 
 protected:
 
@@ -32,6 +40,8 @@ protected:
 	virtual void AdditionalCorrections(KMuon* muon, event_type const& event, 
 				product_type& product, setting_type const& settings) const override;
 
+private:
+	uint64_t m_randomStreamId = 0;
 
 };
 
@@ -1,18 +1,27 @@
 
 #pragma once
 
+#include <array>
+
+#include "Artus/KappaAnalysis/interface/KappaEnumTypes.h"
 #include "Artus/KappaAnalysis/interface/Producers/TauCorrectionsProducer.h"
 
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEnumTypes.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttVariedSettings.h"
 
 
 /**
    \brief Producer for tau energy scale corrections (Htt version).
    
    Required config tags
-   - TauEnergyCorrection (possible value: summer2013)
+   - TauEnergyCorrection (possible values: summer2013, newtauid, smhtt2016, mssmhtt2016)
+
+   The nominal corrections and the energy scale shifts configured in the settings are combined
+   into one table indexed by (gen-match class, decay mode bin) at Init, such that only the
+   pt dependent jet->tau fake shift and the random smearing are evaluated per tau.
 */
-class HttTauCorrectionsProducer: public TauCorrectionsProducer
+class HttTauCorrectionsProducer: public TauCorrectionsProducer, public HttVariedSettings::Reader
 {
 
 public:
@@ -41,8 +50,47 @@ public:
 		else return TauEnergyCorrection::NONE;
 	}
 	
+	// gen-match classes distinguished by the corrections
+	enum class TauGenMatchClass : int
+	{
+		TAU_HAD_DECAY = 0,
+		MUON = 1, // prompt or from tau decays
+		ELECTRON_PROMPT = 2,
+		ELECTRON_FROM_TAU = 3,
+		FAKE = 4,
+		OTHER = 5,
+		N_CLASSES = 6
+	};
+	static TauGenMatchClass ToTauGenMatchClass(KappaEnumTypes::GenMatchingCode genMatchingCode);
+
+	// decay modes distinguished by the corrections: 0, 1, 2, 10 and all others
+	enum class TauDecayModeBin : int
+	{
+		ONE_PRONG = 0,
+		ONE_PRONG_ONE_PI_ZERO = 1,
+		ONE_PRONG_TWO_PI_ZEROS = 2,
+		THREE_PRONG = 3,
+		OTHER = 4,
+		N_BINS = 5
+	};
+	static TauDecayModeBin ToTauDecayModeBin(int decayMode);
+
+	struct TauEnergyScaleCorrection
+	{
+		double scale = 1.0;
+		double normalisationFactor = 1.0;
+		// systematic shift to be stored in the product for the (cached) Svfit calculation
+		HttEnumTypes::SystematicShift systematicShift = HttEnumTypes::SystematicShift::NONE;
+		float systematicShiftSigma = 0.0;
+	};
+
 	virtual void Init(setting_type const& settings) override;
 
+	virtual std::vector<std::string> GetVariedSettings() const override;
+
+	/// corrections of the base producer followed by the random smearing (RandomTauEnergySmearing)
+	virtual void Produce(event_type const& event, product_type& product,
+	                     setting_type const& settings) const override;
 
 protected:
 
@@ -53,6 +101,18 @@ protected:
 
 private:
 	TauEnergyCorrection tauEnergyCorrection;
+	uint64_t m_randomStreamId = 0;
+
+	std::array<TauEnergyScaleCorrection, static_cast<size_t>(TauGenMatchClass::N_CLASSES) * static_cast<size_t>(TauDecayModeBin::N_BINS)> m_correctionTable;
+	float m_tauJetFakeEnergyCorrectionShift = 0.0;
+	float m_randomTauEnergySmearing = 0.0;
+
+	void BuildCorrectionTable(HttSettings const& settings);
+
+	inline static size_t GetCorrectionIndex(TauGenMatchClass genMatchClass, TauDecayModeBin decayModeBin)
+	{
+		return static_cast<size_t>(genMatchClass) * static_cast<size_t>(TauDecayModeBin::N_BINS) + static_cast<size_t>(decayModeBin);
+	}
 
 };
 
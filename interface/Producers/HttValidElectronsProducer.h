@@ -4,6 +4,7 @@
 #include "Artus/KappaAnalysis/interface/Producers/ValidElectronsProducer.h"
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/KappaMetadataBinding.h"
 
 
 /**
@@ -163,20 +164,26 @@ private:
 	std::string electronIDName;
 	std::vector<std::string> electronIDList;
 
+	ElectronIdBinding electronIdBinding;
+	size_t electronIDNameHandle;
+	std::vector<size_t> electronIDListHandles;
+	size_t mvaTrigV0Handle;
+	size_t mvaNonTrigV0Handle;
+
 	float electronMvaIDCutEB1;
 	float electronMvaIDCutEB2;
 	float electronMvaIDCutEE;
 
 	bool IsMVATrigElectronTTHSummer2013(KElectron* electron, event_type const& event, bool tightID) const;
 	bool IsMVANonTrigElectronHttSummer2013(KElectron* electron, event_type const& event, bool tightID) const;
-	bool IsCutBased(KElectron* electron, event_type const& event, const std::string &idName) const;
+	bool IsCutBased(KElectron* electron, event_type const& event, size_t idHandle) const;
 	// This function uses the same criteria as the one above with the exception of
 	// isolation (and impact parameters for 2015 Id). Cut values are taken from
 	// https://twiki.cern.ch/twiki/bin/view/CMS/CutBasedElectronIdentificationRun2
 	bool IsCutBased(KElectron* electron, event_type const& event,
 			float full5x5_sigmaIetaIeta, float dEtaIn_Seed, float dPhiIn,
 			float hOverE, float invEMinusInvP, int missingHits, int year=2015) const;
-	bool IsMVABased(KElectron* electron, event_type const& event, const std::string &idName) const;
+	bool IsMVABased(KElectron* electron, event_type const& event, size_t idHandle) const;
 	bool CheckElectronMetadata(const KElectronMetadata *meta, std::string idName, bool &checkedAlready) const;
 	bool CheckElectronMetadata(const KElectronMetadata *meta, std::vector<std::string> idNames, bool &checkedAlready) const;
 };
@@ -4,6 +4,7 @@
 #include "Artus/KappaAnalysis/interface/Producers/ValidJetsProducer.h"
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/ObjectOverlapIndex.h"
 
 
 /**
@@ -52,8 +53,15 @@ public:
 
 protected:
 
+	// fills the index of the ttH taus used for the overlap removal
+	virtual void Produce(event_type const& event, product_type& product,
+	                     setting_type const& settings) const override;
+
 	// Htautau specific additional definitions
 	virtual bool AdditionalCriteria(KJet* jet, event_type const& event,
 	                                product_type& product, setting_type const& settings) const  override;
 
+private:
+	mutable ObjectOverlapIndex m_validTTHTauIndex;
+
 };
@@ -4,6 +4,8 @@
 #include "Artus/KappaAnalysis/interface/Producers/ValidTausProducer.h"
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/KappaMetadataBinding.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/ObjectOverlapIndex.h"
 
 /**
    \brief GlobalProducer, for valid taus.
@@ -23,6 +25,12 @@ protected:
 		
 		HttSettings const& specSettings = static_cast<HttSettings const&>(settings);
 		MvaIsolationCutsByIndex = Utility::ParseMapTypes<size_t, float>(Utility::ParseVectorToMap(specSettings.GetTauDiscriminatorMvaIsolation()), MvaIsolationCutsByName);
+		
+		// the positions of the discriminators in the metadata are resolved once per lumi section
+		isolationDiscriminatorHandle = tauDiscriminatorBinding.Register(specSettings.GetTauDiscriminatorIsolationName());
+		mvaIsolationDiscriminatorHandle = tauDiscriminatorBinding.Register("hpsPFTauDiscriminationByIsolationMVA2raw");
+		antiElectronMvaCategoryHandle = tauDiscriminatorBinding.Register("hpsPFTauDiscriminationByMVA3rawElectronRejectioncategory");
+		antiElectronMvaDiscriminatorHandle = tauDiscriminatorBinding.Register("hpsPFTauDiscriminationByMVA3rawElectronRejection");
 
 		// add possible quantities for the lambda ntuples consumers
 		LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("leadingTauIso", [this](HttTypes::event_type const& event, HttTypes::product_type const& product) {
@@ -39,6 +47,10 @@ protected:
 		});
 	}
 	
+	// fills the indices of valid electrons and muons used for the overlap removal
+	virtual void Produce(KappaEvent const& event, KappaProduct& product,
+	                     KappaSettings const& settings) const override;
+
 	// Htautau specific additional definitions
 	virtual bool AdditionalCriteria(KTau* tau, KappaEvent const& event,
 	                                KappaProduct& product, KappaSettings const& settings) const  override;
@@ -53,5 +65,14 @@ private:
 	std::map<size_t, std::vector<float> > MvaIsolationCutsByIndex;
 	std::map<std::string, std::vector<float> > MvaIsolationCutsByName;
 
+	TauDiscriminatorBinding tauDiscriminatorBinding;
+	size_t isolationDiscriminatorHandle;
+	size_t mvaIsolationDiscriminatorHandle;
+	size_t antiElectronMvaCategoryHandle;
+	size_t antiElectronMvaDiscriminatorHandle;
+
+	mutable ObjectOverlapIndex validElectronIndex;
+	mutable ObjectOverlapIndex validMuonIndex;
+
 };
 
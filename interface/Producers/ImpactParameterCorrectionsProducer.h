@@ -3,6 +3,7 @@
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
 #include "quantile_mapping/quantile_mapping/interface/QuantileShifter.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/TabulatedQuantileShifter.h"
 
 class ImpactParameterCorrectionsProducer: public ProducerBase<HttTypes> {
 public:
@@ -26,7 +27,11 @@ private:
 	enum DCA_reference{abs, rel};
 	enum QS_input{source, target};
 	
+	// x range covered by the source distribution of a quantile mapping
+	static bool GetSourceRange(std::string const& rootfile, std::string const& source, double& xMin, double& xMax);
+
 	QuantileShifter shifter[2][2][6];
+	TabulatedQuantileShifter tabulatedShifter[2][2][6];
 	bool shift[2][2][6];
 };
 
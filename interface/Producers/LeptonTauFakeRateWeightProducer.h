@@ -0,0 +1,91 @@
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+
+/**
+   \brief Weights for electrons and muons faking hadronic taus from binned tables.
+
+   Each table applies to one leg (1 or 2) of one channel and to the reconstructed taus matched to
+   prompt electrons/electrons from tau decays ("ele") or to prompt muons/muons from tau decays ("muon").
+   Tables are binned in any combination of |eta|, pT and decay mode of the reconstructed tau. The weight
+   of a table is 1 outside of its binning. Several tables can contribute to the same weight, their values
+   are multiplied. All weights (e.g. nominal and variations) are computed in one pass with a single
+   gen matching per leg. Weights without matching table are set to 1.
+
+   Config tags:
+   - LeptonTauFakeRateWeightTables: list of tables, each in the format
+     "<weight name>:<channel>:<leg>:<ele|muon>:<binning>:<values>", e.g.
+     "muTauFakeRateWeight:mt:2:muon:absEta=0,0.4,0.8,1.2,1.7,2.3:1.263,1.364,0.854,1.712,2.324"
+     <binning> is a ";"-separated list of "<absEta|pt>=<bin edges>" or "decayMode=<decay modes>",
+     the values are given in row-major order (last binning running fastest).
+
+   The compiled tables are read with flat arrays per event. The SimpleEleTauFakeRateWeightProducer and
+   the SimpleMuTauFakeRateWeightProducer build their tables from their own settings.
+*/
+
+class LeptonTauFakeRateWeightProducer : public ProducerBase<HttTypes> {
+public:
+
+	typedef typename HttTypes::event_type event_type;
+	typedef typename HttTypes::product_type product_type;
+	typedef typename HttTypes::setting_type setting_type;
+
+	enum class GenMatchClass : int
+	{
+		ELECTRON = 0,
+		MUON     = 1
+	};
+
+	enum class BinningVariable : int
+	{
+		ABS_ETA    = 0,
+		PT         = 1,
+		DECAY_MODE = 2
+	};
+
+	struct Binning
+	{
+		BinningVariable variable;
+		// bin edges or, for DECAY_MODE, the decay modes of the bins
+		std::vector<float> edges;
+
+		size_t GetNBins() const;
+		// -1 outside of the binning
+		int FindBin(float value) const;
+	};
+
+	virtual std::string GetProducerId() const override;
+
+	virtual void Init(setting_type const& settings) override;
+
+	virtual void Produce(event_type const& event, product_type& product,
+	                     setting_type const& settings) const override;
+
+protected:
+	/// fills the tables, the default implementation parses LeptonTauFakeRateWeightTables
+	virtual void AddTables(setting_type const& settings);
+
+	/// tables for other channels than the one of the pipeline are ignored, leg is 1 or 2
+	void AddTable(std::string const& weightName, HttEnumTypes::DecayChannel decayChannel, size_t leg,
+	              GenMatchClass genMatchClass, std::vector<Binning> const& binnings, std::vector<float> const& values);
+
+private:
+	struct FakeRateTable
+	{
+		size_t weightIndex;
+		GenMatchClass genMatchClass;
+		std::vector<Binning> binnings;
+		std::vector<float> values;
+	};
+
+	HttEnumTypes::DecayChannel m_decayChannel;
+	std::vector<std::string> m_weightNames;
+	std::vector<FakeRateTable> m_tablesByLeg[2];
+
+	void ParseTable(std::string const& table);
+};
+
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../HttTypes.h"
+#include "../Utility/KappaMetadataBinding.h"
 
 
 class MVAInputQuantitiesProducer: public ProducerBase<HttTypes> {
@@ -18,4 +19,8 @@ public:
 
     virtual void Produce(event_type const& event, product_type& product,
                          setting_type const& settings) const override;
+
+private:
+    JetTagBinding m_jetTagBinding;
+    size_t m_combinedSecondaryVertexHandle;
 };
\ No newline at end of file
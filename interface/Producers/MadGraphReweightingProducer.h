@@ -2,11 +2,12 @@
 #pragma once
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEnumTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEventInputs.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/MadGraphTools.h"
 #include "TDatabasePDG.h"
 
-class MadGraphReweightingProducer: public ProducerBase<HttTypes>
+class MadGraphReweightingProducer: public ProducerBase<HttTypes>, public HttEventInputs::Reader
 {
 public:
 
@@ -15,6 +16,7 @@ public:
 	typedef typename HttTypes::setting_type setting_type;
 	
 	virtual std::string GetProducerId() const override;
+	virtual std::vector<std::string> GetOptionalInputs() const override;
 
 	virtual void Init(setting_type const& settings) override;
 
@@ -4,9 +4,11 @@
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "Artus/Core/interface/ProducerBase.h"
+#include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/Utility.h"
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttVariedSettings.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/RecoilCorrector.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/MEtSys.h"
 
@@ -22,7 +24,7 @@
 
 
 template<class TMet>
-class MetCorrectorBase: public ProducerBase<HttTypes>
+class MetCorrectorBase: public ProducerBase<HttTypes>, public HttVariedSettings::Reader
 {
 public:
 
@@ -48,16 +50,27 @@ public:
 	{
 	}
 
+	virtual std::vector<std::string> GetVariedSettings() const override
+	{
+		return { "MetUncertaintyShift", "MetUncertaintyType" };
+	}
+
 	virtual void Init(setting_type const& settings) override
 	{
 		ProducerBase<HttTypes>::Init(settings);
 		
 		m_recoilCorrector = new RecoilCorrector((settings.*GetRecoilCorrectorFile)());
 		
-		if ((settings.GetMetSysType() != 0) || (settings.GetMetSysShift() != 0))
+		m_doMetSys = ((settings.GetMetSysType() != 0) || (settings.GetMetSysShift() != 0));
+		m_doMetSysVariants = settings.GetMetSysAllVariants();
+		
+		if (m_doMetSys || m_doMetSysVariants)
+		{
+			m_metShiftCorrector = new MEtSys((settings.*GetMetShiftCorrectorFile)(), settings.GetCorrectionSnapshotDirectory());
+		}
+		
+		if (m_doMetSys)
 		{
-			m_metShiftCorrector = new MEtSys((settings.*GetMetShiftCorrectorFile)());
-
 			if (settings.GetMetSysType() == 1)
 			{
 				m_sysType = MEtSys::SysType::Response;
@@ -96,8 +109,6 @@ public:
 			m_processType = MEtSys::ProcessType::EWK;
 		}
 		m_isWJets = boost::regex_search(settings.GetNickname(), boost::regex("W.?JetsToLNu", boost::regex::icase | boost::regex::extended));
-		
-		m_doMetSys = ((settings.GetMetSysType() != 0) || (settings.GetMetSysShift() != 0));
 
 		if(settings.GetMetCorrectionMethod() == "quantileMapping")
 			m_correctionMethod = MetCorrectorBase::CorrectionMethod::QUANTILE_MAPPING;
@@ -113,6 +124,28 @@ public:
 		{
 			m_metUncertaintyType = HttEnumTypes::ToMETUncertaintyType(settings.GetMetUncertaintyType());
 		}
+		
+		// the variants are only calculated by the corrector of the MET that is used as m_met,
+		// m_correctGlobalMet has to be set by the derived classes before calling this function
+		if (m_doMetSysVariants && m_correctGlobalMet)
+		{
+			std::vector<std::pair<MEtSys::SysType, std::string> > sysTypes = { {MEtSys::SysType::Response, "RecoilResponse"}, {MEtSys::SysType::Resolution, "RecoilResolution"} };
+			std::vector<std::pair<MEtSys::SysShift, std::string> > sysShifts = { {MEtSys::SysShift::Up, "Up"}, {MEtSys::SysShift::Down, "Down"} };
+			for (std::pair<MEtSys::SysType, std::string> const& sysType : sysTypes)
+			{
+				for (std::pair<MEtSys::SysShift, std::string> const& sysShift : sysShifts)
+				{
+					int type = sysType.first;
+					int shift = sysShift.first;
+					LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("met"+sysType.second+sysShift.second, [type, shift](event_type const& event, product_type const& product) {
+						return product.m_metSysVariants[type][shift].Pt();
+					});
+					LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("metphi"+sysType.second+sysShift.second, [type, shift](event_type const& event, product_type const& product) {
+						return product.m_metSysVariants[type][shift].Phi();
+					});
+				}
+			}
+		}
 	}
 
 	virtual void Produce(event_type const& event, product_type & product, 
@@ -286,6 +319,34 @@ public:
 			}
 		}
 		
+		// All recoil response/resolution variants of the MET in one go, the nominal MET is not changed
+		if (m_doMetSysVariants && m_correctGlobalMet)
+		{
+			float variantMetX[2][2], variantMetY[2][2];
+			
+			m_metShiftCorrector->ApplyAllMEtSys(
+				(product.*m_metMemberCorrected).p4.Px(), (product.*m_metMemberCorrected).p4.Py(),
+				genPx, genPy,
+				visPx, visPy,
+				nJets30,
+				m_processType,
+				variantMetX,
+				variantMetY
+			);
+			
+			for (int type = 0; type < 2; ++type)
+			{
+				for (int shift = 0; shift < 2; ++shift)
+				{
+					product.m_metSysVariants[type][shift].SetPxPyPzE(
+						variantMetX[type][shift],
+						variantMetY[type][shift],
+						0.,
+						std::sqrt(metResolution * metResolution + variantMetX[type][shift] * variantMetX[type][shift] + variantMetY[type][shift] * variantMetY[type][shift]));
+				}
+			}
+		}
+		
 		// Apply the correction to the MET object, if required (done for all the samples)
 		if (m_doMetSys)
 		{
@@ -328,8 +389,9 @@ protected:
 	MEtSys::SysShift m_sysShift;
 	bool m_isWJets;
 	bool m_doMetSys;
+	bool m_doMetSysVariants;
 	CorrectionMethod m_correctionMethod;
-	bool m_correctGlobalMet;
+	bool m_correctGlobalMet = false;
 	bool (setting_type::*GetUpdateMetWithCorrectedLeptons)(void) const;
 	KMETUncertainty::Type m_metUncertaintyType;
 };
@@ -10,6 +10,7 @@
 #include "boost/functional/hash.hpp"
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEventInputs.h"
 
 /**
    \brief Producer for the MET
@@ -17,7 +18,7 @@
 
 
 template<class TMet>
-class MetSelectorBase: public ProducerBase<HttTypes>
+class MetSelectorBase: public ProducerBase<HttTypes>, public HttEventInputs::Reader
 {
 public:
 
@@ -25,13 +26,30 @@ public:
 	typedef typename HttTypes::product_type product_type;
 	typedef typename HttTypes::setting_type setting_type;
 	
-	MetSelectorBase(TMet* event_type::*met, std::vector<TMet>* event_type::*mets) :
+	/// the collection names are needed for optional input collections only (see HttEventInputs)
+	MetSelectorBase(TMet* event_type::*met, std::vector<TMet>* event_type::*mets,
+	                std::string const& metCollection="", std::string const& metsCollection="") :
 		ProducerBase<HttTypes>(),
 		m_metMember(met),
-		m_metsMember(mets)
+		m_metsMember(mets),
+		m_metCollection(metCollection),
+		m_metsCollection(metsCollection)
 	{
 	}
 
+	virtual std::vector<std::string> GetOptionalInputs() const override
+	{
+		std::vector<std::string> optionalInputs;
+		for (std::string const& collection : {m_metCollection, m_metsCollection})
+		{
+			if (! collection.empty())
+			{
+				optionalInputs.push_back(collection);
+			}
+		}
+		return optionalInputs;
+	}
+
 	virtual void Init(setting_type const& settings) override
 	{
 		ProducerBase<HttTypes>::Init(settings);
@@ -128,7 +146,10 @@ public:
 	virtual void Produce(event_type const& event, product_type & product, 
 	                     setting_type const& settings) const override
 	{
-		if ((m_metsMember != nullptr) && ((event.*m_metsMember) != nullptr))
+		std::vector<TMet>* mets = ((m_metsMember != nullptr) ? event.GetOptionalCollection(m_metsMember, m_metsCollection) : nullptr);
+		TMet* met = (((mets == nullptr) && (m_metMember != nullptr)) ? event.GetOptionalCollection(m_metMember, m_metCollection) : nullptr);
+		
+		if (mets != nullptr)
 		{
 			assert(product.m_ptOrderedLeptons.size() > 0);
 			
@@ -170,11 +191,11 @@ public:
 
 			
 			bool foundMvaMet = false;
-			for (typename std::vector<TMet>::iterator met = (event.*m_metsMember)->begin(); met != (event.*m_metsMember)->end(); ++met)
+			for (typename std::vector<TMet>::iterator mvaMet = mets->begin(); mvaMet != mets->end(); ++mvaMet)
 			{
-				if (std::find(hashes.begin(), hashes.end(), met->leptonSelectionHash)!= hashes.end())
+				if (std::find(hashes.begin(), hashes.end(), mvaMet->leptonSelectionHash)!= hashes.end())
 				{
-					product.m_mvametUncorr = &(*met);
+					product.m_mvametUncorr = &(*mvaMet);
 					foundMvaMet = true;
 					break;
 				} 
@@ -193,9 +214,9 @@ public:
 				product.m_met = product.m_mvamet;
 			}
 		}
-		else if ((m_metMember != nullptr) && ((event.*m_metMember) != nullptr))
+		else if (met != nullptr)
 		{
-			product.m_pfmetUncorr = (event.*m_metMember);
+			product.m_pfmetUncorr = met;
 			
 			// Copy the MET object, for possible future corrections
 			product.m_pfmet = *(product.m_pfmetUncorr);
@@ -207,8 +228,7 @@ public:
 		}
 		else
 		{
-			assert(((m_metsMember != nullptr) && ((event.*m_metsMember) != nullptr)) ||
-			       ((m_metMember != nullptr) && ((event.*m_metMember) != nullptr)));
+			assert((mets != nullptr) || (met != nullptr));
 		}
 	}
 	
@@ -216,6 +236,8 @@ public:
 protected:
 	TMet* event_type::*m_metMember;
 	std::vector<TMet>* event_type::*m_metsMember;
+	std::string m_metCollection;
+	std::string m_metsCollection;
 };
 
 
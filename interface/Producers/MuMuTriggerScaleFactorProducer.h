@@ -3,8 +3,8 @@
 
 #include "Artus/Core/interface/ProducerBase.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/RooFunctorSet.h"
 #include "RooWorkspace.h"
-#include "RooFunctor.h"
 #include "TSystem.h"
 
 /**
@@ -34,14 +34,14 @@ public:
 		f.Close();
         gDirectory = savedir;
         gFile = savefile;
-        m_functorMu = m_workspace->function("m_trgIsoMu22orTkIsoMu22_desy_data")->functor(m_workspace->argSet("m_pt,m_eta"));
+        m_muonTriggerFunctors.Init(m_workspace, {"m_trgIsoMu22orTkIsoMu22_desy_data"}, "m_pt,m_eta");
 	}
 
 	virtual void Produce(event_type const& event, product_type & product, 
 	                     setting_type const& settings) const override;
 private:
     RooWorkspace *m_workspace;
-    RooFunctor* m_functorMu;
+    RooFunctorSet m_muonTriggerFunctors;
 
 
 };
@@ -4,11 +4,11 @@
 //#include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/Core/interface/ProducerBase.h"
 #include "RooWorkspace.h"
-#include "RooFunctor.h"
 #include "TSystem.h"
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string.hpp>
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/RooFunctorSet.h"
 
 /**
    \brief RooWorkspaceWeightProducer
@@ -49,8 +49,8 @@ private:
 protected:
 	bool m_saveTriggerWeightAsOptionalOnly;
 	std::map<int,std::vector<std::string>> m_weightNames;
-	std::map<int,std::vector<std::string>> m_functorArgs;
-	std::map<int,std::vector<RooFunctor*>> m_functors;
+	// one set per weight name, containing all objects configured for this weight
+	std::map<int,std::vector<RooFunctorSet>> m_functorSets;
 	RooWorkspace *m_workspace;
 
 };
@@ -11,6 +11,11 @@
 
    See https://indico.cern.ch/event/494682/contributions/1172505/attachments/1223578/1800218/mcaod-Feb15-2016.pdf for the motivation. This Producer copies event-by-event renormalization and factorization weights from the Kappa input file to the output. This can be used to calculate the migration of signal events between channels and categories.
 
+   The names of the LHE weights are resolved once per lumi section. Weights configured in
+   GenEventInfoMetadataNames get the configured name, all other weights keep their name in the input.
+   With LheWeightsAsArray, the weights are not copied into the optional weights, but provided
+   as the single vector quantity "lheWeights". The HttLambdaNtupleConsumer then writes
+   the corresponding names into the tree "lheWeightNames" next to the ntuple.
 */
 
 class ScaleVariationProducer: public ProducerBase<HttTypes> {
@@ -33,5 +38,6 @@ public:
 private:
 	std::map<std::string, std::vector<std::string> > genEventInfoMetadataMap;
 	std::vector<std::string> weightNames;
+	bool m_lheWeightsAsArray = false;
 
 };
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+
+#include "Artus/Core/interface/ProducerBase.h"
+#include "Artus/Core/interface/FilterBase.h"
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+
+class HttFactory;
+
+/**
+   \brief Runs processors that are identical in several pipelines only once per event for all of them.
+
+   Config tags:
+   - SharedPrefixProcessors: processors of this pipeline to be run by this producer ("producer:..." or "filter:...")
+
+   Each processor is identified by its name, the values of the varied settings it declares (see HttVariedSettings)
+   and the identification of the processors before it. All settings of the pipeline that are not declared by any
+   of its SharedPrefixProcessors are part of the identification of the first processor. The pipelines with the
+   same identification of a processor share one instance of it, such that every group of pipelines shares its
+   longest common prefix. The shared processors form a tree, which is owned by the HttFactory that created this
+   producer. The processors are created by the same factory, such that their inputs are known to it (see
+   HttEventInputs). Processors of other packages without declaration in HttVariedSettings are not shared.
+
+   The first pipeline processing an event runs the processors on its product. After each processor where the
+   pipelines sharing it continue with different processors, it keeps a copy of the product, from which these
+   pipelines continue instead of running the processors again. The kept products are accessible through const
+   references only. Objects referenced by pointers in them are shared between the pipelines and must not be
+   modified by the processors following the shared ones. This is checked for the momenta of the corrected
+   leptons and jets whenever a pipeline continues from a kept product.
+
+   Filters stop the processing of the SharedPrefixProcessors. Their decisions are stored in
+   product.m_sharedPrefixFilterDecisions under their own filter IDs and have to be evaluated by the
+   SharedPrefixFilter.
+*/
+class SharedPrefixProducer: public ProducerBase<HttTypes> {
+public:
+
+	typedef typename HttTypes::event_type event_type;
+	typedef typename HttTypes::product_type product_type;
+	typedef typename HttTypes::setting_type setting_type;
+
+	class SharedProcessor;
+
+	SharedPrefixProducer(HttFactory* factory=nullptr);
+
+	virtual std::string GetProducerId() const override {
+		return "SharedPrefixProducer";
+	}
+
+	virtual void Init(setting_type const& settings) override;
+
+	virtual void OnLumi(event_type const& event, setting_type const& settings) override;
+
+	virtual void Produce(event_type const& event, product_type& product,
+	                     setting_type const& settings) const override;
+
+private:
+	HttFactory* m_factory;
+	std::vector<std::shared_ptr<SharedProcessor> > m_processors;
+};
+
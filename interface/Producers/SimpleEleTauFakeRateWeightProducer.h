@@ -1,7 +1,7 @@
 
 #pragma once
 
-#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/LeptonTauFakeRateWeightProducer.h"
 
 /**
    \brief SimpleEleTauFakeRateWeightProducer
@@ -10,7 +10,7 @@
 
 */
 
-class SimpleEleTauFakeRateWeightProducer : public ProducerBase<HttTypes> {
+class SimpleEleTauFakeRateWeightProducer : public LeptonTauFakeRateWeightProducer {
 public:
 
 	typedef typename HttTypes::event_type event_type;
@@ -23,17 +23,13 @@ public:
 
 	std::string GetProducerId() const override;
 
-	virtual void Init(setting_type const& settings) override;
+protected:
+	virtual void AddTables(setting_type const& settings) override;
 
-	void Produce(event_type const& event, product_type& product,
-				 setting_type const& settings) const override;
 private:
 
 	// the weights within each vector should be ordered by increasing |eta| in your json config
 	// with lowest |eta| being the first entry and highest |eta| the last one
 	std::vector<float>& (setting_type::*GetSimpleEleTauFakeRateWeightVLoose)(void) const;
 	std::vector<float>& (setting_type::*GetSimpleEleTauFakeRateWeightTight)(void) const;
-
-	std::vector<float> SimpleEleTauFakeRateWeightVLoose;
-	std::vector<float> SimpleEleTauFakeRateWeightTight;
 };
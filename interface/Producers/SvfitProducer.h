@@ -2,15 +2,24 @@
 #pragma once
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttVariedSettings.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/SvfitTools.h"
 
 
 /** Producer for SVfit
  *
  *  Required config tags:
- *  - SvfitIntegrationMethod (possible values: markovchain, vegas)
+ *  - SvfitIntegrationMethod (possible values: markovchain, vegas, collinear)
+ *    collinear is a fast estimate without integration and cache (precision of roughly 10% on the mass),
+ *    meant for pipelines that do not need the full SVfit, e.g. control regions and systematic shifts
  *  - GetSvfitCacheFile (need to be implemented as global setting, default: empty)
  *  - GetSvfitCacheTree (need to be implemented as global setting, default: svfitCache)
+ *  - SvfitInJobCacheSize (default: 100, 0 disables the cache for the pipeline)
+ *    number of results kept in memory and shared between all pipelines using the cache, the largest value of
+ *    these pipelines is used for the shared cache. Results are looked up by the event
+ *    key in the cache tree of the pipeline, then by the content of the inputs in the in-job cache and finally
+ *    by the content of the inputs in all loaded cache trees, such that shifts that do not change the inputs
+ *    reuse the results of other pipelines.
  *
  *  Required packages:
  *  git clone https://github.com:veelken/SVfit_standalone.git TauAnalysis/SVfitStandalone
@@ -20,7 +29,7 @@
  *  cvs co -r V00-02-03s TauAnalysis/CandidateTools
  *  https://twiki.cern.ch/twiki/bin/viewauth/CMS/HiggsToTauTauWorkingSummer2013#Di_Tau_Mass_Reconstruction
  */
-class SvfitProducer: public ProducerBase<HttTypes> {
+class SvfitProducer: public ProducerBase<HttTypes>, public HttVariedSettings::Reader {
 public:
 
 	typedef typename HttTypes::event_type event_type;
@@ -36,6 +45,10 @@ public:
 		return "SvfitProducer";
 	}
 	
+	virtual std::vector<std::string> GetVariedSettings() const override {
+		return { "SvfitCacheFileFolder" };
+	}
+	
 	virtual void Init(setting_type const& settings) override;
 
 	virtual void Produce(event_type const& event, product_type& product,
@@ -4,6 +4,7 @@
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/KappaMetadataBinding.h"
 
 
 /** Producer that creates a valid tau pair (ttH analysis).
@@ -23,4 +24,8 @@ public:
 	
 	virtual void Produce(event_type const& event, product_type& product,
 	                     setting_type const& settings) const override;
+
+private:
+	TauDiscriminatorBinding m_tauDiscriminatorBinding;
+	size_t m_isolationDiscriminatorHandle;
 };
@@ -3,6 +3,7 @@
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEnumTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttVariedSettings.h"
 
 #include "CondFormats/JetMETObjects/interface/JetCorrectionUncertainty.h"
 #include "CondFormats/JetMETObjects/interface/JetCorrectorParameters.h"
@@ -17,7 +18,7 @@
    - JetEnergyCorrectionSplitUncertaintyParameters (file location)
    - JetEnergyCorrectionSplitUncertaintyParameterNames (list of names)
 */
-class TaggedJetUncertaintyShiftProducer: public ProducerBase<HttTypes>
+class TaggedJetUncertaintyShiftProducer: public ProducerBase<HttTypes>, public HttVariedSettings::Reader
 {
 
 public:
@@ -28,6 +29,7 @@ public:
 	
 	virtual void Init(setting_type const& settings) override;
 	std::string GetProducerId() const override;
+	virtual std::vector<std::string> GetVariedSettings() const override;
 	virtual void Produce(event_type const& event, product_type& product, setting_type const& settings) const override;
 
 private:
@@ -3,8 +3,8 @@
 
 #include "Artus/Core/interface/ProducerBase.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/RooFunctorSet.h"
 #include "RooWorkspace.h"
-#include "RooFunctor.h"
 #include "TSystem.h"
 
 /**
@@ -34,16 +34,16 @@ public:
 		f.Close();
         gDirectory = savedir;
         gFile = savefile;
-        m_functorTau1 = m_workspace->function("t_trgTightIso_data")->functor(m_workspace->argSet("t_pt"));
-        m_functorTau1ss = m_workspace->function("t_trgTightIsoSS_data")->functor(m_workspace->argSet("t_pt"));
+        // the efficiencies are given per tau and are therefore used for both legs
+        m_tauTriggerFunctors.Init(m_workspace, {"t_trgTightIso_data", "t_trgTightIsoSS_data"}, "t_pt");
 	}
 
 	virtual void Produce(event_type const& event, product_type & product, 
 	                     setting_type const& settings) const override;
 private:
     RooWorkspace *m_workspace;
-    RooFunctor* m_functorTau1;
-    RooFunctor* m_functorTau1ss;
+    // genuine taus (0) and other objects (1)
+    RooFunctorSet m_tauTriggerFunctors;
 
 
 };
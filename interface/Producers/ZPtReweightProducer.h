@@ -3,9 +3,9 @@
 
 #include "Artus/Core/interface/ProducerBase.h"
 #include "RooWorkspace.h"
-#include "RooFunctor.h"
 #include "TSystem.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttTypes.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/RooFunctorSet.h"
 #include <boost/regex.hpp>
 
 /**
@@ -30,8 +30,10 @@ public:
 	virtual void Produce(event_type const& event, product_type & product, 
 	                     setting_type const& settings) const override;
 private:
-	RooFunctor* m_ZptWeightFunktor;
-	std::map<std::string,RooFunctor*> m_ZptWeightUncertaintiesFunktor;
+	// nominal weight first, followed by the uncertainties
+	RooFunctorSet m_ZptWeightFunktors;
+	std::vector<std::string> m_ZptWeightNames;
+	mutable std::vector<double> m_ZptWeights;
 	RooWorkspace *m_workspace;
 	bool m_applyReweighting;
 };
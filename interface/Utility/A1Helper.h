@@ -29,24 +29,31 @@ using namespace std;
 class a1Helper {
  
  public:
+  enum class ResonanceType : int {Rho=0, RhoPrime=1, A1=2, PiPrime=3};
+  enum class StructureFunctionType : int {NONE=-1, WA=0, WC=1, WSA=2, WSB=3, WD=4, WE=5, WSD=6, N_TYPES=7};
+  static StructureFunctionType ToStructureFunctionType(string const& type);
+
   a1Helper();
-  a1Helper(vector<TLorentzVector> TauA1andProd);
-  a1Helper(vector<TLorentzVector> TauA1andProd, TLorentzVector RefernceFrame);
+  a1Helper(vector<TLorentzVector> const& TauA1andProd);
+  a1Helper(vector<TLorentzVector> const& TauA1andProd, TLorentzVector const& RefernceFrame);
+  // inputs in the order tau, opposite sign pion, same sign pion 1, same sign pion 2
+  a1Helper(TLorentzVector const& tau, TLorentzVector const& osPion, TLorentzVector const& ss1Pion, TLorentzVector const& ss2Pion, TLorentzVector const& RefernceFrame);
   ~a1Helper();
-  void Configure(vector<TLorentzVector> TauA1andProd);
-  void Configure(vector<TLorentzVector> TauA1andProd, TLorentzVector RefernceFrame);
+  void Configure(vector<TLorentzVector> const& TauA1andProd);
+  void Configure(vector<TLorentzVector> const& TauA1andProd, TLorentzVector const& RefernceFrame);
   bool isConfigured();
-  void Setup(vector<TLorentzVector> TauA1andProd, TLorentzVector ReferenceFrame );
+  void Setup(vector<TLorentzVector> const& TauA1andProd, TLorentzVector const& ReferenceFrame );
+  void Setup(TLorentzVector const TauA1andProd[4], TLorentzVector const& ReferenceFrame );
   void subSetup(double s1, double s2, double s3, double Q);
 
   void Initialize(TLorentzVector t, TLorentzVector mu);
   bool OmegaIsValid(){return isValid_;}
-  std::vector<TLorentzVector> getBoosted(){return TauA1andProd_RF;}
+  std::vector<TLorentzVector> getBoosted(){return std::vector<TLorentzVector>(TauA1andProd_RF, TauA1andProd_RF+4);}
 
 
   void SetParametersReco(TLorentzVector tau, TLorentzVector mu );
   void SetFrame(TLorentzVector Vec );
-  TLorentzVector Boost(TLorentzVector pB, TLorentzVector frame);
+  TLorentzVector Boost(TLorentzVector const& pB, TLorentzVector const& frame);
 
   /* double costheta(); */
   /* double costheta1(); */
@@ -56,23 +63,24 @@ class a1Helper {
   /* float CosPsi(); */
 
   //====================
-  double costhetaLF(); 
-  double sinthetaLF();
+  // angles depending only on the inputs of Setup are cached there
+  double costhetaLF(){return _costhetaLF;}
+  double sinthetaLF(){return _sinthetaLF;}
 
   double cosbetaLF();
-  double cospsiLF();
-  double sinpsiLF();
+  double cospsiLF(){return _cospsiLF;}
+  double sinpsiLF(){return _sinpsiLF;}
   double ultrarel_cospsiLF();
   double cosgammaLF();
   double singammaLF();
-  double cosalpha();
-  double sinalpha();
+  double cosalpha(){return _cosalpha;}
+  double sinalpha(){return _sinalpha;}
   double cos2gamma();
   double sin2gamma();
-  double singamma();
-  double cosgamma();
-  double cosbeta();
-  double sinbeta();
+  double singamma(){return _singamma;}
+  double cosgamma(){return _cosgamma;}
+  double cosbeta(){return _cosbeta;}
+  double sinbeta(){return _sinbeta;}
   //====================
   double getg();
   double getf();
@@ -97,29 +105,32 @@ class a1Helper {
 //========== TRF  =======
   void debugger();
   double lambda(double x, double y, double z);
-  double Scalar(TLorentzVector p1, TLorentzVector p2);
+  double Scalar(TLorentzVector const& p1, TLorentzVector const& p2);
 
+  // Dalitz plot integral of a structure function as a function of s = Q^2
   double MomentSFunction(double s,string type="WA");
+  double MomentSFunction(double s,StructureFunctionType type);
 
   //--------------------------- Hadronic current ---------------------
   //  only 9 structure fucbntions are non-zero in 3pions case
+  //  form factors and structure functions are cached by Setup/subSetup
 
-  double WA();
-  double WC();
-  double WD();
-  double WE();
-  double WSA();
-  double WSB();
-  double WSD();
-  double WSC();
-  double  WSE();
+  double WA(){return _WA;}
+  double WC(){return _WC;}
+  double WD(){return _WD;}
+  double WE(){return _WE;}
+  double WSA(){return _WSA;}
+  double WSB(){return _WSB;}
+  double WSD(){return _WSD;}
+  double WSC(){return _WSC;}
+  double  WSE(){return _WSE;}
 
 
-  double VV1();
-  double VV2();
-  double V1V2();
-  double h0();
-  double h();
+  double VV1(){return _VV1;}
+  double VV2(){return _VV2;}
+  double V1V2(){return _V1V2;}
+  double h0(){return _h0;}
+  double h(){return _h;}
 
   TVector3 nL();
   TVector3 nT();
@@ -129,16 +140,16 @@ class a1Helper {
 
 
 
-  TComplex  BreitWigner(double Q, string type="rho");
+  TComplex  BreitWigner(double Q, ResonanceType type=ResonanceType::Rho);
   TComplex  BRho(double Q);
-  TComplex F1();
-  TComplex F2();
-  TComplex F4();
-  TComplex   Conjugate(TComplex a);
-  double  Widths(double Q, string type="rho");
+  TComplex F1(){return _F1;}
+  TComplex F2(){return _F2;}
+  TComplex F4(){return _F4;}
+  TComplex   Conjugate(TComplex const& a);
+  double  Widths(double Q, ResonanceType type=ResonanceType::Rho);
   double ppi(double QQ);
   double ga1(double  Q);
-  double Mass(string type="rho");
+  double Mass(ResonanceType type=ResonanceType::Rho);
 
 
   TComplex  BWa1(float QQ);
@@ -180,7 +191,12 @@ class a1Helper {
 
   bool debug;
 
-  vector<TLorentzVector> TauA1andProd_RF;
+  // constant factors of the widths
+  double ppiAtMrho;
+  double ga1AtMa1;
+
+  bool isConfigured_;
+  TLorentzVector TauA1andProd_RF[4];
   TLorentzVector _osPionLV;
   TLorentzVector _ss1pionLV;
   TLorentzVector _ss2pionLV;
@@ -196,6 +212,37 @@ class a1Helper {
   double _s3; 
   double _Q;
 
+  // cached by UpdateStructureFunctions
+  TComplex _F1;
+  TComplex _F2;
+  TComplex _F4;
+  double _VV1;
+  double _VV2;
+  double _V1V2;
+  double _h0;
+  double _h;
+  double _WA;
+  double _WC;
+  double _WD;
+  double _WE;
+  double _WSA;
+  double _WSB;
+  double _WSC;
+  double _WSD;
+  double _WSE;
+
+  // cached by UpdateAngles
+  double _costhetaLF;
+  double _sinthetaLF;
+  double _cospsiLF;
+  double _sinpsiLF;
+  double _cosbeta;
+  double _sinbeta;
+  double _cosgamma;
+  double _singamma;
+  double _cosalpha;
+  double _sinalpha;
+
 
   double LFQ;
   TLorentzVector   LFosPionLV;
@@ -229,6 +276,22 @@ class a1Helper {
 
   TMatrixT<double> convertToMatrix(TVectorT<double> V);
 
+  void SetParameters();
+  double IntegrateMomentSFunction(double s, StructureFunctionType type);
+  void UpdateStructureFunctions();
+  void UpdateAngles();
+
+  double computeCosthetaLF();
+  double computeSinthetaLF();
+  double computeCospsiLF();
+  double computeSinpsiLF();
+  double computeCosbeta();
+  double computeSinbeta();
+  double computeCosgamma();
+  double computeSingamma();
+  double computeCosalpha();
+  double computeSinalpha();
+
 
 };
 #endif
@@ -1,4 +1,3 @@
-
 #pragma once
 
 #include <utility>
@@ -14,95 +13,94 @@
    -Phi* : this is a variable, with which one can say, whether the considered boson is a CP even state or a CP odd state
    -Phi*CP : this is a variable, with which one can figure out, whether the Higgs is a CP mixture or not
    -Zs : this is a variable, with which one can figure out, wether the considered boson has spin 1 (Z) or 0 (Higgs)
+
+   All functions are stateless. The frames into which several observables of one tau pair are boosted
+   are represented by the structs below, such that the boosts are done only once per pair and frame.
 */
 
 class CPQuantities
 {
 public:
-	double CalculatePhiStarCP(RMFLV tau1, RMFLV tau2, RMFLV chargPart1, RMFLV chargPart2);
-	double CalculatePhiStarCP(KVertex* pv , KTrack track1, KTrack track2, RMFLV chargPart1,RMFLV chargPart2);
-	double CalculatePhiStarCP(RMFLV chargPart1, RMFLV chargPart2, TVector3 ipvec1, TVector3 ipvec2);
-	double CalculatePhiStarCP_rho(RMFLV chargedPiP, RMFLV chargedPiM, RMFLV piZeroP, RMFLV piZeroM);
-	double CalculateChargedHadronEnergy(RMFLV diTauMomentum, RMFLV chargHad);
-	double CalculatePhiCP(RMFLV boson, RMFLV tau1, RMFLV tau2, RMFLV pion1, RMFLV pion2);
-	double CalculatePhiCPLab(RMFLV tau1, RMFLV tau2, RMFLV pion1, RMFLV pion2);
-	double CalculateChargedProngEnergy(RMFLV tau, RMFLV chargedProng);
-	double CalculateChargedProngEnergyApprox(RMFLV tau, RMFLV chargedProng);
-	double CalculateSpinAnalysingDiscriminant_rho(RMFLV tau1, RMFLV tau2, RMFLV pionP, RMFLV pionM, RMFLV pi0P, RMFLV pi0M);
-	double CalculateSpinAnalysingDiscriminant_rho(RMFLV chargedPion, RMFLV pi0);
-	double CalculateTrackReferenceError(KTrack track);
-	double CalculateZPlusMinus(RMFLV higgs, RMFLV chargedPart);
-	double CalculateZs(double zPlus, double zMinus);
-	double PhiTransform(double phi);
-	TVector3 CalculateIPVector(KGenParticle* genParticle, RMPoint* pv);
-	TVector3 CalculateIPVector(KLepton* recoParticle, KVertex* pv);
-	double CalculateCosPsi(RMFLV recoPart, TVector3 ipvec);
-	std::vector<double> CalculateIPErrors(KLepton* lepton, KVertex* pv, TVector3* ipvec);
-	inline double GetGenPhiStar()
-	{
-		return genPhiStar;
-	}
-	inline double GetGenOStarCP()
+	/// zero momentum frame (ZMF) of the two charged prongs, shared by the IP and rho methods
+	struct ZeroMomentumFrame
 	{
-		return genOStarCP;
-	}
-	inline double GetGenPhi()
-	{
-		return genPhi;
-	}
-	inline double GetGenOCP()
-	{
-		return genOCP;
-	}
-	inline double GetRecoPhiStar()
+		ROOT::Math::Boost boost;
+		RMFLV::BetaVector labP1; // 3-momentum of chargPart1 in the laboratory frame
+		RMFLV::BetaVector labP2; // 3-momentum of chargPart2 in the laboratory frame
+		RMFLV chargPart1; // boosted into the ZMF
+		RMFLV chargPart2; // boosted into the ZMF
+		RMFLV::BetaVector p1; // 3-momentum of chargPart1 in the ZMF
+		RMFLV::BetaVector p2; // 3-momentum of chargPart2 in the ZMF
+	};
+
+	/// rest frame of the boson, shared by phiCP and z+-
+	struct BosonRestFrame
 	{
-		return recoPhiStar;
-	}
-	inline double GetRecoIP1()
+		ROOT::Math::Boost boost;
+		RMFLV boson; // boosted into the boson rest frame
+		RMFLV tau1;
+		RMFLV chargPart1;
+		RMFLV chargPart2;
+	};
+
+	struct PhiStarCPResult
 	{
-		return recoIP1;
-	}
-	inline double GetRecoIP2()
+		double phiStarCP = 0.0;
+		double phiStar = 0.0;
+		double oStarCP = 0.0;
+		RMFLV::BetaVector n1t; // normalised component of the first IP vector transverse to p1 in the ZMF
+		RMFLV::BetaVector n2t; // normalised component of the second IP vector transverse to p2 in the ZMF
+	};
+
+	struct PhiCPResult
 	{
-		return recoIP2;
-	}
+		double phiCP = 0.0;
+		double phi = 0.0;
+		double oCP = 0.0;
+		RMFLV::BetaVector nm; // normal vector on the first decay plane in the boson rest frame
+		RMFLV::BetaVector np; // normal vector on the second decay plane in the boson rest frame
+	};
+
+	static ZeroMomentumFrame CalculateZeroMomentumFrame(RMFLV const& chargPart1, RMFLV const& chargPart2);
+	static BosonRestFrame CalculateBosonRestFrame(RMFLV const& boson, RMFLV const& tau1, RMFLV const& chargPart1, RMFLV const& chargPart2);
+
+	// Phi*CP using the tau momenta (gen level), the track reference points (reco level) or the IP vectors
+	static PhiStarCPResult CalculatePhiStarCP(ZeroMomentumFrame const& zmf, RMFLV const& tau1, RMFLV const& tau2);
+	static PhiStarCPResult CalculatePhiStarCP(ZeroMomentumFrame const& zmf, KVertex const* pv, KTrack const& track1, KTrack const& track2);
+	static PhiStarCPResult CalculatePhiStarCP(ZeroMomentumFrame const& zmf, TVector3 const& ipvec1, TVector3 const& ipvec2);
+	static double CalculatePhiStarCP(RMFLV const& tau1, RMFLV const& tau2, RMFLV const& chargPart1, RMFLV const& chargPart2);
+	static double CalculatePhiStarCP(KVertex const* pv, KTrack const& track1, KTrack const& track2, RMFLV const& chargPart1, RMFLV const& chargPart2);
+	static double CalculatePhiStarCP(RMFLV const& chargPart1, RMFLV const& chargPart2, TVector3 const& ipvec1, TVector3 const& ipvec2);
+
+	static double CalculatePhiStarCP_rho(ZeroMomentumFrame const& zmf, RMFLV const& piZeroP, RMFLV const& piZeroM);
+	static double CalculatePhiStarCP_rho(RMFLV const& chargedPiP, RMFLV const& chargedPiM, RMFLV const& piZeroP, RMFLV const& piZeroM);
+
+	static PhiCPResult CalculatePhiCP(BosonRestFrame const& frame);
+	static double CalculatePhiCP(RMFLV const& boson, RMFLV const& tau1, RMFLV const& tau2, RMFLV const& pion1, RMFLV const& pion2);
+	static double CalculatePhiCPLab(RMFLV const& tau1, RMFLV const& tau2, RMFLV const& pion1, RMFLV const& pion2);
+
+	static double CalculateChargedHadronEnergy(RMFLV const& diTauMomentum, RMFLV const& chargHad);
+	static double CalculateChargedProngEnergy(RMFLV const& tau, RMFLV const& chargedProng);
+	static double CalculateSpinAnalysingDiscriminant_rho(RMFLV const& tau1, RMFLV const& tau2, RMFLV const& pionP, RMFLV const& pionM, RMFLV const& pi0P, RMFLV const& pi0M);
+	static double CalculateSpinAnalysingDiscriminant_rho(RMFLV const& chargedPion, RMFLV const& pi0);
+	static double CalculateTrackReferenceError(KTrack const& track);
+
+	// (z+, z-) of the two charged particles of the frame
+	static std::pair<double, double> CalculateZPlusMinus(BosonRestFrame const& frame);
+	static double CalculateZPlusMinus(RMFLV const& higgs, RMFLV const& chargedPart);
+	static double CalculateZs(double zPlus, double zMinus);
+	static double PhiTransform(double phi);
+
+	static TVector3 CalculateIPVector(KGenParticle const* genParticle, RMPoint const* pv);
+	static TVector3 CalculateIPVector(KLepton const* recoParticle, KVertex const* pv);
+	static double CalculateCosPsi(RMFLV const& recoPart, TVector3 const& ipvec);
+	static std::vector<double> CalculateIPErrors(KLepton const* lepton, KVertex const* pv, TVector3 const* ipvec);
+
 private:
-	double genPhiStar;
-	double genOStarCP;
-	double genPhi;
-	double genOCP;
-	double recoPhiStar;
-	double recoIP1;
-	double recoIP2;
-	//level: "gen", "reco"
-	double CalculatePhiStarCPSame(RMFLV::BetaVector k1, RMFLV::BetaVector k2, RMFLV chargPart1, RMFLV chargPart2, std::string level);
-	double CalculateOStarCPSame(RMFLV::BetaVector k1, RMFLV::BetaVector k2, RMFLV chargPart1, RMFLV chargPart2);
-	inline void SetGenPhiStar(double genphistar)
-	{
-		genPhiStar = genphistar;
-	}
-	inline void SetGenOStarCP(double genostarcp)
-	{
-		genOStarCP = genostarcp;
-	}
-	inline void SetGenPhi(double genphi)
-	{
-		genPhi = genphi;
-	}
-	inline void SetGenOCP(double genocp)
-	{
-		genOCP = genocp;
-	}
-	inline void SetRecoPhiStar(double recophistar)
-	{
-		recoPhiStar = recophistar;
-	}
-	inline void SetRecoIP1(double recoip1)
-	{
-		recoIP1 = recoip1;
-	}
-	inline void SetRecoIP2(double recoip2)
-	{
-		recoIP2 = recoip2;
-	}
+	CPQuantities() {  };
+
+	// k1, k2: flight directions of the taus in the laboratory frame
+	static PhiStarCPResult CalculatePhiStarCPSame(ZeroMomentumFrame const& zmf, RMFLV::BetaVector const& k1, RMFLV::BetaVector const& k2);
+	// n1, n2: normalised IP vectors in the laboratory frame
+	static PhiStarCPResult CalculatePhiStarCPFromIPVectors(ZeroMomentumFrame const& zmf, RMFLV::BetaVector const& n1, RMFLV::BetaVector const& n2);
 };
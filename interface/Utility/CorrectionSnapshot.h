@@ -0,0 +1,109 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <TH1.h>
+#include <TH2.h>
+
+
+/**
+   \brief Binary snapshot of lookup data extracted from correction input files.
+
+   Producers extract plain lookup data (numbers, histogram contents) from their input files in
+   Init. The snapshot stores these data as named arrays of doubles in one file, which is keyed by
+   the contents of all input files, the names of the extracted objects and the format version.
+   Later jobs with identical inputs map the file into memory instead of opening and parsing the
+   input files again. Snapshots are disabled if an input file cannot be read locally (e.g. remote
+   files), in which case the producers read the input files directly. Histograms are served by BinnedLookup objects that
+   read the bin contents directly from the mapped arrays.
+
+   File layout (native byte order, all offsets are 8-byte aligned):
+   - header: magic (8 bytes), format version, number of entries, key
+   - index: per entry the length of the name, the padded name, the number of values and the offset
+   - data: the arrays of doubles
+*/
+class CorrectionSnapshot
+{
+public:
+	static const unsigned int FORMAT_VERSION = 2;
+
+	/**
+	   Bin contents of a 1D or 2D histogram with the binning conventions of TH1::FindBin (including
+	   under- and overflow bins). The arrays are either mapped from a snapshot, which has to outlive
+	   the lookup, or owned by the lookup (and shared between its copies).
+	*/
+	class BinnedLookup
+	{
+	public:
+		BinnedLookup() {}
+		explicit BinnedLookup(TH1 const* histogram);
+
+		double GetBinContent(double x, double y=0.0) const;
+
+	private:
+		friend class CorrectionSnapshot;
+
+		static size_t FindBin(double const* edges, size_t nEdges, double value);
+
+		double const* m_xEdges = nullptr;
+		size_t m_nXEdges = 0;
+		double const* m_yEdges = nullptr;
+		size_t m_nYEdges = 0;
+		double const* m_contents = nullptr;
+		std::shared_ptr<std::vector<double> > m_ownedData;
+	};
+
+	CorrectionSnapshot(std::string const& directory, std::string const& tag,
+	                   std::vector<std::string> const& inputFiles,
+	                   std::vector<std::string> const& objectNames);
+	~CorrectionSnapshot();
+
+	CorrectionSnapshot(CorrectionSnapshot const&) = delete;
+	CorrectionSnapshot& operator=(CorrectionSnapshot const&) = delete;
+
+	// false if snapshots are disabled (empty directory) or no valid snapshot exists for the key
+	bool IsLoaded() const { return (m_mappedData != nullptr); }
+	bool IsEnabled() const { return (! m_directory.empty()); }
+	std::string const& GetFileName() const { return m_fileName; }
+
+	// access to the mapped data, valid as long as this object lives
+	bool Has(std::string const& name) const;
+	std::vector<double> GetArray(std::string const& name) const;
+	double GetValue(std::string const& name) const;
+	BinnedLookup GetBinnedLookup(std::string const& name) const;
+
+	// collection of data for a new snapshot, written by Write
+	void AddArray(std::string const& name, std::vector<double> const& values);
+	void AddValue(std::string const& name, double value);
+	void AddHistogram(std::string const& name, TH1 const* histogram);
+	bool Write();
+
+	// 64 bit FNV-1a hash
+	static unsigned long long Hash(char const* data, size_t size, unsigned long long hash = 14695981039346656037ULL);
+	// updates the hash with the content of a file, false if the file cannot be read locally
+	static bool HashFileContent(std::string const& fileName, unsigned long long& hash);
+
+private:
+	struct ArrayView
+	{
+		double const* values = nullptr;
+		size_t size = 0;
+	};
+
+	ArrayView const& GetView(std::string const& name) const;
+	bool Load();
+
+	std::string m_directory;
+	std::string m_fileName;
+	unsigned long long m_key = 0;
+
+	void* m_mappedData = nullptr;
+	size_t m_mappedSize = 0;
+	std::map<std::string, ArrayView> m_views;
+
+	std::map<std::string, std::vector<double> > m_newArrays;
+};
+
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+
+/**
+   \brief Counter-based random numbers (Philox4x32-10) for deterministic per-event smearing.
+
+   Every stream is fully determined by (run, lumi, event), a stream id identifying the user
+   (producer/consumer, see GetStreamId) and an object index. No generator state is carried over
+   between events, such that the results do not depend on the order in which events are processed
+   and sharded, parallel or resumed processing give identical output. The stream id does not depend
+   on the pipeline, such that nominal and shifted pipelines smear the same objects identically.
+   Instances are cheap and meant to be created on the stack where random numbers are needed.
+*/
+class CounterBasedRandom
+{
+public:
+	// to be computed once in Init from GetProducerId() or GetConsumerId()
+	static uint64_t GetStreamId(std::string const& name);
+
+	CounterBasedRandom(uint64_t run, uint64_t lumi, uint64_t event, uint64_t streamId, uint64_t objectIndex=0);
+	CounterBasedRandom(KEventInfo const* eventInfo, uint64_t streamId, uint64_t objectIndex=0);
+
+	// uniform in the open interval (0, 1)
+	double Uniform();
+	// uniform in the open interval (min, max)
+	double Uniform(double min, double max);
+	double Gaus(double mean=0.0, double sigma=1.0);
+
+	/// multiplies the four-momenta by (1 + Gaus(0, relativeWidth)), the object index of each stream is
+	/// the position in the vector, an ordering by pt is restored after the smearing
+	template<class TObject>
+	static void SmearMomenta(std::vector<std::shared_ptr<TObject> >& objects, KEventInfo const* eventInfo,
+	                         uint64_t streamId, double relativeWidth)
+	{
+		auto higherPt = [](std::shared_ptr<TObject> const& object1, std::shared_ptr<TObject> const& object2)
+		{
+			return object1->p4.Pt() > object2->p4.Pt();
+		};
+		bool sortedByPt = std::is_sorted(objects.begin(), objects.end(), higherPt);
+		for (size_t objectIndex = 0; objectIndex < objects.size(); ++objectIndex)
+		{
+			CounterBasedRandom random(eventInfo, streamId, objectIndex);
+			objects[objectIndex]->p4 = objects[objectIndex]->p4 * (1.0 + random.Gaus(0.0, relativeWidth));
+		}
+		if (sortedByPt)
+		{
+			std::stable_sort(objects.begin(), objects.end(), higherPt);
+		}
+	}
+
+	static std::array<uint32_t, 4> Philox4x32(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key);
+	// compares Philox4x32 to the known answers of the reference implementation (see test/testCounterBasedRandom.cc)
+	static bool CheckKnownAnswers();
+
+private:
+	uint32_t Next();
+
+	std::array<uint32_t, 4> m_counter;
+	std::array<uint32_t, 2> m_key;
+	std::array<uint32_t, 4> m_block;
+	size_t m_blockPosition = 4;
+
+	bool m_hasCachedGaus = false;
+	double m_cachedGaus = 0.0;
+};
+
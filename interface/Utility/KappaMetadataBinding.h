@@ -0,0 +1,126 @@
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+
+/**
+   \brief Resolves names of tau discriminators, electron IDs and jet tags to positions in the Kappa metadata.
+
+   The functions KTau::getDiscriminator, KElectron::getId and KJet::getTag search the name in the
+   metadata for every call. With these bindings, the names are registered once (usually in Init)
+   and the positions of all registered names are resolved whenever the metadata may have changed
+   (different metadata object, run or lumi section). Afterwards, the values are read by position.
+   Names that cannot be resolved are passed on to the Kappa functions, which then decide what to
+   return for unknown names.
+
+   The bindings are meant to be shared (e.g. via std::shared_ptr) by all lambda functions of a
+   processor. Registering names after the first lookup is possible, but triggers a rebinding.
+*/
+class KappaMetadataBinding
+{
+public:
+	/// handle to be passed to the getter functions
+	size_t Register(std::string const& name);
+	std::string const& GetName(size_t handle) const { return m_names[handle]; }
+
+protected:
+	/// true if the positions have to be resolved again for the given metadata
+	bool NeedsBinding(void const* metadata, KEventInfo const* eventInfo) const;
+	void SetBound(void const* metadata, KEventInfo const* eventInfo) const;
+
+	std::vector<std::string> m_names;
+
+	// -1 for names that are not available in the bound metadata
+	static int FindPosition(std::vector<std::string> const& names, std::string const& name);
+
+private:
+	mutable void const* m_boundMetadata = nullptr;
+	mutable unsigned int m_boundRun = 0;
+	mutable unsigned int m_boundLumi = 0;
+	mutable size_t m_nBoundNames = 0;
+};
+
+
+class TauDiscriminatorBinding : public KappaMetadataBinding
+{
+public:
+	/// equivalent to tau->getDiscriminator(GetName(handle), metadata)
+	inline float GetDiscriminator(KTau const* tau, size_t handle, KTauMetadata const* metadata, KEventInfo const* eventInfo) const
+	{
+		if (NeedsBinding(metadata, eventInfo))
+		{
+			Bind(metadata, eventInfo);
+		}
+		int floatIndex = m_floatIndices[handle];
+		if ((floatIndex >= 0) && (static_cast<size_t>(floatIndex) < tau->floatDiscriminators.size()))
+		{
+			return tau->floatDiscriminators[floatIndex];
+		}
+		else if ((floatIndex < 0) && (m_binaryBits[handle] >= 0))
+		{
+			return ((tau->binaryDiscriminators & (1ull << m_binaryBits[handle])) != 0);
+		}
+		return tau->getDiscriminator(m_names[handle], metadata);
+	}
+
+private:
+	void Bind(KTauMetadata const* metadata, KEventInfo const* eventInfo) const;
+
+	mutable std::vector<int> m_floatIndices;
+	mutable std::vector<int> m_binaryBits;
+};
+
+
+class ElectronIdBinding : public KappaMetadataBinding
+{
+public:
+	/// equivalent to electron->getId(GetName(handle), metadata)
+	inline float GetId(KElectron const* electron, size_t handle, KElectronMetadata const* metadata, KEventInfo const* eventInfo) const
+	{
+		if (NeedsBinding(metadata, eventInfo))
+		{
+			Bind(metadata, eventInfo);
+		}
+		int index = m_indices[handle];
+		if ((index >= 0) && (static_cast<size_t>(index) < electron->electronIds.size()))
+		{
+			return electron->electronIds[index];
+		}
+		return electron->getId(m_names[handle], metadata);
+	}
+
+private:
+	void Bind(KElectronMetadata const* metadata, KEventInfo const* eventInfo) const;
+
+	mutable std::vector<int> m_indices;
+};
+
+
+class JetTagBinding : public KappaMetadataBinding
+{
+public:
+	/// equivalent to jet->getTag(GetName(handle), metadata)
+	inline float GetTag(KJet const* jet, size_t handle, KJetMetadata const* metadata, KEventInfo const* eventInfo) const
+	{
+		if (NeedsBinding(metadata, eventInfo))
+		{
+			Bind(metadata, eventInfo);
+		}
+		int index = m_indices[handle];
+		if ((index >= 0) && (static_cast<size_t>(index) < jet->tags.size()))
+		{
+			return jet->tags[index];
+		}
+		return jet->getTag(m_names[handle], metadata);
+	}
+
+private:
+	void Bind(KJetMetadata const* metadata, KEventInfo const* eventInfo) const;
+
+	mutable std::vector<int> m_indices;
+};
+
@@ -0,0 +1,99 @@
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+
+/**
+   \brief Legs of the lepton pair chosen by the decay channel producers, together with their orderings.
+
+   The legs are stored once in the order in which they are chosen (two legs, three for ttH),
+   together with the information derived from them per event (original lepton before corrections
+   and gen matching). The pt, flavour and charge orderings are permutations of the leg indices,
+   such that the ordered collections of the product and all quantities can be derived by index
+   without further lookups in the maps of the product.
+*/
+class LeptonPairDescriptor
+{
+public:
+	static const size_t maxLegs = 3;
+
+	enum class Ordering : int
+	{
+		PT      = 0, // highest pt first
+		FLAVOUR = 1, // according to channel definition
+		CHARGE  = 2  // positive charges first
+	};
+	static const size_t nOrderings = 3;
+
+	struct Leg
+	{
+		KLepton* lepton = nullptr;
+		KLepton* originalLepton = nullptr;
+		// matched via the original lepton
+		KGenParticle* genParticle = nullptr;
+		RMFLV* genVisibleLV = nullptr;
+		// entry of the lepton in m_genTauMatchedLeptons
+		bool genTauMatched = false;
+		KGenTau* genTau = nullptr;
+	};
+
+	void Clear() { m_nLegs = 0; }
+
+	/// resets the orderings to the order of the legs
+	void AddLeg(KLepton* lepton)
+	{
+		if (m_nLegs >= maxLegs)
+		{
+			throw std::out_of_range("LeptonPairDescriptor: more than " + std::to_string(maxLegs) + " legs added");
+		}
+		m_legs[m_nLegs] = Leg();
+		m_legs[m_nLegs].lepton = lepton;
+		++m_nLegs;
+		for (size_t ordering = 0; ordering < nOrderings; ++ordering)
+		{
+			for (size_t position = 0; position < m_nLegs; ++position)
+			{
+				m_permutations[ordering][position] = position;
+			}
+		}
+	}
+
+	size_t GetNLegs() const { return m_nLegs; }
+
+	Leg& GetLeg(size_t legIndex) { CheckLegIndex(legIndex); return m_legs[legIndex]; }
+	Leg const& GetLeg(size_t legIndex) const { CheckLegIndex(legIndex); return m_legs[legIndex]; }
+
+	/// leg at the given position in the ordering
+	Leg const& GetLeg(Ordering ordering, size_t position) const
+	{
+		CheckLegIndex(position);
+		return m_legs[m_permutations[static_cast<int>(ordering)][position]];
+	}
+
+	size_t* GetPermutation(Ordering ordering) { return m_permutations[static_cast<int>(ordering)]; }
+	void SetPermutation(Ordering ordering, size_t firstLeg, size_t secondLeg)
+	{
+		m_permutations[static_cast<int>(ordering)][0] = firstLeg;
+		m_permutations[static_cast<int>(ordering)][1] = secondLeg;
+	}
+
+private:
+	// bounds checked like the vectors of ordered leptons these accessors replace
+	void CheckLegIndex(size_t legIndex) const
+	{
+		if (legIndex >= m_nLegs)
+		{
+			throw std::out_of_range("LeptonPairDescriptor: leg " + std::to_string(legIndex) + " requested, but only "
+			                        + std::to_string(m_nLegs) + " legs are set");
+		}
+	}
+
+	Leg m_legs[maxLegs];
+	size_t m_permutations[nOrderings][maxLegs];
+	size_t m_nLegs = 0;
+};
+
@@ -6,14 +6,16 @@
 #include <TH2.h>
 #include <TF1.h>
 #include <TString.h>
-#include <TRandom.h>
 #include <TMath.h>
 #include <assert.h>
 
+#include <string>
+#include <vector>
+
 class MEtSys {
   
  public:
-  MEtSys(TString fileName);
+  MEtSys(TString fileName, TString snapshotDirectory="");
   ~MEtSys(){};
 
   void ApplyMEtSys(float metPx,
@@ -67,35 +69,64 @@ class MEtSys {
 			  float & metShiftPx,
 			  float & metShiftPy);
 
+  // all response/resolution up/down variants at once, sharing the projection onto the boson axis
+  // and the response lookup, indexed by [SysType (Response, Resolution)][SysShift (Up, Down)]
+  void ApplyAllMEtSys(float metPx,
+		      float metPy,
+		      float genVPx,
+		      float genVPy,
+		      float visVPx,
+		      float visVPy,
+		      int njets,
+		      int bkgdType,
+		      float metShiftPx[2][2],
+		      float metShiftPy[2][2]) const;
+
   enum ProcessType{BOSON=0, EWK=1, TOP=2};
   enum SysType{NoType=-1, Response=0, Resolution=1};
   enum SysShift{NoShift=-1, Up=0, Down=1};
 
  private:
 
+  // unit vectors parallel and perpendicular to the boson direction in the transverse plane
+  struct RecoilAxes {
+    float unitX;
+    float unitY;
+    float unitPerpX;
+    float unitPerpY;
+  };
+
+  RecoilAxes ComputeRecoilAxes(float genVPx,
+			       float genVPy) const;
+
   void ComputeHadRecoilFromMet(float metX,
 			       float metY,
-			       float genVPx, 
-			       float genVPy,
+			       RecoilAxes const& axes,
 			       float visVPx,
 			       float visVPy,
 			       float & Hparal,
-			       float & Hperp);
+			       float & Hperp) const;
 
 
   void ComputeMetFromHadRecoil(float Hparal,
 			       float Hperp,
-			       float genVPx, 
-			       float genVPy,
+			       RecoilAxes const& axes,
 			       float visVPx,
 			       float visVPy,
 			       float & metX,
-			       float & metY);
+			       float & metY) const;
   
+  // returns the jet bin
+  int CheckInputs(int njets, int bkgdType, std::string const& caller) const;
+
+  void SetResponseTable(int bkgdType, int jetBin, TH1D const* hist);
+  double InterpolateResponse(int bkgdType, int jetBin, double genVPt) const;
   
   int nBkgdTypes;
   int nJetBins;
-  TH1D * responseHist[3][5];
+  // response histograms converted into bin centers and contents, index: bkgdType*nJetBins+jetBin
+  std::vector<std::vector<double> > responseBinCenters;
+  std::vector<std::vector<double> > responseValues;
   float sysUnc[3][2][3]; // first  index : bkgd type 
   // second index : type of uncertainty 0=response, 1=resolution
   // third index  : jet multiplicity bin (0,1,2);
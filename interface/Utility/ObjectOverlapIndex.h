@@ -0,0 +1,63 @@
+
+#pragma once
+
+#include <vector>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+
+/**
+   \brief Per-event index of reference objects for overlap removal and identity matching.
+
+   The reference objects (e.g. the valid leptons) are added once per event. Queries for other
+   objects (e.g. taus, jets or loose leptons) then do not loop over all references:
+   - Overlaps searches only the references within the DeltaR cone in eta (binary search in the
+     references sorted by eta) and compares squared DeltaR values.
+   - IsIdentical matches by the address of the object (or of its original object before
+     corrections) and falls back to the equality of the four-vectors, which is searched for
+     among the references with the same eta.
+
+   The references are sorted lazily with the first query after adding references.
+*/
+class ObjectOverlapIndex
+{
+public:
+	void Clear();
+
+	/// identity is the address of the object, nullptr if the object should only match by its four-vector
+	void Add(RMFLV const& p4, void const* identity = nullptr);
+	/// additional address the references can be matched with, e.g. that of the uncorrected object
+	void AddIdentity(void const* identity);
+
+	template<class TObject>
+	void AddAll(std::vector<TObject*> const& objects)
+	{
+		for (TObject const* object : objects)
+		{
+			Add(object->p4, object);
+		}
+	}
+
+	bool IsEmpty() const { return m_references.empty(); }
+
+	/// equivalent to DeltaR(p4, reference) <= maxDeltaR for any of the references, false for negative cuts
+	bool Overlaps(RMFLV const& p4, float maxDeltaR) const;
+
+	/// true if identity has been added or any of the references has the same four-vector
+	bool IsIdentical(RMFLV const& p4, void const* identity) const;
+
+private:
+	struct Reference
+	{
+		float eta;
+		float phi;
+		RMFLV p4;
+	};
+
+	void Sort() const;
+
+	mutable std::vector<Reference> m_references;
+	mutable std::vector<void const*> m_identities;
+	mutable bool m_sorted = true;
+};
+
@@ -5,7 +5,6 @@
 #include <TH1.h>
 #include <TF1.h>
 #include <TString.h>
-#include <TRandom.h>
 #include <TMath.h>
 #include <assert.h>
 
@@ -0,0 +1,69 @@
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "RooWorkspace.h"
+#include "RooFunctor.h"
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+
+/**
+   \brief Functions of a RooWorkspace that share the same list of arguments.
+
+   The functors and the roles of their arguments are created once (usually in Init) from the
+   comma-separated names of the workspace variables, e.g. "m_pt,m_eta". Per event, the arguments
+   are written into a buffer owned by the set, either for all arguments with a given role or for
+   all lepton related roles at once, and the functions are evaluated on this buffer one by one
+   or all together with EvalMany. No allocations are needed per event.
+
+   The argument buffer is mutable such that the sets can be used in the const Produce functions.
+*/
+class RooFunctorSet
+{
+public:
+	enum class ArgumentRole : int
+	{
+		NONE                      = -1,
+		LEPTON_PT                 = 0,
+		LEPTON_ETA                = 1,
+		ELECTRON_SUPERCLUSTER_ETA = 2,
+		LEPTON_ISOLATION_OVER_PT  = 3,
+		TAU_DECAY_MODE            = 4,
+		GEN_BOSON_MASS            = 5,
+		GEN_BOSON_PT              = 6
+	};
+	/// roles of the workspace variable names used in our workspaces, NONE for unknown names
+	static ArgumentRole ToArgumentRole(std::string const& argumentName);
+
+	RooFunctorSet() = default;
+
+	void Init(RooWorkspace* workspace, std::vector<std::string> const& functionNames, std::string const& argumentNames);
+
+	size_t GetNFunctions() const { return m_functors.size(); }
+	std::string const& GetFunctionName(size_t function) const { return m_functionNames[function]; }
+	size_t GetNArguments() const { return m_arguments.size(); }
+	bool HasArgument(ArgumentRole role) const;
+
+	/// sets all arguments with the given role
+	void SetArgument(ArgumentRole role, double value) const;
+	/// sets all lepton related arguments, arguments with other roles are left unchanged
+	void SetLeptonArguments(KLepton const* lepton, double isolationOverPt) const;
+
+	inline double Eval(size_t function) const
+	{
+		return m_functors[function]->eval(m_arguments.data());
+	}
+	/// evaluates all functions, results needs to have space for GetNFunctions() values
+	void EvalMany(double* results) const;
+
+private:
+	std::vector<std::string> m_functionNames;
+	std::vector<std::unique_ptr<RooFunctor> > m_functors;
+	std::vector<ArgumentRole> m_roles;
+	mutable std::vector<double> m_arguments;
+};
+
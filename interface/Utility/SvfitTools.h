@@ -3,7 +3,10 @@
 
 #include "Artus/Utility/interface/ArtusLogging.h"
 
+#include <list>
 #include <map>
+#include <memory>
+#include <set>
 
 #include <TChain.h>
 #include <TMemFile.h>
@@ -27,11 +30,23 @@ class TauSVfitQuantity : public classic_svFit::SVfitQuantity
 {
 
 public:
-	TauSVfitQuantity(size_t tauIndex);
+	TauSVfitQuantity(size_t tauIndex, std::string const& quantityLabel);
+
+	/// takes over the histogram of the previous integration, such that booking the histograms for
+	/// the next integration does not delete it and createHistogram can reset and return it
+	void ReleaseHistogram();
 
 protected:
+	/// histogram of the previous integration after a reset, if it was created with the same range, otherwise nullptr
+	TH1* GetResetHistogram(double xMin, double xMax) const;
+
 	size_t m_tauIndex;
-	std::string m_tauLabel;
+	std::string m_histogramName;
+
+private:
+	mutable std::unique_ptr<TH1> m_releasedHistogram;
+	mutable double m_histogramXMin = 0.0;
+	mutable double m_histogramXMax = 0.0;
 };
 
 class TauESVfitQuantity : public TauSVfitQuantity
@@ -80,6 +95,10 @@ class MCTauTauQuantitiesAdapter : public classic_svFit::DiTauSystemHistogramAdap
 public:
 	MCTauTauQuantitiesAdapter();
 
+	/// to be called before each integration, the histograms of the tau quantities are reused if their
+	/// range does not change, the histograms of the di-tau quantities are booked again by ClassicSVfit
+	void ReleaseHistograms();
+
 	RMFLV GetFittedHiggsLV() const;
 	
 	float GetFittedTau1ERatio() const;
@@ -101,12 +120,14 @@ public:
 		MARKOV_CHAIN = 0,
 		VEGAS = 1,
 		FIT = 2,
+		COLLINEAR = 3, // fast estimate without integration, see SvfitResults::SetCollinearEstimate
 	};
 	static IntegrationMethod ToIntegrationMethod(std::string const& integrationMethod)
 	{
 		if (integrationMethod == "markovchain") return IntegrationMethod::MARKOV_CHAIN;
 		else if (integrationMethod == "vegas") return IntegrationMethod::VEGAS;
 		else if (integrationMethod == "fit") return IntegrationMethod::FIT;
+		else if (integrationMethod == "collinear") return IntegrationMethod::COLLINEAR;
 		else return IntegrationMethod::NONE;
 	}
 	
@@ -132,10 +153,6 @@ public:
 	HttEnumTypes::SystematicShift GetSystematicShift() const;
 	IntegrationMethod GetIntegrationMethod() const;
 	
-	void CreateBranches(TTree* tree);
-	void SetBranchAddresses(TTree* tree);
-	void ActivateBranches(TTree* tree, bool activate=true);
-	
 	bool operator<(SvfitEventKey const& rhs) const;
 	bool operator==(SvfitEventKey const& rhs) const;
 	bool operator!=(SvfitEventKey const& rhs) const;
@@ -149,15 +166,16 @@ std::ostream& operator<<(std::ostream& os, SvfitEventKey const& svfitEventKey);
 
 
 /**
+   \brief Inputs of the SVfit calculation, the branches of cache trees are handled by SvfitCacheBranches.
  */
 class SvfitInputs {
 
 public:
-	RMFLV* leptonMomentum1 = 0;
-	RMFLV* leptonMomentum2 = 0;
+	RMFLV leptonMomentum1;
+	RMFLV leptonMomentum2;
 	
-	RMDataV* metMomentum = 0;
-	RMSM2x2* metCovariance = 0;
+	RMDataV metMomentum;
+	RMSM2x2 metCovariance;
 
 	int decayMode1 = 0;
 	int decayMode2 = 0;
@@ -166,55 +184,81 @@ public:
 	SvfitInputs(RMFLV const& leptonMomentum1, RMFLV const& leptonMomentum2,
 	            RMDataV const& metMomentum, RMSM2x2 const& metCovariance,
 	            int const& decayMode1, int const& decayMode2);
-	~SvfitInputs();
 	
 	void Set(RMFLV const& leptonMomentum1, RMFLV const& leptonMomentum2,
 	         RMDataV const& metMomentum, RMSM2x2 const& metCovariance,
 	         int const& decayMode1, int const& decayMode2);
 	
-	void CreateBranches(TTree* tree);
-	void SetBranchAddresses(TTree* tree);
-	void ActivateBranches(TTree* tree, bool activate=true);
-	
 	bool operator==(SvfitInputs const& rhs) const;
 	bool operator!=(SvfitInputs const& rhs) const;
 	
-	ClassicSVfit GetSvfitAlgorithm(int verbosity, SvfitEventKey const& svfitEventKey, bool addLogM) const;
+	/// hash of all values entering the SVfit calculation
+	ULong64_t GetHash() const;
+	
+	/// sets the options of the algorithm that depend on the event, such that the algorithm can be reused for all events
+	void ConfigureSvfitAlgorithm(ClassicSVfit& svfitAlgorithm, SvfitEventKey const& svfitEventKey, bool addLogM) const;
 	std::vector<classic_svFit::MeasuredTauLepton> GetMeasuredTauLeptons(SvfitEventKey const& svfitEventKey) const;
 	TMatrixD GetMetCovarianceMatrix() const;
 };
 
 
 /**
+   \brief Key of SVfit results by the content of the calculation.
+
+   In contrast to SvfitEventKey, the systematic shift and the lepton identities are not part of
+   the key, but the hash of the inputs is. Results for shifts that leave the inputs unchanged
+   (e.g. weight-only shifts or jet shifts) therefore share the same key.
+*/
+class SvfitContentKey {
+
+public:
+	ULong64_t runLumiEvent = 0;
+	int decayType1 = 0;
+	int decayType2 = 0;
+	int integrationMethod = 0;
+	ULong64_t inputsHash = 0;
+	
+	SvfitContentKey() {};
+	SvfitContentKey(SvfitEventKey const& svfitEventKey, SvfitInputs const& svfitInputs);
+	
+	bool operator<(SvfitContentKey const& rhs) const;
+};
+
+
+/**
+   \brief Results of the SVfit calculation, the branches of cache trees are handled by SvfitCacheBranches.
  */
 class SvfitResults {
 
 public:
-	double fittedTransverseMass;
-	RMFLV* fittedHiggsLV = nullptr;
-	float fittedTau1ERatio;
-	RMFLV* fittedTau1LV = nullptr;
-	float fittedTau2ERatio;
-	RMFLV* fittedTau2LV = nullptr;
+	double fittedTransverseMass = 0.0;
+	RMFLV fittedHiggsLV;
+	float fittedTau1ERatio = 0.0;
+	RMFLV fittedTau1LV;
+	float fittedTau2ERatio = 0.0;
+	RMFLV fittedTau2LV;
+	
+	// false as long as no results have been set
+	bool available = false;
 	
 	SvfitResults() {};
 	SvfitResults(double fittedTransverseMass, RMFLV const& fittedHiggsLV, float fittedTau1ERatio, RMFLV const& fittedTau1LV, float fittedTau2ERatio, RMFLV const& fittedTau2LV);
 	SvfitResults(ClassicSVfit const& svfitAlgorithm);
-	~SvfitResults();
 	
 	void Set(double fittedTransverseMass, RMFLV const& fittedHiggsLV, float fittedTau1ERatio, RMFLV const& fittedTau1LV, float fittedTau2ERatio, RMFLV const& fittedTau2LV);
 	void Set(ClassicSVfit const& svfitAlgorithm);
-	inline void FromRecalculation() { recalculated = true; }
-	inline void FromCache() { recalculated = false; }
-	
-	void CreateBranches(TTree* tree);
-	void SetBranchAddresses(TTree* tree);
-	void ActivateBranches(TTree* tree, bool activate=true);
+	void SetCollinearEstimate(SvfitInputs const& svfitInputs);
+	inline void FromRecalculation() { recalculated = true; fastEstimate = false; }
+	inline void FromCache() { recalculated = false; fastEstimate = false; }
+	inline void FromFastEstimate() { recalculated = false; fastEstimate = true; }
 	
 	bool operator==(SvfitResults const& rhs) const;
 	bool operator!=(SvfitResults const& rhs) const;
 	
-	bool recalculated;
+	bool recalculated = false;
+	
+	// results of the fast estimator (integration method COLLINEAR), never written to or read from caches
+	bool fastEstimate = false;
 
 private:
 	double GetFittedTransverseMass(ClassicSVfit const& svfitAlgorithm) const;
@@ -226,6 +270,49 @@ private:
 };
 
 
+/**
+   \brief Binding of the event key, inputs and results to the branches of SVfit cache trees.
+
+   TTree::Branch and TTree::SetBranchAddress need the addresses of pointers to the objects stored
+   in the trees. These pointers are owned by this class and point to its own event key, inputs and
+   results, such that ROOT reads and writes these values in place and SvfitInputs and SvfitResults
+   can be plain values. Instances can therefore be neither copied nor moved while bound to a tree.
+*/
+class SvfitCacheBranches {
+
+public:
+	SvfitEventKey svfitEventKey;
+	SvfitInputs svfitInputs;
+	SvfitResults svfitResults;
+	
+	SvfitCacheBranches();
+	SvfitCacheBranches(SvfitCacheBranches const&) = delete;
+	SvfitCacheBranches& operator=(SvfitCacheBranches const&) = delete;
+	
+	/// copies the values to be written with the next call of TTree::Fill
+	void Set(SvfitEventKey const& svfitEventKey, SvfitInputs const& svfitInputs, SvfitResults const& svfitResults);
+	
+	void CreateBranches(TTree* tree, bool withInputs=true);
+	/// binds all branches present in the tree and activates them
+	void SetBranchAddresses(TTree* tree);
+	/// binds only the results branches and deactivates all others, such that reading entries of cache trees only reads the results
+	void SetResultsBranchAddresses(TTree* tree);
+	
+	void ActivateEventKeyBranches(TTree* tree, bool activate=true);
+	void ActivateInputsBranches(TTree* tree, bool activate=true);
+	void ActivateResultsBranches(TTree* tree, bool activate=true);
+
+private:
+	RMFLV* leptonMomentum1;
+	RMFLV* leptonMomentum2;
+	RMDataV* metMomentum;
+	RMSM2x2* metCovariance;
+	RMFLV* fittedHiggsLV;
+	RMFLV* fittedTau1LV;
+	RMFLV* fittedTau2LV;
+};
+
+
 /**
  */
 class SvfitTools {
@@ -235,20 +322,48 @@ public:
 	~SvfitTools();
 	
 	void Init(std::string const& cacheFileName, std::string const& cacheTreeName);
-	SvfitResults GetResults(SvfitEventKey const& svfitEventKey, SvfitInputs const& svfitInputs,
-	                        bool& neededRecalculation, HttEnumTypes::SvfitCacheMissBehaviour svfitCacheMissBehaviour);
+	/// requested size of the in-job cache shared by all instances, 0 disables it for this instance,
+	/// the shared cache holds as many entries as the largest requested size
+	void SetInJobCacheSize(size_t inJobCacheSize);
+	SvfitResults const& GetResults(SvfitEventKey const& svfitEventKey, SvfitInputs const& svfitInputs,
+	                               bool& neededRecalculation, HttEnumTypes::SvfitCacheMissBehaviour svfitCacheMissBehaviour);
 	//TFile * m_visPtResolutionFile = nullptr;
 
 private:
 	static std::map<std::string, TFile*> svfitCacheInputFiles;
 	static std::map<std::string, TTree*> svfitCacheInputTrees;
 	static std::map<std::string, std::map<SvfitEventKey, uint64_t> > svfitCacheInputTreeIndices;
+	// fallback index of the entries of all loaded cache trees by the content of the calculation,
+	// built on the first lookup that needs it, trees with inputs branches that are not indexed yet
+	static std::map<SvfitContentKey, std::pair<TTree*, uint64_t> > svfitCacheInputContentIndices;
+	static std::set<TTree*> svfitCacheInputUnindexedTrees;
+	// branches the addresses of the cache trees currently point to
+	static std::map<TTree*, SvfitCacheBranches*> svfitCacheInputTreeBranchAddresses;
+	
+	// in-job cache of results, least recently used entries are removed first
+	struct InJobCacheEntry
+	{
+		SvfitContentKey contentKey;
+		SvfitResults svfitResults;
+	};
+	static size_t inJobCacheCapacity;
+	static std::list<InJobCacheEntry> inJobCache;
+	static std::map<SvfitContentKey, std::list<InJobCacheEntry>::iterator> inJobCacheIndex;
+	
+	void IndexCacheContents();
+	void ReadCacheEntry(TTree* svfitCacheInputTree, uint64_t svfitCacheInputTreeIndex);
+	ClassicSVfit& GetSvfitAlgorithm();
+	bool ReadInJobCache(SvfitContentKey const& contentKey);
+	void WriteInJobCache(SvfitContentKey const& contentKey);
 	
 	std::string cacheFileName;
 	std::string cacheFileTreeName;
+	size_t inJobCacheSize = 0;
 	
-	SvfitEventKey svfitEventKey;
-	SvfitInputs svfitInputs;
+	SvfitCacheBranches svfitCacheBranches;
 	SvfitResults svfitResults;
+	
+	// created with the first integration and reused for all following ones, owns its histogram adapter
+	std::unique_ptr<ClassicSVfit> svfitAlgorithm;
 };
 
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+/**
+   \brief Dense monotone lookup table for a quantile mapping x -> y within [xMin, xMax].
+
+   The table is built once from the exact mapping, starting from an equidistant grid that is
+   refined by bisection wherever linear interpolation at the interval midpoint deviates from
+   the exact mapping by more than the tolerance. Evaluations are a binary search plus linear
+   interpolation. Values outside of the tabulated range are passed to the exact mapping.
+*/
+class TabulatedQuantileShifter
+{
+public:
+	typedef std::function<double(double)> mapping_function;
+
+	TabulatedQuantileShifter() = default;
+
+	void Build(mapping_function const& mapping, double xMin, double xMax,
+	           size_t nInitialPoints, size_t nMaxPoints, double tolerance);
+
+	bool IsBuilt() const { return (m_x.size() > 1); }
+	bool InRange(double x) const { return IsBuilt() && (x >= m_x.front()) && (x <= m_x.back()); }
+
+	// requires InRange(x)
+	double Shift(double x) const;
+
+	size_t GetNPoints() const { return m_x.size(); }
+	// maximal deviation from the exact mapping found at the interval midpoints after the last refinement
+	double GetMaxDeviation() const { return m_maxDeviation; }
+	// true if the tabulated y values are non-decreasing in x
+	bool IsMonotone() const { return m_monotone; }
+
+private:
+	std::vector<double> m_x;
+	std::vector<double> m_y;
+	double m_maxDeviation = 0.0;
+	bool m_monotone = true;
+};
+
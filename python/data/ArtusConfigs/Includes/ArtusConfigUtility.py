@@ -16,4 +16,31 @@ def apply_uncertainty_shift_configs(configname, config, systs):
     longkey = configname + "_" + key
     config_with_systs[longkey] = jsonTools.JsonDict(syst)
     config_with_systs[longkey] += config
-  return config_with_systs
\ No newline at end of file
+  return config_with_systs
+
+def share_common_processor_prefix(configname, pipelines):
+  """
+  Moves the processors at the beginning of each pipeline that are identical in at least one other pipeline
+  into the SharedPrefixProducer. Which of them are actually shared between which pipelines is decided by the
+  SharedPrefixProducer from the settings declared by the processors, such that every group of pipelines with
+  identical processors and settings runs its longest common prefix only once per event.
+  """
+  processor_lists = dict([(name, pipeline.get("Processors", [])) for name, pipeline in pipelines.items()])
+  for name, pipeline in pipelines.items():
+    processors = processor_lists[name]
+    prefix_length = 0
+    for other_name, other_processors in processor_lists.items():
+      if other_name == name:
+        continue
+      common_length = 0
+      while (common_length < min(len(processors), len(other_processors))) and (processors[common_length] == other_processors[common_length]):
+        common_length += 1
+      prefix_length = max(prefix_length, common_length)
+    
+    if prefix_length == 0:
+      continue
+    
+    log.debug("Share processors {prefix} of the {configname} pipeline {name} with other pipelines.".format(prefix=processors[:prefix_length], configname=configname, name=name))
+    pipeline["SharedPrefixProcessors"] = processors[:prefix_length]
+    pipeline["Processors"] = ["producer:SharedPrefixProducer", "filter:SharedPrefixFilter"] + processors[prefix_length:]
+  return pipelines
@@ -38,6 +38,7 @@ def build_config(nickname):
   # SvfitProducer config
   config["SvfitCacheMissBehaviour"] = "recalculate" # Action if SVFit cache is not found. Choose between 'assert': job fails 'undefined': neither runs SVFit nor fails (used when filling SVFit Caches offline) 'recalculate': run SVFit regularly
   config["SvfitIntegrationMethod"] = "MarkovChain"
+  config["SvfitInJobCacheSize"] = 100		# number of SVfit results kept in memory, shared by pipelines with identical SVfit inputs (e.g. weight-only shifts)
   
   SvfitCacheFiles = {
       "DY1JetsToLLM50_RunIISummer16MiniAODv2_PUMoriond17_13TeV_MINIAOD_madgraph-pythia8" : "root://cmsxrootd-1.gridka.de:1094///store/user/swozniew/Svfit/2018-02-07/DY1JetsToLLM50_RunIISummer16MiniAODv2_PUMoriond17_13TeV_MINIAOD_madgraph-pythia8.root",
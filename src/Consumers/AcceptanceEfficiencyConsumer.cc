@@ -10,6 +10,8 @@ void AcceptanceEfficiencyConsumer::Init(setting_type const& settings)
 	acc_eff_hist = new TH2D("acc_eff_hist", "acc_eff_hist", 40,0.,200.,40,0.,200);
 	number_of_passed_hist = new TH2D("number_of_passed_hist", "number_of_passed_hist", 40,0.,200.,40,0.,200);
 	number_of_entries_hist = new TH2D("number_of_entries_hist", "number_of_entries_hist", 40,0.,200.,40,0.,200);
+	number_of_passed_hist->Sumw2();
+	number_of_entries_hist->Sumw2();
 	
 	PtTau1_hist = new TH1D("PtTau1_hist", "PtTau1_hist", 50,0.,200.);
 	PtTau2_hist = new TH1D("PtTau2_hist", "PtTau2_hist", 50,0.,200.);
@@ -28,8 +30,8 @@ void AcceptanceEfficiencyConsumer::Init(setting_type const& settings)
 void AcceptanceEfficiencyConsumer::ProcessFilteredEvent(event_type const& event, product_type const& product, setting_type const& settings)
 {
 	assert(event.m_genTaus->size() == 2);
-	KGenTau leadingTau = event.m_genTaus->at(0);
-	KGenTau trailingTau = event.m_genTaus->at(1);
+	KGenTau const& leadingTau = event.m_genTaus->at(0);
+	KGenTau const& trailingTau = event.m_genTaus->at(1);
 
 	double PtTau1 = leadingTau.p4.Pt();
 	double PtTau2 = trailingTau.p4.Pt();
@@ -51,11 +53,10 @@ void AcceptanceEfficiencyConsumer::ProcessFilteredEvent(event_type const& event,
 		PtVis2 = leadingTau.visible.p4.Pt();
 	}
 
-	for(unsigned int i = 0; i<nAttempts; ++i)
-	{
-		if ((double(i)/double(nAttempts) < weight) && (weight <=1)) number_of_passed_hist->Fill(PtTau1, PtTau2);
-		number_of_entries_hist->Fill(PtTau1, PtTau2);
-	}
+	// the weight is the probability of the event to be accepted
+	double acceptanceProbability = ((weight > 0.0) && (weight <= 1.0)) ? weight : 0.0;
+	number_of_passed_hist->Fill(PtTau1, PtTau2, acceptanceProbability);
+	number_of_entries_hist->Fill(PtTau1, PtTau2);
 	
 	PtTau1_hist->Fill(PtTau1);
 	PtTau2_hist->Fill(PtTau2);
@@ -76,6 +77,12 @@ void AcceptanceEfficiencyConsumer::Finish(setting_type const& settings)
 	number_of_entries_hist->Write();
 	acc_eff_hist->Write();
 	
+	TEfficiency acceptanceEfficiency(*number_of_passed_hist, *number_of_entries_hist);
+	acceptanceEfficiency.SetName("acc_eff");
+	acceptanceEfficiency.SetTitle("acc_eff;p_{T}(#tau_{1}) [GeV];p_{T}(#tau_{2}) [GeV]");
+	acceptanceEfficiency.SetStatisticOption(TEfficiency::kBJeffrey);
+	acceptanceEfficiency.Write();
+	
 	PtTau1_hist->Write();
 	PtTau2_hist->Write();
 	
@@ -25,6 +25,10 @@ void BTagEffConsumer::Init(setting_type const& settings)
 	m_BTaggingEff_Num_b  = new TH2D("bTaggingEff_Num_b", ";p_{T} [GeV];#eta", ptNBins-1, ptBins, etaNBins-1, etaBins);
 	m_BTaggingEff_Num_c  = new TH2D("bTaggingEff_Num_c", ";p_{T} [GeV];#eta", ptNBins-1, ptBins, etaNBins-1, etaBins);
 	m_BTaggingEff_Num_udsg  = new TH2D("bTaggingEff_Num_udsg", ";p_{T} [GeV];#eta", ptNBins-1, ptBins, etaNBins-1, etaBins);
+
+	std::map<std::string, std::vector<float>> bTagWorkingPoints = Utility::ParseMapTypes<std::string,float>(Utility::ParseVectorToMap(settings.GetBTaggerWorkingPoints()));
+	m_bTaggingWorkingPoint = bTagWorkingPoints.at(settings.GetBTagWPs().at(0)).at(0);
+	m_combinedSecondaryVertexHandle = m_jetTagBinding.Register(settings.GetBTaggedJetCombinedSecondaryVertexName());
 }
 
 //void ValidBTaggedJetsProducer::Produce(KappaEvent const& event, KappaProduct& product,
@@ -37,12 +41,11 @@ void BTagEffConsumer::ProcessFilteredEvent(event_type const& event, product_type
 
   //for(std::vector<KMuon*>::const_iterator validMuon = product.m_validMuons.begin();validMuon!=product.m_validMuons.end();++validMuon)
   //for (std::vector<KBasicJet*>::cons_iterator jet = product.m_validJets.begin(); jet != product.m_validJets.end(); ++jet)
-  std::map<std::string, std::vector<float>> bTagWorkingPoints = Utility::ParseMapTypes<std::string,float>(Utility::ParseVectorToMap(settings.GetBTaggerWorkingPoints()));
-  float bTaggingWorkingPoint = bTagWorkingPoints.at(settings.GetBTagWPs().at(0)).at(0);
+  float bTaggingWorkingPoint = m_bTaggingWorkingPoint;
   for (auto jet = product.m_validJets.begin(); jet != product.m_validJets.end(); ++jet)
     {
       KJet* tjet = static_cast<KJet*>(*jet);
-      float combinedSecondaryVertex = tjet->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata);
+      float combinedSecondaryVertex = m_jetTagBinding.GetTag(tjet, m_combinedSecondaryVertexHandle, event.m_jetMetadata, event.m_eventInfo);
       
 	      int jetflavor = tjet->flavour;
 	      if(jetflavor==5){
@@ -1,4 +1,9 @@
+#include <cmath>
+#include <Math/VectorUtil.h>
+#include <TMath.h>
+
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Consumers/EmbeddingConsumer.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/CounterBasedRandom.h"
 
 
 void EmbeddingConsumer::Init(setting_type const& settings)
@@ -9,29 +14,28 @@ void EmbeddingConsumer::Init(setting_type const& settings)
 	nDeltaRBins = settings.GetDeltaRBinning();
 	DeltaRMax = settings.GetDeltaRMaximum();
 	randomMuon = settings.GetRandomMuon();
+	m_randomStreamId = CounterBasedRandom::GetStreamId(GetConsumerId());
+
+	m_ptFlowHistograms.assign(N_MUON_TYPES * N_PF_CLASSES * N_REGIONS, nullptr);
+	m_ptFlowSumOfWeights.assign(m_ptFlowHistograms.size() * nDeltaRBins, 0.0);
+	m_ptFlowSumOfSquaredWeights.assign(m_ptFlowHistograms.size() * nDeltaRBins, 0.0);
+	m_ptFlowEntries.assign(m_ptFlowHistograms.size(), 0);
+	m_ptFlowStats.assign(m_ptFlowHistograms.size() * 4, 0.0);
+
 	for(unsigned int i = 0;i<muonTypeVector.size();i++)
 	{
 		for(unsigned int j = 0; j < regionTypeVector.size();j++)
 		{
-			// PtFlow for charged hadrons (from first PV)
-			TString histname = muonTypeVector[i] + TString("Muon_ChargedFromFirstPVPtFlow_") +  regionTypeVector[j];
-			Muon_ChargedFromFirstPVPtFlow[(const char*) muonTypeVector[i]][(const char*) regionTypeVector[j]] = new TH1F((const char*) histname, (const char*) histname, nDeltaRBins, 0., DeltaRMax);
-			histograms.push_back(Muon_ChargedFromFirstPVPtFlow[(const char*) muonTypeVector[i]][(const char*) regionTypeVector[j]]);
-
-			// PtFlow for charged hadrons (not from first PV)
-			histname = muonTypeVector[i] + TString("Muon_ChargedNotFromFirstPVPtFlow_") +  regionTypeVector[j];
-			Muon_ChargedNotFromFirstPVPtFlow[(const char*) muonTypeVector[i]][(const char*) regionTypeVector[j]] = new TH1F((const char*) histname, (const char*) histname, nDeltaRBins, 0., DeltaRMax);
-			histograms.push_back(Muon_ChargedNotFromFirstPVPtFlow[(const char*) muonTypeVector[i]][(const char*) regionTypeVector[j]]);
-
-			// PtFlow for neutral hadrons (from first PV)
-			histname = muonTypeVector[i] + TString("Muon_NeutralFromFirstPVPtFlow_") +  regionTypeVector[j];
-			Muon_NeutralFromFirstPVPtFlow[(const char*) muonTypeVector[i]][(const char*) regionTypeVector[j]] = new TH1F((const char*) histname, (const char*) histname, nDeltaRBins, 0., DeltaRMax);
-			histograms.push_back(Muon_NeutralFromFirstPVPtFlow[(const char*) muonTypeVector[i]][(const char*) regionTypeVector[j]]);
-
-			// PtFlow for photons (from first PV)
-			histname = muonTypeVector[i] + TString("Muon_PhotonsFromFirstPVPtFlow_") +  regionTypeVector[j];
-			Muon_PhotonsFromFirstPVPtFlow[(const char*) muonTypeVector[i]][(const char*) regionTypeVector[j]] = new TH1F((const char*) histname, (const char*) histname, nDeltaRBins, 0., DeltaRMax);
-			histograms.push_back(Muon_PhotonsFromFirstPVPtFlow[(const char*) muonTypeVector[i]][(const char*) regionTypeVector[j]]);
+			// PtFlow for charged hadrons (from first PV), charged hadrons (not from first PV),
+			// neutral hadrons (from first PV) and photons (from first PV)
+			for(unsigned int k = 0; k < pfClassVector.size(); k++)
+			{
+				TString histname = muonTypeVector[i] + TString("Muon_") + pfClassVector[k] + TString("PtFlow_") + regionTypeVector[j];
+				TH1F* histogram = new TH1F((const char*) histname, (const char*) histname, nDeltaRBins, 0., DeltaRMax);
+				histogram->Sumw2();
+				m_ptFlowHistograms[GetHistogramIndex(MuonType(i), PfClass(k), Region(j))] = histogram;
+				histograms.push_back(histogram);
+			}
 		}
 	}
 }
@@ -40,54 +44,65 @@ void EmbeddingConsumer::Init(setting_type const& settings)
 void EmbeddingConsumer::ProcessFilteredEvent(event_type const& event, product_type const& product, setting_type const& settings)
 {
 	// Here is assumed, that validMuons are Pt ordered
-	Muon["leading"] = static_cast<KMuon*>(product.m_zLeptons.first);
-	Muon["trailing"] = static_cast<KMuon*>(product.m_zLeptons.second);
+	RMFLV const* muons[N_MUON_TYPES];
+	muons[LEADING] = &(product.m_zLeptons.first->p4);
+	muons[TRAILING] = &(product.m_zLeptons.second->p4);
 
 	if (product.m_zLeptons.first->charge() == +1)
 	{
-		Muon["positive"] = static_cast<KMuon*>(product.m_zLeptons.first);
-		Muon["negative"] = static_cast<KMuon*>(product.m_zLeptons.second);
+		muons[POSITIVE] = &(product.m_zLeptons.first->p4);
+		muons[NEGATIVE] = &(product.m_zLeptons.second->p4);
 	}
 	else
 	{
-		Muon["positive"] = static_cast<KMuon*>(product.m_zLeptons.second);
-		Muon["negative"] = static_cast<KMuon*>(product.m_zLeptons.first);	
+		muons[POSITIVE] = &(product.m_zLeptons.second->p4);
+		muons[NEGATIVE] = &(product.m_zLeptons.first->p4);
+	}
+
+	RMFLV randomMuonP4;
+	if (randomMuon)
+	{
+		CounterBasedRandom random(event.m_eventInfo, m_randomStreamId);
+		randomMuonP4.SetM(1.);
+		randomMuonP4.SetPt(1.);
+		double theta = random.Uniform(0,TMath::Pi());
+		randomMuonP4.SetEta(-TMath::Log(TMath::Tan(theta/2)));
+		randomMuonP4.SetPhi(random.Uniform(-TMath::Pi(),TMath::Pi()));
 	}
-	KMuon* rMuon = new KMuon();
-	rMuon->p4.SetM(1.);
-	rMuon->p4.SetPt(1.);
-	double theta = randomnumbergenerator->Uniform(0,TMath::Pi());
-	rMuon->p4.SetEta(-TMath::Log(TMath::Tan(theta/2)));
-	rMuon->p4.SetPhi(randomnumbergenerator->Uniform(-TMath::Pi(),TMath::Pi()));
+
+	Region massRegion = ((product.m_z.p4.M() < 100 && product.m_z.p4.M() > 80) ? PEAK : SIDEBAND);
+
 	// Filling histograms for all muons defined above
-	for(unsigned int i = 0;i<muonTypeVector.size();i++)
+	for(unsigned int i = 0; i < N_MUON_TYPES; i++)
 	{
-		std::string muontype = (const char*) muonTypeVector[i];
-		KMuon* muon = randomMuon ? rMuon : Muon[muontype];
+		MuonType muonType = MuonType(i);
+		RMFLV const& muonP4 = (randomMuon ? randomMuonP4 : *(muons[muonType]));
 
 		// Filling PtFlow histograms
-		EmbeddingConsumer::FillPtFlowHistogram(Muon_ChargedFromFirstPVPtFlow[muontype], product.m_pfChargedHadronsFromFirstPV, muon, "full");
-		if(product.m_z.p4.M() < 100 && product.m_z.p4.M() > 80) EmbeddingConsumer::FillPtFlowHistogram(Muon_ChargedFromFirstPVPtFlow[muontype], product.m_pfChargedHadronsFromFirstPV, muon, "peak");
-		else EmbeddingConsumer::FillPtFlowHistogram(Muon_ChargedFromFirstPVPtFlow[muontype], product.m_pfChargedHadronsFromFirstPV, muon, "sideband");
-		
-		EmbeddingConsumer::FillPtFlowHistogram(Muon_ChargedNotFromFirstPVPtFlow[muontype], product.m_pfChargedHadronsNotFromFirstPV, muon, "full");
-		if(product.m_z.p4.M() < 100 && product.m_z.p4.M() > 80) EmbeddingConsumer::FillPtFlowHistogram(Muon_ChargedNotFromFirstPVPtFlow[muontype], product.m_pfChargedHadronsNotFromFirstPV, muon, "peak");
-		else EmbeddingConsumer::FillPtFlowHistogram(Muon_ChargedNotFromFirstPVPtFlow[muontype], product.m_pfChargedHadronsNotFromFirstPV, muon, "sideband");
-		
-		EmbeddingConsumer::FillPtFlowHistogram(Muon_NeutralFromFirstPVPtFlow[muontype], product.m_pfNeutralHadronsFromFirstPV, muon, "full");
-		if(product.m_z.p4.M() < 100 && product.m_z.p4.M() > 80) EmbeddingConsumer::FillPtFlowHistogram(Muon_NeutralFromFirstPVPtFlow[muontype], product.m_pfNeutralHadronsFromFirstPV, muon, "peak");
-		else EmbeddingConsumer::FillPtFlowHistogram(Muon_NeutralFromFirstPVPtFlow[muontype], product.m_pfNeutralHadronsFromFirstPV, muon, "sideband");
-		
-		EmbeddingConsumer::FillPtFlowHistogram(Muon_PhotonsFromFirstPVPtFlow[muontype], product.m_pfPhotonsFromFirstPV, muon, "full");
-		if(product.m_z.p4.M() < 100 && product.m_z.p4.M() > 80) EmbeddingConsumer::FillPtFlowHistogram(Muon_PhotonsFromFirstPVPtFlow[muontype], product.m_pfPhotonsFromFirstPV, muon, "peak");
-		else EmbeddingConsumer::FillPtFlowHistogram(Muon_PhotonsFromFirstPVPtFlow[muontype], product.m_pfPhotonsFromFirstPV, muon, "sideband");
-
+		FillPtFlow(product.m_pfChargedHadronsFromFirstPV, muonP4, muonType, CHARGED_FROM_FIRST_PV, massRegion);
+		FillPtFlow(product.m_pfChargedHadronsNotFromFirstPV, muonP4, muonType, CHARGED_NOT_FROM_FIRST_PV, massRegion);
+		FillPtFlow(product.m_pfNeutralHadronsFromFirstPV, muonP4, muonType, NEUTRAL_FROM_FIRST_PV, massRegion);
+		FillPtFlow(product.m_pfPhotonsFromFirstPV, muonP4, muonType, PHOTONS_FROM_FIRST_PV, massRegion);
 	}
-
 }
 
 void EmbeddingConsumer::Finish(setting_type const& settings)
 {
+	// transfer the accumulated PtFlow into the histograms (bins 1..n, no under-/overflow is possible)
+	for (size_t histogramIndex = 0; histogramIndex < m_ptFlowHistograms.size(); ++histogramIndex)
+	{
+		TH1F* histogram = m_ptFlowHistograms[histogramIndex];
+		for (unsigned int deltaRBin = 0; deltaRBin < nDeltaRBins; ++deltaRBin)
+		{
+			size_t binIndex = histogramIndex * nDeltaRBins + deltaRBin;
+			histogram->SetBinContent(deltaRBin + 1, m_ptFlowSumOfWeights[binIndex]);
+			histogram->SetBinError(deltaRBin + 1, std::sqrt(m_ptFlowSumOfSquaredWeights[binIndex]));
+		}
+		// SetBinContent invalidates the statistics, restore the ones TH1::Fill would have accumulated
+		histogram->PutStats(&(m_ptFlowStats[histogramIndex * 4]));
+		histogram->SetEntries(m_ptFlowEntries[histogramIndex]);
+	}
+
 	for(unsigned int i=0;i<histograms.size();i++)
 	{
 		RootFileHelper::SafeCd(settings.GetRootOutFile(), settings.GetRootFileFolder());
@@ -100,18 +115,46 @@ std::string EmbeddingConsumer::GetConsumerId() const
 	return "EmbeddingConsumer";
 }
 
-void EmbeddingConsumer::FillPtFlowHistogram(std::map<std::string, TH1F*> histmap, std::vector<const KPFCandidate*> pf_collection, KMuon* muon, std::string region)
+void EmbeddingConsumer::FillPtFlow(std::vector<const KPFCandidate*> const& pfCollection, RMFLV const& muonP4,
+                                   MuonType muonType, PfClass pfClass, Region massRegion)
 {
-	//double sumPt=0; //for PtFlow distribution
-
-	for (std::vector<const KPFCandidate*>::const_iterator pfCandidate = pf_collection.begin();pfCandidate != pf_collection.end();++pfCandidate)
+	size_t fullIndex = GetHistogramIndex(muonType, pfClass, FULL);
+	size_t massRegionIndex = GetHistogramIndex(muonType, pfClass, massRegion);
+	size_t fullOffset = fullIndex * nDeltaRBins;
+	size_t massRegionOffset = massRegionIndex * nDeltaRBins;
+	unsigned long nFilled = 0;
+	double stats[4] = {0.0, 0.0, 0.0, 0.0};
+
+	for (std::vector<const KPFCandidate*>::const_iterator pfCandidate = pfCollection.begin(); pfCandidate != pfCollection.end(); ++pfCandidate)
 	{
-		double deltaR = ROOT::Math::VectorUtil::DeltaR(muon->p4, (*pfCandidate)->p4);
+		double deltaR = ROOT::Math::VectorUtil::DeltaR(muonP4, (*pfCandidate)->p4);
 		if (deltaR < DeltaRMax)
 		{
-			histmap[region]->Fill(deltaR,(*pfCandidate)->p4.Pt());
+			// same binning convention as TAxis::FindBin for a fixed-width axis starting at zero
+			unsigned int deltaRBin = static_cast<unsigned int>(nDeltaRBins * deltaR / DeltaRMax);
+			if (deltaRBin >= nDeltaRBins)
+			{
+				deltaRBin = nDeltaRBins - 1;
+			}
+			double pt = (*pfCandidate)->p4.Pt();
+
+			m_ptFlowSumOfWeights[fullOffset + deltaRBin] += pt;
+			m_ptFlowSumOfSquaredWeights[fullOffset + deltaRBin] += pt * pt;
+			m_ptFlowSumOfWeights[massRegionOffset + deltaRBin] += pt;
+			m_ptFlowSumOfSquaredWeights[massRegionOffset + deltaRBin] += pt * pt;
+			stats[0] += pt;
+			stats[1] += pt * pt;
+			stats[2] += pt * deltaR;
+			stats[3] += pt * deltaR * deltaR;
+			++nFilled;
 		}
 	}
-	//histmap[region]->Fill(sumPt); //for PtFlow distribution
 
+	m_ptFlowEntries[fullIndex] += nFilled;
+	m_ptFlowEntries[massRegionIndex] += nFilled;
+	for (size_t statIndex = 0; statIndex < 4; ++statIndex)
+	{
+		m_ptFlowStats[fullIndex * 4 + statIndex] += stats[statIndex];
+		m_ptFlowStats[massRegionIndex * 4 + statIndex] += stats[statIndex];
+	}
 }
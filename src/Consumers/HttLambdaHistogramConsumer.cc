@@ -0,0 +1,313 @@
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
+#include "Artus/Utility/interface/RootFileHelper.h"
+#include "Artus/Utility/interface/SafeMap.h"
+#include "Artus/Utility/interface/Utility.h"
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Consumers/HttLambdaHistogramConsumer.h"
+
+
+int HttLambdaHistogramConsumer::Axis::FindBin(double value) const
+{
+	if (value < min)
+	{
+		return 0;
+	}
+	else if (! (value < max))
+	{
+		return nBins + 1;
+	}
+	else
+	{
+		int bin = 1 + static_cast<int>(nBins * (value - min) / (max - min));
+		return std::min(bin, nBins);
+	}
+}
+
+HttLambdaHistogramConsumer::float_extractor_lambda HttLambdaHistogramConsumer::GetExtractor(std::string const& quantity)
+{
+	if (LambdaNtupleConsumer<HttTypes>::GetFloatQuantities().count(quantity) > 0)
+	{
+		return SafeMap::Get(LambdaNtupleConsumer<HttTypes>::GetFloatQuantities(), quantity);
+	}
+	else if (LambdaNtupleConsumer<HttTypes>::GetIntQuantities().count(quantity) > 0)
+	{
+		return SafeMap::Get(LambdaNtupleConsumer<HttTypes>::GetIntQuantities(), quantity);
+	}
+	else if (LambdaNtupleConsumer<HttTypes>::GetBoolQuantities().count(quantity) > 0)
+	{
+		return SafeMap::Get(LambdaNtupleConsumer<HttTypes>::GetBoolQuantities(), quantity);
+	}
+	return nullptr;
+}
+
+void HttLambdaHistogramConsumer::Init(setting_type const& settings)
+{
+	ConsumerBase<HttTypes>::Init(settings);
+
+	std::map<std::string, std::vector<std::string> > quantitiesByHistogram = Utility::ParseVectorToMap(settings.GetHistogramConsumerQuantities());
+	std::map<std::string, std::vector<std::string> > binningsByHistogram = Utility::ParseVectorToMap(settings.GetHistogramConsumerBinnings());
+	std::map<std::string, std::vector<std::string> > weightsByHistogram = Utility::ParseVectorToMap(settings.GetHistogramConsumerWeights());
+	std::map<std::string, std::vector<std::string> > selectionsByHistogram = Utility::ParseVectorToMap(settings.GetHistogramConsumerSelections());
+
+	m_histograms.clear();
+	m_histograms.reserve(quantitiesByHistogram.size());
+	for (std::map<std::string, std::vector<std::string> >::const_iterator quantities = quantitiesByHistogram.begin();
+	     quantities != quantitiesByHistogram.end(); ++quantities)
+	{
+		Histogram histogram;
+		histogram.name = quantities->first;
+
+		// axes
+		std::vector<std::string> const& binnings = SafeMap::Get(binningsByHistogram, histogram.name);
+		if ((quantities->second.size() < 1) || (quantities->second.size() > 2) || (binnings.size() != quantities->second.size()))
+		{
+			LOG(FATAL) << "Histogram \"" << histogram.name << "\" needs one or two quantities and one binning per quantity!";
+		}
+		for (size_t axisIndex = 0; axisIndex < quantities->second.size(); ++axisIndex)
+		{
+			Axis axis;
+			axis.quantity = boost::algorithm::trim_copy(quantities->second[axisIndex]);
+			axis.extractor = GetExtractor(axis.quantity);
+			if (! axis.extractor)
+			{
+				LOG(FATAL) << "Quantity \"" << axis.quantity << "\" for histogram \"" << histogram.name << "\" is not available as float, int or bool quantity!";
+			}
+
+			std::vector<std::string> binning;
+			boost::algorithm::split(binning, binnings[axisIndex], boost::algorithm::is_any_of(","));
+			if (binning.size() != 3)
+			{
+				LOG(FATAL) << "Binning \"" << binnings[axisIndex] << "\" for histogram \"" << histogram.name << "\" does not follow the format \"nBins,min,max\"!";
+			}
+			axis.nBins = boost::lexical_cast<int>(boost::algorithm::trim_copy(binning[0]));
+			axis.min = boost::lexical_cast<double>(boost::algorithm::trim_copy(binning[1]));
+			axis.max = boost::lexical_cast<double>(boost::algorithm::trim_copy(binning[2]));
+			if ((axis.nBins < 1) || (! (axis.min < axis.max)))
+			{
+				LOG(FATAL) << "Invalid binning \"" << binnings[axisIndex] << "\" for histogram \"" << histogram.name << "\"!";
+			}
+			histogram.axes.push_back(axis);
+		}
+
+		// weights
+		std::vector<std::string> weightNames;
+		if (weightsByHistogram.count(histogram.name) > 0)
+		{
+			for (std::vector<std::string>::const_iterator weightExpression = weightsByHistogram[histogram.name].begin();
+			     weightExpression != weightsByHistogram[histogram.name].end(); ++weightExpression)
+			{
+				std::vector<std::string> factors;
+				boost::algorithm::split(factors, *weightExpression, boost::algorithm::is_any_of("*"));
+				for (std::vector<std::string>::const_iterator factor = factors.begin(); factor != factors.end(); ++factor)
+				{
+					std::string weightName = boost::algorithm::trim_copy(*factor);
+					if (! weightName.empty())
+					{
+						weightNames.push_back(weightName);
+					}
+				}
+			}
+		}
+		else
+		{
+			weightNames.push_back(settings.GetEventWeight());
+		}
+		for (std::vector<std::string>::const_iterator weightName = weightNames.begin(); weightName != weightNames.end(); ++weightName)
+		{
+			WeightFactor weightFactor;
+			weightFactor.name = *weightName;
+			weightFactor.extractor = GetExtractor(*weightName);
+			if (weightFactor.extractor)
+			{
+				weightFactor.source = WeightFactor::Source::QUANTITY;
+			}
+			else
+			{
+				// product weights are only known after the first event has been produced
+				LOG(DEBUG) << "\tWeight \"" << *weightName << "\" for histogram \"" << histogram.name << "\" is no lambda quantity and is expected in the (optional) weights of the product.";
+			}
+			histogram.weightFactors.push_back(weightFactor);
+		}
+		histogram.weightFactorsResolved = std::all_of(histogram.weightFactors.begin(), histogram.weightFactors.end(),
+		                                              [](WeightFactor const& weightFactor) { return weightFactor.source != WeightFactor::Source::UNRESOLVED; });
+
+		// selection
+		if (selectionsByHistogram.count(histogram.name) > 0)
+		{
+			std::string selection = boost::algorithm::trim_copy(selectionsByHistogram[histogram.name].at(0));
+			histogram.selection = GetExtractor(selection);
+			if (! histogram.selection)
+			{
+				LOG(FATAL) << "Selection quantity \"" << selection << "\" for histogram \"" << histogram.name << "\" is not available as float, int or bool quantity!";
+			}
+			histogram.hasSelection = true;
+		}
+
+		// preallocated storage
+		size_t nBinsTotal = 1;
+		for (std::vector<Axis>::const_iterator axis = histogram.axes.begin(); axis != histogram.axes.end(); ++axis)
+		{
+			nBinsTotal *= (axis->nBins + 2);
+		}
+		histogram.sumOfWeights.assign(nBinsTotal, 0.0);
+		histogram.sumOfSquaredWeights.assign(nBinsTotal, 0.0);
+		histogram.stats.assign((histogram.axes.size() == 1) ? 4 : 7, 0.0);
+
+		LOG(DEBUG) << "\tHistogram \"" << histogram.name << "\" with " << histogram.axes.size() << " axes and " << histogram.weightFactors.size() << " weight factors.";
+		m_histograms.push_back(histogram);
+	}
+}
+
+void HttLambdaHistogramConsumer::ResolveProductWeights(Histogram& histogram, product_type const& product)
+{
+	for (std::vector<WeightFactor>::iterator weightFactor = histogram.weightFactors.begin();
+	     weightFactor != histogram.weightFactors.end(); ++weightFactor)
+	{
+		if (weightFactor->source != WeightFactor::Source::UNRESOLVED)
+		{
+			continue;
+		}
+
+		if (product.m_weights.count(weightFactor->name) > 0)
+		{
+			weightFactor->source = WeightFactor::Source::WEIGHTS;
+		}
+		else if (product.m_optionalWeights.count(weightFactor->name) > 0)
+		{
+			weightFactor->source = WeightFactor::Source::OPTIONAL_WEIGHTS;
+		}
+		else
+		{
+			LOG(FATAL) << "Weight \"" << weightFactor->name << "\" for histogram \"" << histogram.name << "\" is neither a lambda quantity nor a (optional) weight of the product!";
+		}
+	}
+	histogram.weightFactorsResolved = true;
+}
+
+double HttLambdaHistogramConsumer::GetWeight(Histogram const& histogram, event_type const& event, product_type const& product)
+{
+	double weight = 1.0;
+	for (std::vector<WeightFactor>::const_iterator weightFactor = histogram.weightFactors.begin();
+	     weightFactor != histogram.weightFactors.end(); ++weightFactor)
+	{
+		switch (weightFactor->source)
+		{
+			case WeightFactor::Source::QUANTITY:
+				weight *= weightFactor->extractor(event, product);
+				break;
+			case WeightFactor::Source::WEIGHTS:
+				weight *= SafeMap::Get(product.m_weights, weightFactor->name);
+				break;
+			case WeightFactor::Source::OPTIONAL_WEIGHTS:
+				weight *= SafeMap::Get(product.m_optionalWeights, weightFactor->name);
+				break;
+			default:
+				LOG(FATAL) << "Weight \"" << weightFactor->name << "\" for histogram \"" << histogram.name << "\" has not been resolved!";
+		}
+	}
+	return weight;
+}
+
+void HttLambdaHistogramConsumer::ProcessFilteredEvent(event_type const& event, product_type const& product,
+                                                      setting_type const& settings)
+{
+	ConsumerBase<HttTypes>::ProcessFilteredEvent(event, product, settings);
+
+	for (std::vector<Histogram>::iterator histogram = m_histograms.begin(); histogram != m_histograms.end(); ++histogram)
+	{
+		if (histogram->hasSelection && (histogram->selection(event, product) == 0.0))
+		{
+			continue;
+		}
+
+		if (! histogram->weightFactorsResolved)
+		{
+			ResolveProductWeights(*histogram, product);
+		}
+		double weight = GetWeight(*histogram, event, product);
+
+		Axis const& xAxis = histogram->axes[0];
+		double x = xAxis.extractor(event, product);
+		int xBin = xAxis.FindBin(x);
+		size_t globalBin = xBin;
+		bool inRange = ((xBin > 0) && (xBin <= xAxis.nBins));
+
+		double y = 0.0;
+		if (histogram->axes.size() > 1)
+		{
+			Axis const& yAxis = histogram->axes[1];
+			y = yAxis.extractor(event, product);
+			int yBin = yAxis.FindBin(y);
+			globalBin += yBin * (xAxis.nBins + 2);
+			inRange = inRange && (yBin > 0) && (yBin <= yAxis.nBins);
+		}
+
+		histogram->sumOfWeights[globalBin] += weight;
+		histogram->sumOfSquaredWeights[globalBin] += weight * weight;
+		histogram->entries += 1.0;
+
+		// under- and overflow do not enter the statistics (ROOT default)
+		if (inRange)
+		{
+			std::vector<double>& stats = histogram->stats;
+			stats[0] += weight;
+			stats[1] += weight * weight;
+			stats[2] += weight * x;
+			stats[3] += weight * x * x;
+			if (histogram->axes.size() > 1)
+			{
+				stats[4] += weight * y;
+				stats[5] += weight * y * y;
+				stats[6] += weight * x * y;
+			}
+		}
+	}
+}
+
+void HttLambdaHistogramConsumer::Finish(setting_type const& settings)
+{
+	RootFileHelper::SafeCd(settings.GetRootOutFile(), settings.GetRootFileFolder());
+
+	for (std::vector<Histogram>::iterator histogram = m_histograms.begin(); histogram != m_histograms.end(); ++histogram)
+	{
+		Axis const& xAxis = histogram->axes[0];
+		TH1* rootHistogram = nullptr;
+		if (histogram->axes.size() == 1)
+		{
+			rootHistogram = new TH1D(histogram->name.c_str(), histogram->name.c_str(),
+			                         xAxis.nBins, xAxis.min, xAxis.max);
+			rootHistogram->GetXaxis()->SetTitle(xAxis.quantity.c_str());
+		}
+		else
+		{
+			Axis const& yAxis = histogram->axes[1];
+			rootHistogram = new TH2D(histogram->name.c_str(), histogram->name.c_str(),
+			                         xAxis.nBins, xAxis.min, xAxis.max,
+			                         yAxis.nBins, yAxis.min, yAxis.max);
+			rootHistogram->GetXaxis()->SetTitle(xAxis.quantity.c_str());
+			rootHistogram->GetYaxis()->SetTitle(yAxis.quantity.c_str());
+		}
+		rootHistogram->Sumw2();
+
+		// the global bin numbering of ROOT matches the layout of the arrays
+		for (size_t globalBin = 0; globalBin < histogram->sumOfWeights.size(); ++globalBin)
+		{
+			rootHistogram->SetBinContent(globalBin, histogram->sumOfWeights[globalBin]);
+			rootHistogram->SetBinError(globalBin, std::sqrt(histogram->sumOfSquaredWeights[globalBin]));
+		}
+		rootHistogram->PutStats(&(histogram->stats[0]));
+		rootHistogram->SetEntries(histogram->entries);
+
+		rootHistogram->Write(rootHistogram->GetName());
+	}
+}
+
@@ -1,6 +1,8 @@
 
 #include <Math/VectorUtil.h>
+#include <TTree.h>
 
+#include "Artus/Utility/interface/RootFileHelper.h"
 #include "Artus/Utility/interface/SafeMap.h"
 #include "Artus/Utility/interface/Utility.h"
 #include "Artus/Utility/interface/DefaultValues.h"
@@ -299,4 +301,40 @@ void HttLambdaNtupleConsumer::Init(setting_type const& settings)
 
 	// need to be called at last
 	KappaLambdaNtupleConsumer::Init(settings);
+	
+	m_writeLheWeightNames = Utility::Contains(settings.GetQuantities(), std::string("lheWeights"));
+}
+
+void HttLambdaNtupleConsumer::ProcessFilteredEvent(event_type const& event, product_type const& product,
+                                                   setting_type const& settings)
+{
+	KappaLambdaNtupleConsumer::ProcessFilteredEvent(event, product, settings);
+	
+	if (m_writeLheWeightNames && m_lheWeightNames.empty() && (product.m_lheWeightNames != nullptr))
+	{
+		m_lheWeightNames = *(product.m_lheWeightNames);
+	}
+}
+
+void HttLambdaNtupleConsumer::Finish(setting_type const& settings)
+{
+	KappaLambdaNtupleConsumer::Finish(settings);
+	
+	if (m_writeLheWeightNames)
+	{
+		RootFileHelper::SafeCd(settings.GetRootOutFile(), settings.GetRootFileFolder());
+		
+		TTree* lheWeightNamesTree = new TTree("lheWeightNames", "names of the entries of the lheWeights arrays");
+		int index = 0;
+		std::string name;
+		lheWeightNamesTree->Branch("index", &index, "index/I");
+		lheWeightNamesTree->Branch("name", &name);
+		for (std::vector<std::string>::const_iterator lheWeightName = m_lheWeightNames.begin(); lheWeightName != m_lheWeightNames.end(); ++lheWeightName)
+		{
+			name = *lheWeightName;
+			lheWeightNamesTree->Fill();
+			++index;
+		}
+		lheWeightNamesTree->Write(lheWeightNamesTree->GetName());
+	}
 }
@@ -58,13 +58,12 @@ void SvfitCacheConsumer::ProcessFilteredEvent(event_type const& event, product_t
 				{
 			    	m_firstSvfitCacheFile = false;
 				}
-				product.m_svfitEventKey.CreateBranches(m_svfitCacheTree);
-				product.m_svfitInputs.CreateBranches(m_svfitCacheTree);
-				product.m_svfitResults.CreateBranches(m_svfitCacheTree);
+				m_svfitCacheBranches.CreateBranches(m_svfitCacheTree);
 				m_svfitCacheTreeInitialised = true;
 			}
 			if (product.m_svfitCalculated)
 			{
+				m_svfitCacheBranches.Set(product.m_svfitEventKey, product.m_svfitInputs, product.m_svfitResults);
 				m_svfitCacheTree->Fill();
 			}
 			// at reaching a predefined threshold create the outputfile with index m_fileIndex and save the tree
@@ -79,13 +78,12 @@ void SvfitCacheConsumer::ProcessFilteredEvent(event_type const& event, product_t
 	{
 		if (! m_svfitCacheTreeInitialised)
 		{
-			product.m_svfitEventKey.CreateBranches(m_svfitCacheTree);
-			product.m_svfitInputs.CreateBranches(m_svfitCacheTree);
-			product.m_svfitResults.CreateBranches(m_svfitCacheTree);
+			m_svfitCacheBranches.CreateBranches(m_svfitCacheTree);
 			m_svfitCacheTreeInitialised = true;
 		}
 		if (product.m_svfitCalculated)
 		{
+				m_svfitCacheBranches.Set(product.m_svfitEventKey, product.m_svfitInputs, product.m_svfitResults);
 				m_svfitCacheTree->Fill();
 		}
 	}
@@ -0,0 +1,199 @@
+
+#include <cmath>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/trim.hpp>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Consumers/WeightedCutFlowConsumer.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Filters/SharedPrefixFilter.h"
+
+
+std::string WeightedCutFlowConsumer::GetConsumerId() const
+{
+	return "WeightedCutFlowConsumer";
+}
+
+void WeightedCutFlowConsumer::Init(setting_type const& settings)
+{
+	ConsumerBase<HttTypes>::Init(settings);
+
+	m_sharedPrefixFilterId = SharedPrefixFilter().GetFilterId();
+	m_weightNames = settings.GetCutFlowWeights();
+	for (std::string& weightName : m_weightNames)
+	{
+		boost::algorithm::trim(weightName);
+	}
+	if (m_weightNames.empty())
+	{
+		m_weightNames.push_back(settings.GetEventWeight());
+	}
+
+	// filters of this pipeline in the configured order, the SharedPrefixFilter is replaced by the filters within the shared prefix
+	std::string const filterPrefix = "filter:";
+	for (std::string const& processor : settings.GetProcessors())
+	{
+		if (processor == (filterPrefix + m_sharedPrefixFilterId))
+		{
+			for (std::string const& sharedProcessor : settings.GetSharedPrefixProcessors())
+			{
+				std::string trimmedSharedProcessor = boost::algorithm::trim_copy(sharedProcessor);
+				if (boost::algorithm::starts_with(trimmedSharedProcessor, filterPrefix))
+				{
+					GetFilterIndex(boost::algorithm::trim_copy(trimmedSharedProcessor.substr(filterPrefix.size())));
+				}
+			}
+		}
+		else if (boost::algorithm::starts_with(processor, filterPrefix))
+		{
+			GetFilterIndex(processor.substr(filterPrefix.size()));
+		}
+	}
+}
+
+void WeightedCutFlowConsumer::ProcessEvent(event_type const& event, product_type const& product, setting_type const& settings, FilterResult & result)
+{
+	double weight = GetWeight(event, product);
+
+	bool passedPreviousFilters = true;
+	size_t decisionIndex = 0;
+	for (FilterResult::FilterDecisions::const_iterator filterDecision = result.GetFilterDecisions().begin();
+	     passedPreviousFilters && (filterDecision != result.GetFilterDecisions().end()); ++filterDecision)
+	{
+		if (filterDecision->filterName == m_sharedPrefixFilterId)
+		{
+			// the filters within the shared prefix are counted individually, the prefix stops at the first failing one
+			for (std::vector<std::pair<std::string, bool> >::const_iterator sharedFilterDecision = product.m_sharedPrefixFilterDecisions.begin();
+			     passedPreviousFilters && (sharedFilterDecision != product.m_sharedPrefixFilterDecisions.end()); ++sharedFilterDecision)
+			{
+				passedPreviousFilters = FillDecision(decisionIndex++, sharedFilterDecision->first, sharedFilterDecision->second, true, weight);
+			}
+		}
+		else
+		{
+			// filters in tagging mode only record their decision and do not stop the event
+			bool passed = (filterDecision->filterDecision == FilterResult::Decision::Passed);
+			bool stopping = (filterDecision->taggingMode != FilterResult::TaggingMode::Tagging);
+			passedPreviousFilters = (FillDecision(decisionIndex++, filterDecision->filterName, passed, stopping, weight) || (! stopping));
+		}
+	}
+
+	if (passedPreviousFilters)
+	{
+		m_passingAll.Fill(weight);
+	}
+}
+
+void WeightedCutFlowConsumer::Finish(setting_type const& settings)
+{
+	RootFileHelper::SafeCd(settings.GetRootOutFile(), settings.GetRootFileFolder());
+
+	std::vector<CutFlowCounts> firstFailing = m_firstFailing;
+	firstFailing.push_back(m_passingAll);
+	std::vector<std::string> firstFailingLabels = m_filterIds;
+	firstFailingLabels.push_back("none");
+
+	for (bool weighted : {false, true})
+	{
+		std::string suffix = (weighted ? "Weighted" : "");
+		WriteHistogram("cutFlowEntering" + suffix, m_entering, m_filterIds, weighted);
+		WriteHistogram("cutFlowPassing" + suffix, m_passing, m_filterIds, weighted);
+		WriteHistogram("cutFlowFirstFailing" + suffix, firstFailing, firstFailingLabels, weighted);
+	}
+}
+
+double WeightedCutFlowConsumer::GetWeight(event_type const& event, product_type const& product)
+{
+	// the product is complete for events passing all filters, events stopped by a filter only
+	// carry the weights produced before it and the missing ones count as 1
+	double weight = 1.0;
+	for (std::string const& weightName : m_weightNames)
+	{
+		std::map<std::string, double>::const_iterator productWeight = product.m_weights.find(weightName);
+		if (productWeight != product.m_weights.end())
+		{
+			weight *= productWeight->second;
+		}
+		else if ((productWeight = product.m_optionalWeights.find(weightName)) != product.m_optionalWeights.end())
+		{
+			weight *= productWeight->second;
+		}
+		else if (m_missingWeightNames.insert(weightName).second)
+		{
+			LOG(WARNING) << "Weight \"" << weightName << "\" listed in CutFlowWeights is not present in the product of event "
+			             << event.m_eventInfo->nRun << ":" << event.m_eventInfo->nLumi << ":" << event.m_eventInfo->nEvent
+			             << " and counts as 1 for all events without it. This is expected for weights produced after the filter stopping the event.";
+		}
+	}
+	return weight;
+}
+
+bool WeightedCutFlowConsumer::FillDecision(size_t decisionIndex, std::string const& filterId, bool passed, bool stopping, double weight)
+{
+	// the sequence of filters is identical for all events up to the first failing one
+	if (decisionIndex >= m_decisionFilterIndices.size())
+	{
+		m_decisionFilterIndices.push_back(GetFilterIndex(filterId));
+	}
+	size_t filterIndex = m_decisionFilterIndices[decisionIndex];
+
+	m_entering[filterIndex].Fill(weight);
+	if (passed)
+	{
+		m_passing[filterIndex].Fill(weight);
+	}
+	else if (stopping)
+	{
+		m_firstFailing[filterIndex].Fill(weight);
+	}
+	return passed;
+}
+
+size_t WeightedCutFlowConsumer::GetFilterIndex(std::string const& filterId)
+{
+	std::unordered_map<std::string, size_t>::const_iterator filterIndex = m_filterIndices.find(filterId);
+	if (filterIndex != m_filterIndices.end())
+	{
+		return filterIndex->second;
+	}
+
+	// filters not configured in this pipeline (e.g. global ones) are appended when they occur for the first time
+	size_t newFilterIndex = m_filterIds.size();
+	m_filterIds.push_back(filterId);
+	m_filterIndices[filterId] = newFilterIndex;
+	m_entering.emplace_back();
+	m_passing.emplace_back();
+	m_firstFailing.emplace_back();
+	return newFilterIndex;
+}
+
+void WeightedCutFlowConsumer::WriteHistogram(std::string const& name, std::vector<CutFlowCounts> const& counts,
+                                             std::vector<std::string> const& labels, bool weighted) const
+{
+	size_t nBins = counts.size();
+	TH1D histogram(name.c_str(), name.c_str(), nBins, 0.0, nBins);
+	if (weighted)
+	{
+		histogram.Sumw2();
+	}
+
+	double entries = 0.0;
+	for (size_t bin = 0; bin < nBins; ++bin)
+	{
+		histogram.GetXaxis()->SetBinLabel(bin + 1, labels[bin].c_str());
+		if (weighted)
+		{
+			histogram.SetBinContent(bin + 1, counts[bin].sumOfWeights);
+			histogram.SetBinError(bin + 1, std::sqrt(counts[bin].sumOfSquaredWeights));
+		}
+		else
+		{
+			histogram.SetBinContent(bin + 1, counts[bin].entries);
+		}
+		entries += counts[bin].entries;
+	}
+	histogram.SetEntries(entries);
+	histogram.Write(histogram.GetName());
+}
+
@@ -0,0 +1,85 @@
+
+#include <map>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEventInputs.h"
+
+
+std::vector<std::string> const& HttEventInputs::GetOptionalCollections()
+{
+	static std::vector<std::string> const optionalCollections = {
+		"PackedPFCandidates",
+		"PFChargedHadronsPileUp",
+		"PFChargedHadronsNoPileUp",
+		"PFNeutralHadronsNoPileUp",
+		"PFPhotonsNoPileUp",
+		"LHEParticles",
+		"MvaMetTT", "MvaMetMT", "MvaMetET", "MvaMetEM",
+		"MvaMetsTT", "MvaMetsMT", "MvaMetsET", "MvaMetsEM", "MvaMets"
+	};
+	return optionalCollections;
+}
+
+std::vector<std::string> const* HttEventInputs::GetExternalProcessorCollections(std::string const& processorId)
+{
+	// processors of the KappaAnalysis package used in the standard configurations
+	static std::map<std::string, std::vector<std::string> > const declarations = {
+		{ "producer:GenPartonCounterProducer", { "LHEParticles" } },
+		{ "producer:CrossSectionWeightProducer", {} },
+		{ "producer:ElectronTriggerMatchingProducer", {} },
+		{ "producer:EventWeightProducer", {} },
+		{ "producer:GenBosonDiLeptonDecayModeProducer", {} },
+		{ "producer:GenBosonFromGenParticlesProducer", {} },
+		{ "producer:GenDiLeptonDecayModeProducer", {} },
+		{ "producer:GenParticleProducer", {} },
+		{ "producer:GenTauDecayProducer", {} },
+		{ "producer:GeneratorWeightProducer", {} },
+		{ "producer:HltProducer", {} },
+		{ "producer:JetCorrectionsProducer", {} },
+		{ "producer:MatchedLeptonsProducer", {} },
+		{ "producer:MuonTriggerMatchingProducer", {} },
+		{ "producer:NicknameProducer", {} },
+		{ "producer:NumberGeneratedEventsWeightProducer", {} },
+		{ "producer:PUWeightProducer", {} },
+		{ "producer:RecoElectronGenParticleMatchingProducer", {} },
+		{ "producer:RecoElectronGenTauMatchingProducer", {} },
+		{ "producer:RecoMuonGenParticleMatchingProducer", {} },
+		{ "producer:RecoMuonGenTauMatchingProducer", {} },
+		{ "producer:RecoTauGenParticleMatchingProducer", {} },
+		{ "producer:RecoTauGenTauMatchingProducer", {} },
+		{ "producer:TaggedJetCorrectionsProducer", {} },
+		{ "producer:TauTriggerMatchingProducer", {} },
+		{ "producer:ValidBTaggedJetsProducer", {} },
+		{ "producer:ValidGenTausProducer", {} },
+		{ "producer:ZmmProducer", {} },
+		{ "filter:HltFilter", {} },
+		{ "filter:JsonFilter", {} },
+		{ "filter:MinElectronsCountFilter", {} },
+		{ "filter:MinMuonsCountFilter", {} },
+		{ "filter:MinTausCountFilter", {} },
+		{ "filter:RunLumiEventFilter", {} },
+		{ "filter:ValidElectronsFilter", {} },
+		{ "filter:ValidMuonsFilter", {} },
+		{ "filter:ValidTausFilter", {} },
+		{ "filter:ZFilter", {} },
+		{ "consumer:KappaElectronsConsumer", {} },
+		{ "consumer:KappaTaggedJetsConsumer", {} },
+		{ "consumer:KappaTausConsumer", {} },
+		{ "consumer:CutFlowTreeConsumer", {} },
+		{ "consumer:cutflow_histogram", {} },
+		{ "consumer:PrintEventsConsumer", {} },
+		{ "consumer:RunTimeConsumer", {} }
+	};
+	std::map<std::string, std::vector<std::string> >::const_iterator declaration = declarations.find(processorId);
+	return ((declaration != declarations.end()) ? &(declaration->second) : nullptr);
+}
+
+void HttEventInputs::AssertActive(std::set<std::string> const& deactivatedCollections, std::string const& collection)
+{
+	if (deactivatedCollections.count(collection) > 0)
+	{
+		LOG(FATAL) << "The input collection " << collection << " is read although it has been deactivated! "
+		           << "It needs to be returned by HttEventInputs::Reader::GetOptionalInputs of the reading processor.";
+	}
+}
@@ -1,5 +1,13 @@
 
+#include <boost/algorithm/string/join.hpp>
+
+#include <TChain.h>
+#include <TROOT.h>
+
+#include "Artus/Utility/interface/SafeMap.h"
+
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEventProvider.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEventInputs.h"
 
 /**
    \brief class to connect the analysis specific event content to the pipelines.
@@ -7,7 +15,8 @@
 
 
 HttEventProvider::HttEventProvider(FileInterface2 & fileInterface, InputTypeEnum inpType, bool batchMode) :
-		KappaEventProvider<HttTypes>(fileInterface, inpType, batchMode)
+		KappaEventProvider<HttTypes>(fileInterface, inpType, batchMode),
+		m_inputFileInterface(fileInterface)
 {
 
 }
@@ -40,3 +49,102 @@ void HttEventProvider::WireEvent(setting_type const& settings)
 	
 }
 
+void HttEventProvider::DeactivateUnreadCollections(setting_type const& settings,
+                                                   std::set<std::string> const& readCollections,
+                                                   std::set<std::string> const& undeclaredProcessorIds)
+{
+	if (! settings.GetDeactivateUnreadInputCollections())
+	{
+		return;
+	}
+	
+	if (! undeclaredProcessorIds.empty())
+	{
+		LOG(WARNING) << "No input collections declared for the processors " << boost::algorithm::join(undeclaredProcessorIds, ", ")
+		             << ". All optional input collections are kept active.";
+	}
+	
+	// branch names of the optional collections in the input files and the event members pointing to them
+	std::map<std::string, std::string> branchNames = {
+		{ "PackedPFCandidates", settings.GetPackedPFCandidates() },
+		{ "PFChargedHadronsPileUp", settings.GetPFChargedHadronsPileUp() },
+		{ "PFChargedHadronsNoPileUp", settings.GetPFChargedHadronsNoPileUp() },
+		{ "PFNeutralHadronsNoPileUp", settings.GetPFNeutralHadronsNoPileUp() },
+		{ "PFPhotonsNoPileUp", settings.GetPFPhotonsNoPileUp() },
+		{ "LHEParticles", settings.GetLHEParticles() },
+		{ "MvaMetTT", settings.GetMvaMetTT() },
+		{ "MvaMetMT", settings.GetMvaMetMT() },
+		{ "MvaMetET", settings.GetMvaMetET() },
+		{ "MvaMetEM", settings.GetMvaMetEM() },
+		{ "MvaMetsTT", settings.GetMvaMetsTT() },
+		{ "MvaMetsMT", settings.GetMvaMetsMT() },
+		{ "MvaMetsET", settings.GetMvaMetsET() },
+		{ "MvaMetsEM", settings.GetMvaMetsEM() },
+		{ "MvaMets", settings.GetMvaMets() }
+	};
+	
+	for (std::string const& collection : HttEventInputs::GetOptionalCollections())
+	{
+		std::string const& branchName = SafeMap::Get(branchNames, collection);
+		if (branchName.empty() || (readCollections.count(collection) > 0))
+		{
+			continue;
+		}
+		
+		m_inputFileInterface.eventdata.SetBranchStatus(branchName.c_str(), false);
+		m_inputFileInterface.eventdata.SetBranchStatus((branchName + ".*").c_str(), false);
+		LOG(INFO) << "Deactivated input collection " << collection << " (branch \"" << branchName << "\"), since it is not read by any processor.";
+		
+		// the pointers of deactivated collections are not set, processors read them through
+		// HttEvent::GetOptionalCollection to fail instead of skipping the collection
+		this->m_event.m_deactivatedCollections.insert(collection);
+		if (collection == "PackedPFCandidates") this->m_event.m_packedPFCandidates = nullptr;
+		else if (collection == "PFChargedHadronsPileUp") this->m_event.m_pfChargedHadronsPileUp = nullptr;
+		else if (collection == "PFChargedHadronsNoPileUp") this->m_event.m_pfChargedHadronsNoPileUp = nullptr;
+		else if (collection == "PFNeutralHadronsNoPileUp") this->m_event.m_pfNeutralHadronsNoPileUp = nullptr;
+		else if (collection == "PFPhotonsNoPileUp") this->m_event.m_pfPhotonsNoPileUp = nullptr;
+		else if (collection == "LHEParticles") this->m_event.m_lheParticles = nullptr;
+		else if (collection == "MvaMetTT") this->m_event.m_mvaMetTT = nullptr;
+		else if (collection == "MvaMetMT") this->m_event.m_mvaMetMT = nullptr;
+		else if (collection == "MvaMetET") this->m_event.m_mvaMetET = nullptr;
+		else if (collection == "MvaMetEM") this->m_event.m_mvaMetEM = nullptr;
+		else if (collection == "MvaMetsTT") this->m_event.m_mvaMetsTT = nullptr;
+		else if (collection == "MvaMetsMT") this->m_event.m_mvaMetsMT = nullptr;
+		else if (collection == "MvaMetsET") this->m_event.m_mvaMetsET = nullptr;
+		else if (collection == "MvaMetsEM") this->m_event.m_mvaMetsEM = nullptr;
+		else if (collection == "MvaMets") this->m_event.m_mvaMets = nullptr;
+	}
+}
+
+void HttEventProvider::ConfigureTreeCache(setting_type const& settings)
+{
+	TChain& eventData = m_inputFileInterface.eventdata;
+	
+	// the unzip cache is sized relative to the TTreeCache and has to be enabled before setting its size,
+	// the baskets are only decompressed in parallel if implicit multi-threading is enabled
+	if (settings.GetInputParallelUnzip())
+	{
+		if (ROOT::IsImplicitMTEnabled())
+		{
+			eventData.SetParallelUnzip(true);
+			LOG(INFO) << "Decompress the cached input baskets in parallel.";
+		}
+		else
+		{
+			LOG(WARNING) << "InputParallelUnzip requires ROOT's implicit multi-threading, which is not enabled. The input baskets are decompressed sequentially.";
+		}
+	}
+	
+	if (settings.GetInputTreeCacheSize() > 0)
+	{
+		eventData.SetCacheSize(static_cast<Long64_t>(settings.GetInputTreeCacheSize()) * 1024 * 1024);
+		
+		// the branches to be cached are learned from the first entries,
+		// such that deactivated and unused branches are not prefetched
+		if (settings.GetInputTreeCacheLearnEntries() > 0)
+		{
+			eventData.SetCacheLearnEntries(settings.GetInputTreeCacheLearnEntries());
+		}
+		LOG(INFO) << "Use TTreeCache of " << settings.GetInputTreeCacheSize() << " MB for the input files.";
+	}
+}
@@ -39,6 +39,7 @@
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/ScaleVariationProducer.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/SimpleEleTauFakeRateWeightProducer.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/SimpleMuTauFakeRateWeightProducer.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/LeptonTauFakeRateWeightProducer.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/JetToTauFakesProducer.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/PolarisationQuantitiesProducer.h"
 //#include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/SimpleFitProducer.h"
@@ -57,6 +58,7 @@
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/TauTrigger2017EfficiencyProducer.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/ImpactParameterCorrectionsProducer.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/MetFilterFlagProducer.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/SharedPrefixProducer.h"
 
 // filters
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Filters/LooseObjectsCountFilters.h"
@@ -71,18 +73,84 @@
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Filters/ValidDiTauPairCandidatesFilter.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Filters/GenDiTauPairFilters.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Filters/MetFilter.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Filters/SharedPrefixFilter.h"
 
 // consumers
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Consumers/HttLambdaNtupleConsumer.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Consumers/HttLambdaHistogramConsumer.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Consumers/SvfitCacheConsumer.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Consumers/TriggerTagAndProbeConsumers.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Consumers/EventCountConsumer.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Consumers/WeightedCutFlowConsumer.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Consumers/EmbeddingConsumer.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Consumers/BTagEffConsumer.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Consumers/AcceptanceEfficiencyConsumer.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Consumers/TagAndProbePairConsumer.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEventInputs.h"
 
 ProducerBaseUntemplated * HttFactory::createProducer(std::string const& id)
+{
+	ProducerBaseUntemplated* producer = createHttProducer(id);
+	if (producer)
+	{
+		return DeclareInputs(producer);
+	}
+	DeclareExternalInputs("producer:" + id);
+	return KappaFactory::createProducer( id );
+}
+
+FilterBaseUntemplated * HttFactory::createFilter(std::string const& id)
+{
+	FilterBaseUntemplated* filter = createHttFilter(id);
+	if (filter)
+	{
+		return DeclareInputs(filter);
+	}
+	DeclareExternalInputs("filter:" + id);
+	return KappaFactory::createFilter( id );
+}
+
+ConsumerBaseUntemplated * HttFactory::createConsumer (std::string const& id)
+{
+	ConsumerBaseUntemplated* consumer = createHttConsumer(id);
+	if (consumer)
+	{
+		return DeclareInputs(consumer);
+	}
+	DeclareExternalInputs("consumer:" + id);
+	return KappaFactory::createConsumer( id );
+}
+
+template<class TProcessor>
+TProcessor* HttFactory::DeclareInputs(TProcessor* processor)
+{
+	// processors of this package not implementing HttEventInputs::Reader do not read any optional collection
+	HttEventInputs::Reader const* reader = dynamic_cast<HttEventInputs::Reader const*>(processor);
+	if (reader)
+	{
+		std::vector<std::string> optionalInputs = reader->GetOptionalInputs();
+		m_readCollections.insert(optionalInputs.begin(), optionalInputs.end());
+	}
+	return processor;
+}
+
+void HttFactory::DeclareExternalInputs(std::string const& processorId)
+{
+	m_externalProcessorIds.insert(processorId);
+	std::vector<std::string> const* collections = HttEventInputs::GetExternalProcessorCollections(processorId);
+	if (collections)
+	{
+		m_readCollections.insert(collections->begin(), collections->end());
+	}
+	else
+	{
+		// undeclared processors of other packages might read any of the optional collections
+		m_undeclaredProcessorIds.insert(processorId);
+		m_readCollections.insert(HttEventInputs::GetOptionalCollections().begin(), HttEventInputs::GetOptionalCollections().end());
+	}
+}
+
+ProducerBaseUntemplated * HttFactory::createHttProducer(std::string const& id)
 {
 	if(id == ElectronEtaSelector().GetProducerId())
 		return new ElectronEtaSelector();
@@ -222,6 +290,8 @@ ProducerBaseUntemplated * HttFactory::createProducer(std::string const& id)
 		return new SimpleEleTauFakeRateWeightProducer();
 	else if(id == SimpleMuTauFakeRateWeightProducer().GetProducerId())
 		return new SimpleMuTauFakeRateWeightProducer();
+	else if(id == LeptonTauFakeRateWeightProducer().GetProducerId())
+		return new LeptonTauFakeRateWeightProducer();
 	else if(id == JetToTauFakesProducer().GetProducerId())
 		return new JetToTauFakesProducer();
 	else if(id == PolarisationQuantitiesProducer().GetProducerId())
@@ -276,11 +346,13 @@ ProducerBaseUntemplated * HttFactory::createProducer(std::string const& id)
 		return new ImpactParameterCorrectionsProducer();
         else if(id == MetFilterFlagProducer().GetProducerId())
                 return new MetFilterFlagProducer();
+	else if(id == SharedPrefixProducer().GetProducerId())
+		return new SharedPrefixProducer(this);
 	else
-		return KappaFactory::createProducer( id );
+		return nullptr;
 }
 
-FilterBaseUntemplated * HttFactory::createFilter(std::string const& id)
+FilterBaseUntemplated * HttFactory::createHttFilter(std::string const& id)
 {
 	if(id == LooseElectronsCountFilter().GetFilterId())
 		return new LooseElectronsCountFilter();
@@ -316,14 +388,18 @@ FilterBaseUntemplated * HttFactory::createFilter(std::string const& id)
 		return new GenDiTauPairAcceptanceFilter();
 	else if(id == MetFilter().GetFilterId())
 		return new MetFilter();
+	else if(id == SharedPrefixFilter().GetFilterId())
+		return new SharedPrefixFilter();
 	else
-		return KappaFactory::createFilter( id );
+		return nullptr;
 }
 
-ConsumerBaseUntemplated * HttFactory::createConsumer (std::string const& id)
+ConsumerBaseUntemplated * HttFactory::createHttConsumer(std::string const& id)
 {
 	if(id == HttLambdaNtupleConsumer().GetConsumerId())
 		return new HttLambdaNtupleConsumer();
+	else if(id == HttLambdaHistogramConsumer().GetConsumerId())
+		return new HttLambdaHistogramConsumer();
 	else if(id == SvfitCacheConsumer().GetConsumerId())
 		return new SvfitCacheConsumer();
 	else if(id == EETriggerTagAndProbeConsumer().GetConsumerId())
@@ -336,6 +412,8 @@ ConsumerBaseUntemplated * HttFactory::createConsumer (std::string const& id)
 		return new ETTriggerTagAndProbeConsumer();
 	else if(id == EventCountConsumer().GetConsumerId())
 		return new EventCountConsumer();
+	else if(id == WeightedCutFlowConsumer().GetConsumerId())
+		return new WeightedCutFlowConsumer();
 	else if(id == EmbeddingConsumer().GetConsumerId())
 		return new EmbeddingConsumer();
 	else if(id == BTagEffConsumer().GetConsumerId())
@@ -353,6 +431,6 @@ ConsumerBaseUntemplated * HttFactory::createConsumer (std::string const& id)
 	else if(id == TagAndProbeGenElectronConsumer<HttTypes>().GetConsumerId())
 		return new TagAndProbeGenElectronConsumer<HttTypes>();
 	else
-		return KappaFactory::createConsumer( id );
+		return nullptr;
 }
 
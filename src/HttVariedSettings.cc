@@ -0,0 +1,52 @@
+
+#include <map>
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttVariedSettings.h"
+
+
+std::vector<std::string> const* HttVariedSettings::GetExternalProcessorSettings(std::string const& processorId)
+{
+	// processors of the KappaAnalysis package used in the standard configurations
+	static std::map<std::string, std::vector<std::string> > const declarations = {
+		{ "producer:JetCorrectionsProducer", { "JetEnergyCorrectionUncertaintyShift" } },
+		{ "producer:TaggedJetCorrectionsProducer", { "JetEnergyCorrectionUncertaintyShift" } },
+		{ "producer:ValidBTaggedJetsProducer", { "BTagShift", "BMistagShift" } },
+		{ "producer:CrossSectionWeightProducer", {} },
+		{ "producer:ElectronTriggerMatchingProducer", {} },
+		{ "producer:EventWeightProducer", {} },
+		{ "producer:GenBosonDiLeptonDecayModeProducer", {} },
+		{ "producer:GenBosonFromGenParticlesProducer", {} },
+		{ "producer:GenDiLeptonDecayModeProducer", {} },
+		{ "producer:GenParticleProducer", {} },
+		{ "producer:GenPartonCounterProducer", {} },
+		{ "producer:GenTauDecayProducer", {} },
+		{ "producer:GeneratorWeightProducer", {} },
+		{ "producer:HltProducer", {} },
+		{ "producer:MatchedLeptonsProducer", {} },
+		{ "producer:MuonTriggerMatchingProducer", {} },
+		{ "producer:NicknameProducer", {} },
+		{ "producer:NumberGeneratedEventsWeightProducer", {} },
+		{ "producer:PUWeightProducer", {} },
+		{ "producer:RecoElectronGenParticleMatchingProducer", {} },
+		{ "producer:RecoElectronGenTauMatchingProducer", {} },
+		{ "producer:RecoMuonGenParticleMatchingProducer", {} },
+		{ "producer:RecoMuonGenTauMatchingProducer", {} },
+		{ "producer:RecoTauGenParticleMatchingProducer", {} },
+		{ "producer:RecoTauGenTauMatchingProducer", {} },
+		{ "producer:TauTriggerMatchingProducer", {} },
+		{ "producer:ValidGenTausProducer", {} },
+		{ "producer:ZmmProducer", {} },
+		{ "filter:HltFilter", {} },
+		{ "filter:JsonFilter", {} },
+		{ "filter:MinElectronsCountFilter", {} },
+		{ "filter:MinMuonsCountFilter", {} },
+		{ "filter:MinTausCountFilter", {} },
+		{ "filter:RunLumiEventFilter", {} },
+		{ "filter:ValidElectronsFilter", {} },
+		{ "filter:ValidMuonsFilter", {} },
+		{ "filter:ValidTausFilter", {} },
+		{ "filter:ZFilter", {} }
+	};
+	std::map<std::string, std::vector<std::string> >::const_iterator declaration = declarations.find(processorId);
+	return ((declaration != declarations.end()) ? &(declaration->second) : nullptr);
+}
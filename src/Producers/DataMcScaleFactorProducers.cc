@@ -2,6 +2,7 @@
 #include <vector>
 #include <numeric>
 #include <functional>
+#include <sstream>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -12,6 +13,67 @@
 #include "Artus/Utility/interface/SafeMap.h"
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/DataMcScaleFactorProducers.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/CorrectionSnapshot.h"
+
+
+namespace
+{
+	template<class TKey>
+	void CollectSnapshotInputs(std::string const& prefix, std::map<TKey, std::vector<std::string> > const& files,
+	                           std::vector<std::string>& inputFiles, std::vector<std::string>& objectNames)
+	{
+		for (typename std::map<TKey, std::vector<std::string> >::const_iterator key = files.begin(); key != files.end(); ++key)
+		{
+			for (size_t index = 0; index < key->second.size(); ++index)
+			{
+				std::ostringstream objectName;
+				objectName << prefix << "/" << key->first << "/" << index;
+				inputFiles.push_back(key->second[index]);
+				objectNames.push_back(objectName.str());
+			}
+		}
+	}
+	
+	// bin contents from the mapped snapshot if available, otherwise from the histograms in the ROOT files
+	template<class TKey>
+	std::map<TKey, std::vector<CorrectionSnapshot::BinnedLookup> > GetEfficiencyMap(std::string const& prefix,
+	                                                                              std::map<TKey, std::vector<std::string> > const& files,
+	                                                                              std::string const& histogramName,
+	                                                                              CorrectionSnapshot& snapshot)
+	{
+		std::map<TKey, std::vector<CorrectionSnapshot::BinnedLookup> > lookups;
+		if (snapshot.IsLoaded())
+		{
+			for (typename std::map<TKey, std::vector<std::string> >::const_iterator key = files.begin(); key != files.end(); ++key)
+			{
+				for (size_t index = 0; index < key->second.size(); ++index)
+				{
+					std::ostringstream objectName;
+					objectName << prefix << "/" << key->first << "/" << index;
+					lookups[key->first].push_back(snapshot.GetBinnedLookup(objectName.str()));
+				}
+			}
+		}
+		else
+		{
+			std::map<TKey, std::vector<TH2F*> > histograms = RootFileHelper::SafeGetMap<TKey, TH2F>(files, histogramName);
+			for (typename std::map<TKey, std::vector<TH2F*> >::const_iterator key = histograms.begin(); key != histograms.end(); ++key)
+			{
+				for (size_t index = 0; index < key->second.size(); ++index)
+				{
+					lookups[key->first].push_back(CorrectionSnapshot::BinnedLookup(key->second[index]));
+					if (snapshot.IsEnabled())
+					{
+						std::ostringstream objectName;
+						objectName << prefix << "/" << key->first << "/" << index;
+						snapshot.AddHistogram(objectName.str(), key->second[index]);
+					}
+				}
+			}
+		}
+		return lookups;
+	}
+}
 
 
 DataMcScaleFactorProducerBase::DataMcScaleFactorProducerBase(
@@ -34,19 +96,12 @@ void DataMcScaleFactorProducerBase::Init(setting_type const& settings)
 	ProducerBase<HttTypes>::Init(settings);
 	
 	// parse settings for efficiency files
-	// and read the histograms from the files
 	// Data
 	std::map<std::string, std::vector<std::string> > efficiencyFilesDataByHltName;
 	std::map<size_t, std::vector<std::string> > efficiencyFilesDataByIndex = Utility::ParseMapTypes<size_t, std::string>(
 			Utility::ParseVectorToMap((settings.*GetEfficiencyData)()),
 			efficiencyFilesDataByHltName
 	);
-	efficienciesDataByHltName = RootFileHelper::SafeGetMap<std::string, TH2F>(
-			efficiencyFilesDataByHltName, (settings.*GetEfficiencyHistogram)()
-	);
-	efficienciesDataByIndex = RootFileHelper::SafeGetMap<size_t, TH2F>(
-			efficiencyFilesDataByIndex, (settings.*GetEfficiencyHistogram)()
-	);
 	
 	// MC
 	std::map<std::string, std::vector<std::string> > efficiencyFilesMcByHltName;
@@ -54,12 +109,26 @@ void DataMcScaleFactorProducerBase::Init(setting_type const& settings)
 			Utility::ParseVectorToMap((settings.*GetEfficiencyMc)()),
 			efficiencyFilesMcByHltName
 	);
-	efficienciesMcByHltName = RootFileHelper::SafeGetMap<std::string, TH2F>(
-			efficiencyFilesMcByHltName, (settings.*GetEfficiencyHistogram)()
-	);
-	efficienciesMcByIndex = RootFileHelper::SafeGetMap<size_t, TH2F>(
-			efficiencyFilesMcByIndex, (settings.*GetEfficiencyHistogram)()
-	);
+	
+	// read the histograms from the files or from a previously written snapshot of them
+	std::string histogramName = (settings.*GetEfficiencyHistogram)();
+	std::vector<std::string> inputFiles;
+	std::vector<std::string> objectNames(1, histogramName);
+	CollectSnapshotInputs("dataByHltName", efficiencyFilesDataByHltName, inputFiles, objectNames);
+	CollectSnapshotInputs("dataByIndex", efficiencyFilesDataByIndex, inputFiles, objectNames);
+	CollectSnapshotInputs("mcByHltName", efficiencyFilesMcByHltName, inputFiles, objectNames);
+	CollectSnapshotInputs("mcByIndex", efficiencyFilesMcByIndex, inputFiles, objectNames);
+	m_snapshot.reset(new CorrectionSnapshot(settings.GetCorrectionSnapshotDirectory(), GetProducerId(), inputFiles, objectNames));
+	
+	efficienciesDataByHltName = GetEfficiencyMap("dataByHltName", efficiencyFilesDataByHltName, histogramName, *m_snapshot);
+	efficienciesDataByIndex = GetEfficiencyMap("dataByIndex", efficiencyFilesDataByIndex, histogramName, *m_snapshot);
+	efficienciesMcByHltName = GetEfficiencyMap("mcByHltName", efficiencyFilesMcByHltName, histogramName, *m_snapshot);
+	efficienciesMcByIndex = GetEfficiencyMap("mcByIndex", efficiencyFilesMcByIndex, histogramName, *m_snapshot);
+	
+	if (m_snapshot->IsEnabled() && (! m_snapshot->IsLoaded()))
+	{
+		m_snapshot->Write();
+	}
 	
 	m_scaleFactorMode =  HttEnumTypes::ToDataMcScaleFactorProducerMode(boost::algorithm::to_lower_copy(boost::algorithm::trim_copy((settings.*GetEfficiencyMode)())));
 	
@@ -67,14 +136,14 @@ void DataMcScaleFactorProducerBase::Init(setting_type const& settings)
 	assert(efficienciesDataByHltName.size() == efficienciesMcByHltName.size());
 	assert(efficienciesDataByIndex.size() == efficienciesMcByIndex.size());
 	
-	for (std::map<std::string, std::vector<TH2F*> >::const_iterator efficiencyDataByHltName = efficienciesDataByHltName.begin();
+	for (std::map<std::string, std::vector<CorrectionSnapshot::BinnedLookup> >::const_iterator efficiencyDataByHltName = efficienciesDataByHltName.begin();
 	     efficiencyDataByHltName != efficienciesDataByHltName.end();
 	     ++efficiencyDataByHltName)
 	{
 		assert(efficienciesMcByHltName.count(efficiencyDataByHltName->first) > 0);
 	}
 	
-	for (std::map<size_t, std::vector<TH2F*> >::const_iterator efficiencyDataByIndex = efficienciesDataByIndex.begin();
+	for (std::map<size_t, std::vector<CorrectionSnapshot::BinnedLookup> >::const_iterator efficiencyDataByIndex = efficienciesDataByIndex.begin();
 	     efficiencyDataByIndex != efficienciesDataByIndex.end();
 	     ++efficiencyDataByIndex)
 	{
@@ -138,14 +207,13 @@ void DataMcScaleFactorProducerBase::Produce(event_type const& event, product_typ
 
 // return linear interpolation between bin contents of neighboring bins
 std::vector<double> DataMcScaleFactorProducerBase::GetEfficienciesFromHistograms(
-		std::vector<TH2F*> const& histograms,
+		std::vector<CorrectionSnapshot::BinnedLookup> const& histograms,
 		KLepton* lepton) const
 {
 	std::vector<double> efficiencies;
-	for (std::vector<TH2F*>::const_iterator histogram = histograms.begin();
+	for (std::vector<CorrectionSnapshot::BinnedLookup>::const_iterator histogram = histograms.begin();
 	     histogram != histograms.end(); ++histogram)
 	{
-		int globalBin = (*histogram)->FindBin(lepton->p4.Pt(), lepton->p4.Eta());
 // 		int xBin, yBin, zBin;
 // 		(*histogram)->GetBinXYZ(globalBin, xBin, yBin, zBin);
 // 		int globalBinUp = (*histogram)->GetBin((xBin <= (*histogram)->GetNbinsX() ? xBin+1 : xBin), yBin, zBin);
@@ -158,7 +226,7 @@ std::vector<double> DataMcScaleFactorProducerBase::GetEfficienciesFromHistograms
 // 		float linearInterpolation = (binContent * interpolationFactor) + (binContentUp * (1.0 - interpolationFactor));
 		
 // 		efficiencies.push_back((linearInterpolation);
-		efficiencies.push_back((*histogram)->GetBinContent(globalBin));
+		efficiencies.push_back(histogram->GetBinContent(lepton->p4.Pt(), lepton->p4.Eta()));
 		
 	}
 	return efficiencies;
@@ -166,14 +234,14 @@ std::vector<double> DataMcScaleFactorProducerBase::GetEfficienciesFromHistograms
 
 
 std::vector<std::vector<double> > DataMcScaleFactorProducerBase::GetEfficiencies(
-		std::map<std::string, std::vector<TH2F*> > const& efficienciesByHltName,
-		std::map<size_t, std::vector<TH2F*> > const& efficienciesByIndex,
+		std::map<std::string, std::vector<CorrectionSnapshot::BinnedLookup> > const& efficienciesByHltName,
+		std::map<size_t, std::vector<CorrectionSnapshot::BinnedLookup> > const& efficienciesByIndex,
 		event_type const& event, product_type const& product, setting_type const& settings) const
 {
 	std::vector<std::vector<double> > efficiencies(efficienciesByHltName.size() + efficienciesByIndex.size(), std::vector<double>());
 	size_t index = 0;
 	
-	for (std::map<std::string, std::vector<TH2F*> >::const_iterator efficiencyByHltName = efficienciesByHltName.begin();
+	for (std::map<std::string, std::vector<CorrectionSnapshot::BinnedLookup> >::const_iterator efficiencyByHltName = efficienciesByHltName.begin();
 	     efficiencyByHltName != efficienciesByHltName.end();
 	     ++efficiencyByHltName)
 	{
@@ -217,7 +285,7 @@ std::vector<std::vector<double> > DataMcScaleFactorProducerBase::GetEfficiencies
 		}
 	}
 	
-	for (std::map<size_t, std::vector<TH2F*> >::const_iterator efficiencyByIndex = efficienciesByIndex.begin();
+	for (std::map<size_t, std::vector<CorrectionSnapshot::BinnedLookup> >::const_iterator efficiencyByIndex = efficienciesByIndex.begin();
 	     efficiencyByIndex != efficienciesByIndex.end();
 	     ++efficiencyByIndex)
 	{
@@ -1,4 +1,6 @@
 
+#include <memory>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
 
@@ -9,6 +11,7 @@
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEnumTypes.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/DecayChannelProducer.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/Quantities.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/KappaMetadataBinding.h"
 #include "Artus/KappaAnalysis/interface/Utility/GeneratorInfo.h"
 
 
@@ -129,47 +132,47 @@ void DecayChannelProducer::Init(setting_type const& settings)
 	
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("leadingGenMatchedTauLV", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_ptOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::PT, 0).genTau;
 		return (genTau ? genTau->p4 : DefaultValues::UndefinedRMFLV);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("genMatchedTau1LV", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_flavourOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::FLAVOUR, 0).genTau;
 		return (genTau ? genTau->p4 : DefaultValues::UndefinedRMFLV);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("posGenMatchedTauLV", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_chargeOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::CHARGE, 0).genTau;
 		return (genTau ? genTau->p4 : DefaultValues::UndefinedRMFLV);
 	});
 	
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("leadingGenMatchedTauVisibleLV", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_ptOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::PT, 0).genTau;
 		return (genTau ? genTau->visible.p4 : DefaultValues::UndefinedRMFLV);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("genMatchedTau1VisibleLV", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_flavourOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::FLAVOUR, 0).genTau;
 		return (genTau ? genTau->visible.p4 : DefaultValues::UndefinedRMFLV);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("posGenMatchedTauVisibleLV", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_chargeOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::CHARGE, 0).genTau;
 		return (genTau ? genTau->visible.p4 : DefaultValues::UndefinedRMFLV);
 	});
 	
 	LambdaNtupleConsumer<HttTypes>::AddBoolQuantity("leadingGenMatchedTauFound", [](event_type const& event, product_type const& product)
 	{
-		return Utility::Contains(product.m_genTauMatchedLeptons, product.m_ptOrderedLeptons.at(0));
+		return product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::PT, 0).genTauMatched;
 	});
 	LambdaNtupleConsumer<HttTypes>::AddBoolQuantity("genMatchedTau1Found", [](event_type const& event, product_type const& product)
 	{
-		return Utility::Contains(product.m_genTauMatchedLeptons, product.m_flavourOrderedLeptons.at(0));
+		return product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::FLAVOUR, 0).genTauMatched;
 	});
 	LambdaNtupleConsumer<HttTypes>::AddBoolQuantity("posGenMatchedTauFound", [](event_type const& event, product_type const& product)
 	{
-		return Utility::Contains(product.m_genTauMatchedLeptons, product.m_chargeOrderedLeptons.at(0));
+		return product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::CHARGE, 0).genTauMatched;
 	});
 	
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("trailingGenMatchedLepLV", [](event_type const& event, product_type const& product)
@@ -200,47 +203,47 @@ void DecayChannelProducer::Init(setting_type const& settings)
 	
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("trailingGenMatchedTauLV", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_ptOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::PT, 1).genTau;
 		return (genTau ? genTau->p4 : DefaultValues::UndefinedRMFLV);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("genMatchedTau2LV", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_flavourOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::FLAVOUR, 1).genTau;
 		return (genTau ? genTau->p4 : DefaultValues::UndefinedRMFLV);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("negGenMatchedTauLV", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_chargeOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::CHARGE, 1).genTau;
 		return (genTau ? genTau->p4 : DefaultValues::UndefinedRMFLV);
 	});
 	
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("trailingGenMatchedTauVisibleLV", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_ptOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::PT, 1).genTau;
 		return (genTau ? genTau->visible.p4 : DefaultValues::UndefinedRMFLV);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("genMatchedTau2VisibleLV", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_flavourOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::FLAVOUR, 1).genTau;
 		return (genTau ? genTau->visible.p4 : DefaultValues::UndefinedRMFLV);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("negGenMatchedTauVisibleLV", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_chargeOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::CHARGE, 1).genTau;
 		return (genTau ? genTau->visible.p4 : DefaultValues::UndefinedRMFLV);
 	});
 	
 	LambdaNtupleConsumer<HttTypes>::AddBoolQuantity("trailingGenMatchedTauFound", [](event_type const& event, product_type const& product)
 	{
-		return Utility::Contains(product.m_genTauMatchedLeptons, product.m_ptOrderedLeptons.at(1));
+		return product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::PT, 1).genTauMatched;
 	});
 	LambdaNtupleConsumer<HttTypes>::AddBoolQuantity("genMatchedTau2Found", [](event_type const& event, product_type const& product)
 	{
-		return Utility::Contains(product.m_genTauMatchedLeptons, product.m_flavourOrderedLeptons.at(1));
+		return product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::FLAVOUR, 1).genTauMatched;
 	});
 	LambdaNtupleConsumer<HttTypes>::AddBoolQuantity("negGenMatchedTauFound", [](event_type const& event, product_type const& product)
 	{
-		return Utility::Contains(product.m_genTauMatchedLeptons, product.m_chargeOrderedLeptons.at(1));
+		return product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::CHARGE, 1).genTauMatched;
 	});
 	
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("leadingLepCharge", [](event_type const& event, product_type const& product)
@@ -361,49 +364,49 @@ void DecayChannelProducer::Init(setting_type const& settings)
 	
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("leadingGenMatchedTauDecayMode", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_ptOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::PT, 0).genTau;
 		return (genTau ? genTau->decayMode : DefaultValues::UndefinedInt);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("genMatchedTau1DecayMode", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_flavourOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::FLAVOUR, 0).genTau;
 		return (genTau ? genTau->decayMode : DefaultValues::UndefinedInt);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("posGenMatchedTauDecayMode", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_chargeOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::CHARGE, 0).genTau;
 		return (genTau ? genTau->decayMode : DefaultValues::UndefinedInt);
 	});
 	
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("leadingGenMatchedTauNProngs", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_ptOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::PT, 0).genTau;
 		return (genTau ? genTau->nProngs : DefaultValues::UndefinedInt);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("genMatchedTau1NProngs", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_flavourOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::FLAVOUR, 0).genTau;
 		return (genTau ? genTau->nProngs : DefaultValues::UndefinedInt);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("posGenMatchedTauNProngs", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_chargeOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::CHARGE, 0).genTau;
 		return (genTau ? genTau->nProngs : DefaultValues::UndefinedInt);
 	});
 	
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("leadingGenMatchedTauNPi0s", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_ptOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::PT, 0).genTau;
 		return (genTau ? genTau->nPi0s : DefaultValues::UndefinedInt);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("genMatchedTau1NPi0s", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_flavourOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::FLAVOUR, 0).genTau;
 		return (genTau ? genTau->nPi0s : DefaultValues::UndefinedInt);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("posGenMatchedTauNPi0s", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_chargeOrderedLeptons.at(0), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::CHARGE, 0).genTau;
 		return (genTau ? genTau->nPi0s : DefaultValues::UndefinedInt);
 	});
 
@@ -509,49 +512,49 @@ void DecayChannelProducer::Init(setting_type const& settings)
 	
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("trailingGenMatchedTauDecayMode", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_ptOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::PT, 1).genTau;
 		return (genTau ? genTau->decayMode : DefaultValues::UndefinedInt);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("genMatchedTau2DecayMode", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_flavourOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::FLAVOUR, 1).genTau;
 		return (genTau ? genTau->decayMode : DefaultValues::UndefinedInt);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("negGenMatchedTauDecayMode", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_chargeOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::CHARGE, 1).genTau;
 		return (genTau ? genTau->decayMode : DefaultValues::UndefinedInt);
 	});
 	
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("trailingGenMatchedTauNProngs", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_ptOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::PT, 1).genTau;
 		return (genTau ? genTau->nProngs : DefaultValues::UndefinedInt);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("genMatchedTau2NProngs", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_flavourOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::FLAVOUR, 1).genTau;
 		return (genTau ? genTau->nProngs : DefaultValues::UndefinedInt);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("negGenMatchedTauNProngs", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_chargeOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::CHARGE, 1).genTau;
 		return (genTau ? genTau->nProngs : DefaultValues::UndefinedInt);
 	});
 	
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("trailingGenMatchedTauNPi0s", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_ptOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::PT, 1).genTau;
 		return (genTau ? genTau->nPi0s : DefaultValues::UndefinedInt);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("genMatchedTau2NPi0s", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_flavourOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::FLAVOUR, 1).genTau;
 		return (genTau ? genTau->nPi0s : DefaultValues::UndefinedInt);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("negGenMatchedTauNPi0s", [](event_type const& event, product_type const& product)
 	{
-		KGenTau* genTau = SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, product.m_chargeOrderedLeptons.at(1), static_cast<KGenTau*>(nullptr));
+		KGenTau* genTau = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::CHARGE, 1).genTau;
 		return (genTau ? genTau->nPi0s : DefaultValues::UndefinedInt);
 	});
 	
@@ -613,17 +616,21 @@ void DecayChannelProducer::Init(setting_type const& settings)
 	
 	
 
+	// the positions of the discriminators in the metadata are resolved once per lumi section
+	std::shared_ptr<TauDiscriminatorBinding> tauDiscriminatorBinding = std::make_shared<TauDiscriminatorBinding>();
+
 	for (size_t leptonIndex = 0; leptonIndex < 2; ++leptonIndex)
 	{
 		for (std::string tauDiscriminator : tauDiscriminators)
 		{
 			std::string quantity = tauDiscriminator + "_" + std::to_string(leptonIndex+1);
-			LambdaNtupleConsumer<HttTypes>::AddFloatQuantity(quantity, [tauDiscriminator, leptonIndex](event_type const& event, product_type const& product)
+			size_t discriminatorHandle = tauDiscriminatorBinding->Register(tauDiscriminator);
+			LambdaNtupleConsumer<HttTypes>::AddFloatQuantity(quantity, [tauDiscriminatorBinding, discriminatorHandle, leptonIndex](event_type const& event, product_type const& product)
 			{
 				KLepton* lepton = product.m_flavourOrderedLeptons.at(leptonIndex);
 				if (lepton->flavour() == KLeptonFlavour::TAU)
 				{
-					return static_cast<KTau*>(lepton)->getDiscriminator(tauDiscriminator, event.m_tauMetadata);
+					return tauDiscriminatorBinding->GetDiscriminator(static_cast<KTau*>(lepton), discriminatorHandle, event.m_tauMetadata, event.m_eventInfo);
 				}
 				else
 				{
@@ -652,8 +659,7 @@ void DecayChannelProducer::Init(setting_type const& settings)
 		{
 			if (useUWGenMatching)
 			{
-				KLepton* lepton = product.m_flavourOrderedLeptons.at(leptonIndex);
-				KLepton* originalLepton = const_cast<KLepton*>(SafeMap::GetWithDefault(product.m_originalLeptons, const_cast<const KLepton*>(lepton), const_cast<const KLepton*>(lepton)));
+				KLepton* originalLepton = product.m_leptonPair.GetLeg(LeptonPairDescriptor::Ordering::FLAVOUR, leptonIndex).originalLepton;
 				return Utility::ToUnderlyingValue(GeneratorInfo::GetGenMatchingCodeUW(event, originalLepton));
 			}
 			else
@@ -764,74 +770,69 @@ void DecayChannelProducer::Produce(event_type const& event, product_type& produc
 		}
 	}
 
+	product.m_leptonPair.Clear();
 	if (product.m_decayChannel != HttEnumTypes::DecayChannel::NONE)
 	{
+		product.m_leptonPair.AddLeg(lepton1);
+		product.m_leptonPair.AddLeg(lepton2);
 
-		// fill leptons ordered by pt (high pt first)
-		if (lepton1->p4.Pt() >= lepton2->p4.Pt())
+		// leptons ordered by pt (high pt first)
+		if (lepton1->p4.Pt() < lepton2->p4.Pt())
 		{
-			product.m_ptOrderedLeptons.push_back(lepton1);
-			product.m_ptOrderedLeptons.push_back(lepton2);
-		}
-		else
-		{
-			product.m_ptOrderedLeptons.push_back(lepton2);
-			product.m_ptOrderedLeptons.push_back(lepton1);
+			product.m_leptonPair.SetPermutation(LeptonPairDescriptor::Ordering::PT, 1, 0);
 		}
 
-		// fill leptons ordered by flavour (according to channel definition)
-		product.m_flavourOrderedLeptons.push_back(lepton1);
-		product.m_flavourOrderedLeptons.push_back(lepton2);
+		// leptons ordered by flavour (according to channel definition): order of the legs
 
-		// fill leptons ordered by charge (positive charges first)
-		if (lepton1->charge() >= lepton2->charge())
-		{
-			product.m_chargeOrderedLeptons.push_back(lepton1);
-			product.m_chargeOrderedLeptons.push_back(lepton2);
-		}
-		else
+		// leptons ordered by charge (positive charges first)
+		if (lepton1->charge() < lepton2->charge())
 		{
-			product.m_chargeOrderedLeptons.push_back(lepton2);
-			product.m_chargeOrderedLeptons.push_back(lepton1);
+			product.m_leptonPair.SetPermutation(LeptonPairDescriptor::Ordering::CHARGE, 1, 0);
 		}
 	}
 	
-	FillGenLeptonCollections(product);
+	FillLeptonCollections(product);
 }
 
-void DecayChannelProducer::FillGenLeptonCollections(product_type& product) const
+void DecayChannelProducer::FillLeptonCollections(product_type& product) const
 {
-	product.m_ptOrderedGenLeptons.clear();
-	for (std::vector<KLepton*>::iterator lepton = product.m_ptOrderedLeptons.begin();
-	     lepton != product.m_ptOrderedLeptons.end(); ++lepton)
-	{
-		KLepton* originalLepton = const_cast<KLepton*>(SafeMap::GetWithDefault(product.m_originalLeptons, const_cast<const KLepton*>(*lepton), const_cast<const KLepton*>(*lepton)));
-		product.m_ptOrderedGenLeptons.push_back(GeneratorInfo::GetGenMatchedParticle(
-				originalLepton, product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons
-		));
-		product.m_ptOrderedGenLeptonVisibleLVs.push_back(GeneratorInfo::GetVisibleLV(product.m_ptOrderedGenLeptons.back()));
-	}
-	
-	product.m_flavourOrderedGenLeptons.clear();
-	for (std::vector<KLepton*>::iterator lepton = product.m_flavourOrderedLeptons.begin();
-	     lepton != product.m_flavourOrderedLeptons.end(); ++lepton)
-	{
-		KLepton* originalLepton = const_cast<KLepton*>(SafeMap::GetWithDefault(product.m_originalLeptons, const_cast<const KLepton*>(*lepton), const_cast<const KLepton*>(*lepton)));
-		product.m_flavourOrderedGenLeptons.push_back(GeneratorInfo::GetGenMatchedParticle(
-				originalLepton, product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons
-		));
-		product.m_flavourOrderedGenLeptonVisibleLVs.push_back(GeneratorInfo::GetVisibleLV(product.m_flavourOrderedGenLeptons.back()));
+	LeptonPairDescriptor& leptonPair = product.m_leptonPair;
+
+	// lookups in the maps of the product only once per leg
+	for (size_t legIndex = 0; legIndex < leptonPair.GetNLegs(); ++legIndex)
+	{
+		LeptonPairDescriptor::Leg& leg = leptonPair.GetLeg(legIndex);
+		leg.originalLepton = const_cast<KLepton*>(SafeMap::GetWithDefault(product.m_originalLeptons, const_cast<const KLepton*>(leg.lepton), const_cast<const KLepton*>(leg.lepton)));
+		leg.genParticle = GeneratorInfo::GetGenMatchedParticle(
+				leg.originalLepton, product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons
+		);
+		leg.genVisibleLV = GeneratorInfo::GetVisibleLV(leg.genParticle);
+
+		leg.genTauMatched = Utility::Contains(product.m_genTauMatchedLeptons, leg.lepton);
+		leg.genTau = (leg.genTauMatched ? SafeMap::GetWithDefault(product.m_genTauMatchedLeptons, leg.lepton, static_cast<KGenTau*>(nullptr)) : nullptr);
 	}
-	
-	product.m_chargeOrderedGenLeptons.clear();
-	for (std::vector<KLepton*>::iterator lepton = product.m_chargeOrderedLeptons.begin();
-	     lepton != product.m_chargeOrderedLeptons.end(); ++lepton)
-	{
-		KLepton* originalLepton = const_cast<KLepton*>(SafeMap::GetWithDefault(product.m_originalLeptons, const_cast<const KLepton*>(*lepton), const_cast<const KLepton*>(*lepton)));
-		product.m_chargeOrderedGenLeptons.push_back(GeneratorInfo::GetGenMatchedParticle(
-				originalLepton, product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons
-		));
-		product.m_chargeOrderedGenLeptonVisibleLVs.push_back(GeneratorInfo::GetVisibleLV(product.m_chargeOrderedGenLeptons.back()));
+
+	std::vector<KLepton*>* orderedLeptons[LeptonPairDescriptor::nOrderings] = {
+			&product.m_ptOrderedLeptons, &product.m_flavourOrderedLeptons, &product.m_chargeOrderedLeptons
+	};
+	std::vector<KGenParticle*>* orderedGenLeptons[LeptonPairDescriptor::nOrderings] = {
+			&product.m_ptOrderedGenLeptons, &product.m_flavourOrderedGenLeptons, &product.m_chargeOrderedGenLeptons
+	};
+	std::vector<RMFLV*>* orderedGenLeptonVisibleLVs[LeptonPairDescriptor::nOrderings] = {
+			&product.m_ptOrderedGenLeptonVisibleLVs, &product.m_flavourOrderedGenLeptonVisibleLVs, &product.m_chargeOrderedGenLeptonVisibleLVs
+	};
+	for (size_t ordering = 0; ordering < LeptonPairDescriptor::nOrderings; ++ordering)
+	{
+		orderedLeptons[ordering]->clear();
+		orderedGenLeptons[ordering]->clear();
+		orderedGenLeptonVisibleLVs[ordering]->clear();
+		for (size_t position = 0; position < leptonPair.GetNLegs(); ++position)
+		{
+			LeptonPairDescriptor::Leg const& leg = leptonPair.GetLeg(static_cast<LeptonPairDescriptor::Ordering>(ordering), position);
+			orderedLeptons[ordering]->push_back(leg.lepton);
+			orderedGenLeptons[ordering]->push_back(leg.genParticle);
+			orderedGenLeptonVisibleLVs[ordering]->push_back(leg.genVisibleLV);
+		}
 	}
 }
 
@@ -880,35 +881,30 @@ void TTHDecayChannelProducer::Produce(event_type const& event, product_type& pro
 		}
 	}
 
+	product.m_leptonPair.Clear();
 	if (product.m_decayChannel != HttEnumTypes::DecayChannel::NONE)
 	{
-		// fill leptons ordered by pt (high pt first)
-		product.m_ptOrderedLeptons.push_back(lepton1);
-		product.m_ptOrderedLeptons.push_back(lepton2);
-		product.m_ptOrderedLeptons.push_back(lepton3);
+		product.m_leptonPair.AddLeg(lepton1);
+		product.m_leptonPair.AddLeg(lepton2);
+		product.m_leptonPair.AddLeg(lepton3);
+		LeptonPairDescriptor const& leptonPair = product.m_leptonPair;
 
-		std::sort(product.m_ptOrderedLeptons.begin(), product.m_ptOrderedLeptons.end(),
-	          [](KLepton const* lepton1, KLepton const* lepton2) -> bool
-	          { return lepton1->p4.Pt() > lepton2->p4.Pt(); });
+		// leptons ordered by pt (high pt first)
+		size_t* ptPermutation = product.m_leptonPair.GetPermutation(LeptonPairDescriptor::Ordering::PT);
+		std::sort(ptPermutation, ptPermutation + leptonPair.GetNLegs(),
+	          [&leptonPair](size_t legIndex1, size_t legIndex2) -> bool
+	          { return leptonPair.GetLeg(legIndex1).lepton->p4.Pt() > leptonPair.GetLeg(legIndex2).lepton->p4.Pt(); });
 
+		// leptons ordered by flavour (according to channel definition): order of the legs
 
-		// fill leptons ordered by flavour (according to channel definition)
-		product.m_flavourOrderedLeptons.push_back(lepton1);
-		product.m_flavourOrderedLeptons.push_back(lepton2);
-		product.m_flavourOrderedLeptons.push_back(lepton3);
-
-
-		// fill leptons ordered by charge (positive charges first)
-		product.m_chargeOrderedLeptons.push_back(lepton1);
-		product.m_chargeOrderedLeptons.push_back(lepton2);
-		product.m_chargeOrderedLeptons.push_back(lepton3);
-
-		std::sort(product.m_chargeOrderedLeptons.begin(), product.m_chargeOrderedLeptons.end(),
-	          [](KLepton const* lepton1, KLepton const* lepton2) -> bool
-	          { return lepton1->charge() > lepton2->charge(); });
+		// leptons ordered by charge (positive charges first)
+		size_t* chargePermutation = product.m_leptonPair.GetPermutation(LeptonPairDescriptor::Ordering::CHARGE);
+		std::sort(chargePermutation, chargePermutation + leptonPair.GetNLegs(),
+	          [&leptonPair](size_t legIndex1, size_t legIndex2) -> bool
+	          { return leptonPair.GetLeg(legIndex1).lepton->charge() > leptonPair.GetLeg(legIndex2).lepton->charge(); });
 	}
 	
-	FillGenLeptonCollections(product);
+	FillLeptonCollections(product);
 }
 
 void Run2DecayChannelProducer::Init(setting_type const& settings)
@@ -939,55 +935,32 @@ void Run2DecayChannelProducer::Produce(event_type const& event, product_type& pr
 	KLepton* lepton1 = static_cast<KLepton*>(diTauPair.first);
 	KLepton* lepton2 = static_cast<KLepton*>(diTauPair.second);
 
-	// fill leptons ordered by pt (high pt first)
-	if (lepton1->p4.Pt() >= lepton2->p4.Pt())
-	{
-		product.m_ptOrderedLeptons.push_back(lepton1);
-		product.m_ptOrderedLeptons.push_back(lepton2);
-	}
-	else
-	{
-		product.m_ptOrderedLeptons.push_back(lepton2);
-		product.m_ptOrderedLeptons.push_back(lepton1);
-	}
+	product.m_leptonPair.Clear();
+	product.m_leptonPair.AddLeg(lepton1);
+	product.m_leptonPair.AddLeg(lepton2);
 
-	// fill leptons ordered by charge (positive charges first)
-	if (lepton1->charge() >= lepton2->charge())
-	{
-		product.m_chargeOrderedLeptons.push_back(lepton1);
-		product.m_chargeOrderedLeptons.push_back(lepton2);
-	}
-	else
+	// leptons ordered by pt (high pt first)
+	bool ptSwapped = (lepton1->p4.Pt() < lepton2->p4.Pt());
+	if (ptSwapped)
 	{
-		product.m_chargeOrderedLeptons.push_back(lepton2);
-		product.m_chargeOrderedLeptons.push_back(lepton1);
+		product.m_leptonPair.SetPermutation(LeptonPairDescriptor::Ordering::PT, 1, 0);
 	}
 
-	// fill leptons ordered by flavour (according to channel definition)
-	if (m_decayChannel == HttEnumTypes::DecayChannel::EM)
+	// leptons ordered by charge (positive charges first)
+	if (lepton1->charge() < lepton2->charge())
 	{
-		product.m_flavourOrderedLeptons.push_back(lepton2);
-		product.m_flavourOrderedLeptons.push_back(lepton1);
-	}
-	else if (m_decayChannel == HttEnumTypes::DecayChannel::TT || m_decayChannel == HttEnumTypes::DecayChannel::MM)
-	{
-		if (lepton1->p4.Pt() >= lepton2->p4.Pt())
-		{
-			product.m_flavourOrderedLeptons.push_back(lepton1);
-			product.m_flavourOrderedLeptons.push_back(lepton2);
-		}
-		else
-		{
-			product.m_flavourOrderedLeptons.push_back(lepton2);
-			product.m_flavourOrderedLeptons.push_back(lepton1);
-		}
+		product.m_leptonPair.SetPermutation(LeptonPairDescriptor::Ordering::CHARGE, 1, 0);
 	}
-	else
+
+	// leptons ordered by flavour (according to channel definition)
+	if ((m_decayChannel == HttEnumTypes::DecayChannel::EM) ||
+	    (((m_decayChannel == HttEnumTypes::DecayChannel::TT) || (m_decayChannel == HttEnumTypes::DecayChannel::MM)) && ptSwapped))
 	{
-		product.m_flavourOrderedLeptons.push_back(lepton1);
-		product.m_flavourOrderedLeptons.push_back(lepton2);
+		product.m_leptonPair.SetPermutation(LeptonPairDescriptor::Ordering::FLAVOUR, 1, 0);
 	}
 
+	FillLeptonCollections(product);
+
 	// update valid leptons list with the leptons from the chosen pair: necessary for jet overlap removal
 	product.m_validLeptons.clear();
 	bool electronsCleared = false;
@@ -1028,36 +1001,34 @@ void Run2DecayChannelProducer::Produce(event_type const& event, product_type& pr
 	}
 
 	// clean loose electrons/muons from signal electrons/muons
+	// (matched by the address of the object or of the uncorrected object, otherwise by the four-vector)
+	m_signalElectronIndex.Clear();
+	for (std::vector<KElectron*>::const_iterator electron = product.m_validElectrons.begin();
+	     electron != product.m_validElectrons.end(); ++electron)
+	{
+		m_signalElectronIndex.Add((*electron)->p4, static_cast<const KLepton*>(*electron));
+		m_signalElectronIndex.AddIdentity(SafeMap::GetWithDefault(product.m_originalLeptons, static_cast<const KLepton*>(*electron), static_cast<const KLepton*>(nullptr)));
+	}
+	m_signalMuonIndex.Clear();
+	for (std::vector<KMuon*>::const_iterator muon = product.m_validMuons.begin();
+	     muon != product.m_validMuons.end(); ++muon)
+	{
+		m_signalMuonIndex.Add((*muon)->p4, static_cast<const KLepton*>(*muon));
+		m_signalMuonIndex.AddIdentity(SafeMap::GetWithDefault(product.m_originalLeptons, static_cast<const KLepton*>(*muon), static_cast<const KLepton*>(nullptr)));
+	}
+
 	std::vector<KElectron*> looseElectrons;
 	for (std::vector<KElectron*>::iterator looseElectron = product.m_validLooseElectrons.begin();
 		 looseElectron != product.m_validLooseElectrons.end(); ++looseElectron)
 	{
-		bool looseElectronAlsoSignalElectron = false;
-		for (std::vector<KElectron*>::iterator electron = product.m_validElectrons.begin();
-			 electron != product.m_validElectrons.end(); ++electron)
-		{
-			if ((*looseElectron)->p4 == (*electron)->p4)
-			{
-				looseElectronAlsoSignalElectron = true;
-			}
-		}
-		if (!looseElectronAlsoSignalElectron)
+		if (! m_signalElectronIndex.IsIdentical((*looseElectron)->p4, static_cast<const KLepton*>(*looseElectron)))
 			looseElectrons.push_back(*looseElectron);
 	}
 	std::vector<KMuon*> looseMuons;
 	for (std::vector<KMuon*>::iterator looseMuon = product.m_validLooseMuons.begin();
 		 looseMuon != product.m_validLooseMuons.end(); ++looseMuon)
 	{
-		bool looseMuonAlsoSignalMuon = false;
-		for (std::vector<KMuon*>::iterator muon = product.m_validMuons.begin();
-			 muon != product.m_validMuons.end(); ++muon)
-		{
-			if ((*looseMuon)->p4 == (*muon)->p4)
-			{
-				looseMuonAlsoSignalMuon = true;
-			}
-		}
-		if (!looseMuonAlsoSignalMuon)
+		if (! m_signalMuonIndex.IsIdentical((*looseMuon)->p4, static_cast<const KLepton*>(*looseMuon)))
 			looseMuons.push_back(*looseMuon);
 	}
 	// set boolean veto variables
@@ -1071,5 +1042,4 @@ void Run2DecayChannelProducer::Produce(event_type const& event, product_type& pr
 	{
 		product.m_extraElecVeto = (product.m_validLooseElectrons.size() > 0);
 	}
-	FillGenLeptonCollections(product);
 }
@@ -25,8 +25,9 @@ void EmbeddingGlobalQuantitiesProducer::Produce(event_type const& event, product
 {
 	product.m_pfSumP4.SetPxPyPzE(0.,0.,0.,0.);
 	product.m_pfSumP4WithoutZMuMu.SetPxPyPzE(0.,0.,0.,0.);
-	for (KPFCandidates::const_iterator pfCandidate = event.m_packedPFCandidates->begin();
-		pfCandidate != event.m_packedPFCandidates->end(); ++pfCandidate)
+	KPFCandidates* packedPFCandidates = event.GetOptionalCollection(&event_type::m_packedPFCandidates, "PackedPFCandidates");
+	for (KPFCandidates::const_iterator pfCandidate = packedPFCandidates->begin();
+		pfCandidate != packedPFCandidates->end(); ++pfCandidate)
 	{
 		product.m_pfSumHt += pfCandidate->p4.Pt();
 		product.m_pfSumP4 += pfCandidate->p4;
@@ -283,9 +283,6 @@ void GenTauCPProducerBase::Produce(event_type const& event, product_type& produc
 		product.m_genTau2ProngsSize = selectedTau2OneProngs.size();
 
 
-		// Defining CPQuantities object to use variables and functions of this class
-		CPQuantities cpq;
-
 		// Selection of the right channel for phi and phi*
 		if ((std::abs(selectedTau1->m_genParticle->pdgId) == DefaultValues::pdgIdTau) &&
 		    (std::abs(selectedTau2->m_genParticle->pdgId) == DefaultValues::pdgIdTau) &&
@@ -309,8 +306,8 @@ void GenTauCPProducerBase::Produce(event_type const& event, product_type& produc
 			product.m_genOneProngCharged1 = chargedPart1;
 			product.m_genOneProngCharged2 = chargedPart2;
 			// Saving Energies of charged particles in tau rest frames
-			product.m_genChargedProngEnergies.first = cpq.CalculateChargedProngEnergy(selectedTau1->m_genParticle->p4, chargedPart1->p4);
-			product.m_genChargedProngEnergies.second = cpq.CalculateChargedProngEnergy(selectedTau2->m_genParticle->p4, chargedPart2->p4);
+			product.m_genChargedProngEnergies.first = CPQuantities::CalculateChargedProngEnergy(selectedTau1->m_genParticle->p4, chargedPart1->p4);
+			product.m_genChargedProngEnergies.second = CPQuantities::CalculateChargedProngEnergy(selectedTau2->m_genParticle->p4, chargedPart2->p4);
 
 			////////////////
 			// rho method //
@@ -357,10 +354,12 @@ void GenTauCPProducerBase::Produce(event_type const& event, product_type& produc
 							}
 						}
 
-						product.m_genPhiStarCP_rho = cpq.CalculatePhiStarCP_rho(PionP, PionM, rho1_decay_photons.at(0) + rho1_decay_photons.at(1), rho2_decay_photons.at(0) + rho2_decay_photons.at(1));
-						product.m_gen_yTau = cpq.CalculateSpinAnalysingDiscriminant_rho(selectedTau1->m_genParticle->p4, selectedTau2->m_genParticle->p4, PionP, PionM, rho1_decay_photons.at(0) + rho1_decay_photons.at(1), rho2_decay_photons.at(0) + rho2_decay_photons.at(1));
-						product.m_gen_posyTauL = cpq.CalculateSpinAnalysingDiscriminant_rho(PionP, rho1_decay_photons.at(0) + rho1_decay_photons.at(1));
-						product.m_gen_negyTauL = cpq.CalculateSpinAnalysingDiscriminant_rho(PionM, rho2_decay_photons.at(0) + rho2_decay_photons.at(1));
+						RMFLV piZeroP = rho1_decay_photons.at(0) + rho1_decay_photons.at(1);
+						RMFLV piZeroM = rho2_decay_photons.at(0) + rho2_decay_photons.at(1);
+						product.m_genPhiStarCP_rho = CPQuantities::CalculatePhiStarCP_rho(PionP, PionM, piZeroP, piZeroM);
+						product.m_gen_yTau = CPQuantities::CalculateSpinAnalysingDiscriminant_rho(selectedTau1->m_genParticle->p4, selectedTau2->m_genParticle->p4, PionP, PionM, piZeroP, piZeroM);
+						product.m_gen_posyTauL = CPQuantities::CalculateSpinAnalysingDiscriminant_rho(PionP, piZeroP);
+						product.m_gen_negyTauL = CPQuantities::CalculateSpinAnalysingDiscriminant_rho(PionM, piZeroM);
 
 					}
 				}
@@ -369,32 +368,37 @@ void GenTauCPProducerBase::Produce(event_type const& event, product_type& produc
 
 
 			// Calculation of Phi* and Phi*CP
-			product.m_genPhiStarCP = cpq.CalculatePhiStarCP(selectedTau1->m_genParticle->p4, selectedTau2->m_genParticle->p4, chargedPart1->p4, chargedPart2->p4);
-			product.m_genPhiStar = cpq.GetGenPhiStar();
-			product.m_genOStarCP = cpq.GetGenOStarCP();
-
-			// Calculation of Phi and PhiCP
-			product.m_genPhiCP = cpq.CalculatePhiCP(product.m_genBosonLV, selectedTau1->m_genParticle->p4, selectedTau2->m_genParticle->p4, chargedPart1->p4, chargedPart2->p4);
-			product.m_genPhi = cpq.GetGenPhi();
-			product.m_genOCP = cpq.GetGenOCP();
+			CPQuantities::ZeroMomentumFrame zmf = CPQuantities::CalculateZeroMomentumFrame(chargedPart1->p4, chargedPart2->p4);
+			CPQuantities::PhiStarCPResult phiStarCP = CPQuantities::CalculatePhiStarCP(zmf, selectedTau1->m_genParticle->p4, selectedTau2->m_genParticle->p4);
+			product.m_genPhiStarCP = phiStarCP.phiStarCP;
+			product.m_genPhiStar = phiStarCP.phiStar;
+			product.m_genOStarCP = phiStarCP.oStarCP;
+
+			// Calculation of Phi and PhiCP, sharing the boost into the boson rest frame with z+-
+			CPQuantities::BosonRestFrame bosonRestFrame = CPQuantities::CalculateBosonRestFrame(product.m_genBosonLV, selectedTau1->m_genParticle->p4, chargedPart1->p4, chargedPart2->p4);
+			CPQuantities::PhiCPResult phiCP = CPQuantities::CalculatePhiCP(bosonRestFrame);
+			product.m_genPhiCP = phiCP.phiCP;
+			product.m_genPhi = phiCP.phi;
+			product.m_genOCP = phiCP.oCP;
 	
 			// Calculate phiCP in the lab frame
-			product.m_genPhiCPLab = cpq.CalculatePhiCPLab(selectedTau1->m_genParticle->p4, selectedTau2->m_genParticle->p4, chargedPart1->p4, chargedPart2->p4);
+			product.m_genPhiCPLab = CPQuantities::CalculatePhiCPLab(selectedTau1->m_genParticle->p4, selectedTau2->m_genParticle->p4, chargedPart1->p4, chargedPart2->p4);
 
 			if (product.m_genPV != nullptr){
 				// calculate IP vectors of tau daughters
-				product.m_genIP1 = cpq.CalculateIPVector(chargedPart1, product.m_genPV);
-				product.m_genIP2 = cpq.CalculateIPVector(chargedPart2, product.m_genPV);
+				product.m_genIP1 = CPQuantities::CalculateIPVector(chargedPart1, product.m_genPV);
+				product.m_genIP2 = CPQuantities::CalculateIPVector(chargedPart2, product.m_genPV);
 
 				// calculate cosPsi
-				product.m_genCosPsiPlus  = cpq.CalculateCosPsi(chargedPart1->p4, product.m_genIP1);
-				product.m_genCosPsiMinus = cpq.CalculateCosPsi(chargedPart2->p4, product.m_genIP2);
+				product.m_genCosPsiPlus  = CPQuantities::CalculateCosPsi(chargedPart1->p4, product.m_genIP1);
+				product.m_genCosPsiMinus = CPQuantities::CalculateCosPsi(chargedPart2->p4, product.m_genIP2);
 			}
 
 			// ZPlusMinus calculation
-			product.m_genZPlus = cpq.CalculateZPlusMinus(product.m_genBosonLV, chargedPart1->p4);
-			product.m_genZMinus = cpq.CalculateZPlusMinus(product.m_genBosonLV, chargedPart2->p4);
-			product.m_genZs = cpq.CalculateZs(product.m_genZPlus, product.m_genZMinus);
+			std::pair<double, double> zPlusMinus = CPQuantities::CalculateZPlusMinus(bosonRestFrame);
+			product.m_genZPlus = zPlusMinus.first;
+			product.m_genZMinus = zPlusMinus.second;
+			product.m_genZs = CPQuantities::CalculateZs(product.m_genZPlus, product.m_genZMinus);
 		}
 	}
 }
@@ -496,8 +500,6 @@ void GenMatchedTauCPProducer::Produce(event_type const& event, product_type& pro
 			KGenParticle* genParticle1 = product.m_flavourOrderedGenLeptons.at(0);
 			KGenParticle* genParticle2 = product.m_flavourOrderedGenLeptons.at(1);
 
-			// Defining CPQuantities object to use variables and functions of this class
-			CPQuantities cpq;
 				
 
 			// if the genLepton is a hadronic tau, we want to take its hadronic daughter
@@ -548,18 +550,18 @@ void GenMatchedTauCPProducer::Produce(event_type const& event, product_type& pro
 	
 			if (product.m_genPV != nullptr){
 
-				product.m_genIP1 = cpq.CalculateIPVector(genParticle1, product.m_genPV);
-				product.m_genIP2 = cpq.CalculateIPVector(genParticle2, product.m_genPV);
+				product.m_genIP1 = CPQuantities::CalculateIPVector(genParticle1, product.m_genPV);
+				product.m_genIP2 = CPQuantities::CalculateIPVector(genParticle2, product.m_genPV);
 				
 				// calculate phi*cp
 				if (genParticle1->charge() > 0){
-					product.m_genCosPsiPlus  = cpq.CalculateCosPsi(genParticle1->p4, product.m_genIP1);
-					product.m_genCosPsiMinus = cpq.CalculateCosPsi(genParticle2->p4, product.m_genIP2);
-					product.m_genPhiStarCP = cpq.CalculatePhiStarCP(genParticle1->p4, genParticle2->p4, product.m_genIP1, product.m_genIP2);
+					product.m_genCosPsiPlus  = CPQuantities::CalculateCosPsi(genParticle1->p4, product.m_genIP1);
+					product.m_genCosPsiMinus = CPQuantities::CalculateCosPsi(genParticle2->p4, product.m_genIP2);
+					product.m_genPhiStarCP = CPQuantities::CalculatePhiStarCP(genParticle1->p4, genParticle2->p4, product.m_genIP1, product.m_genIP2);
 				} else {
-					product.m_genCosPsiPlus  = cpq.CalculateCosPsi(genParticle2->p4, product.m_genIP2);
-					product.m_genCosPsiMinus = cpq.CalculateCosPsi(genParticle1->p4, product.m_genIP1);
-					product.m_genPhiStarCP = cpq.CalculatePhiStarCP(genParticle2->p4, genParticle1->p4, product.m_genIP2, product.m_genIP1);
+					product.m_genCosPsiPlus  = CPQuantities::CalculateCosPsi(genParticle2->p4, product.m_genIP2);
+					product.m_genCosPsiMinus = CPQuantities::CalculateCosPsi(genParticle1->p4, product.m_genIP1);
+					product.m_genPhiStarCP = CPQuantities::CalculatePhiStarCP(genParticle2->p4, genParticle1->p4, product.m_genIP2, product.m_genIP1);
 				}
 					
 			}
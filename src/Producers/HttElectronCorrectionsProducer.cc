@@ -16,6 +16,11 @@ void HttElectronCorrectionsProducer::Init(setting_type const& settings)
 	eleEnergyCorrection = ToElectronEnergyCorrection(boost::algorithm::to_lower_copy(boost::algorithm::trim_copy(static_cast<HttSettings const&>(settings).GetElectronEnergyCorrection())));
 }
 
+std::vector<std::string> HttElectronCorrectionsProducer::GetVariedSettings() const
+{
+	return { "ElectronEnergyCorrectionShift", "ElectronEnergyCorrectionShiftEB", "ElectronEnergyCorrectionShiftEE" };
+}
+
 void HttElectronCorrectionsProducer::AdditionalCorrections(KElectron* electron, event_type const& event,
                                                       product_type& product, setting_type const& settings) const
 {
@@ -1,15 +1,29 @@
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
-#include <TRandom3.h>
 
 #include "Artus/Utility/interface/SafeMap.h"
 #include "Artus/Utility/interface/Utility.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEnumTypes.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/HttMuonCorrectionsProducer.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/CounterBasedRandom.h"
 
 #include "TLorentzVector.h"
 
+void HttMuonCorrectionsProducer::Init(setting_type const& settings)
+{
+	MuonCorrectionsProducer::Init(settings);
+	
+	m_randomStreamId = CounterBasedRandom::GetStreamId(GetProducerId());
+}
+
+std::vector<std::string> HttMuonCorrectionsProducer::GetVariedSettings() const
+{
+	return { "MuonEnergyCorrectionShift" };
+}
+
 void HttMuonCorrectionsProducer::AdditionalCorrections(KMuon* muon, event_type const& event,
                                                        product_type& product, setting_type const& settings) const
 {
@@ -20,14 +34,17 @@ void HttMuonCorrectionsProducer::AdditionalCorrections(KMuon* muon, event_type c
 	{
 		muon->p4 = muon->p4 * muonEnergyCorrectionShift;
 	}
+}
+
+void HttMuonCorrectionsProducer::Produce(event_type const& event, product_type& product,
+                                         setting_type const& settings) const
+{
+	MuonCorrectionsProducer::Produce(event, product, settings);
 	
+	// the smearing is applied in the loop over all corrected muons, such that the index is known
 	float randomMuonEnergySmearing = static_cast<HttSettings const&>(settings).GetRandomMuonEnergySmearing();
 	if (randomMuonEnergySmearing != 0.0)
-	{	
-		double r;
-		TRandom *r3 = new TRandom3();
-		r3->SetSeed(event.m_eventInfo->nEvent);
-		r = (1.0+r3->Gaus(0.0,randomMuonEnergySmearing));
-		muon->p4 = muon->p4 * r;
+	{
+		CounterBasedRandom::SmearMomenta(product.m_correctedMuons, event.m_eventInfo, m_randomStreamId, randomMuonEnergySmearing);
 	}
 }
@@ -1,7 +1,8 @@
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
-#include <TRandom3.h>
 
 #include "DataFormats/TauReco/interface/PFTau.h"
 
@@ -10,325 +11,280 @@
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/HttEnumTypes.h"
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/HttTauCorrectionsProducer.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/CounterBasedRandom.h"
 
 #include "Artus/KappaAnalysis/interface/Utility/GeneratorInfo.h"
 
 	
+HttTauCorrectionsProducer::TauGenMatchClass HttTauCorrectionsProducer::ToTauGenMatchClass(KappaEnumTypes::GenMatchingCode genMatchingCode)
+{
+	switch (genMatchingCode)
+	{
+		case KappaEnumTypes::GenMatchingCode::IS_TAU_HAD_DECAY: return TauGenMatchClass::TAU_HAD_DECAY;
+		case KappaEnumTypes::GenMatchingCode::IS_MUON_PROMPT:
+		case KappaEnumTypes::GenMatchingCode::IS_MUON_FROM_TAU: return TauGenMatchClass::MUON;
+		case KappaEnumTypes::GenMatchingCode::IS_ELE_PROMPT: return TauGenMatchClass::ELECTRON_PROMPT;
+		case KappaEnumTypes::GenMatchingCode::IS_ELE_FROM_TAU: return TauGenMatchClass::ELECTRON_FROM_TAU;
+		case KappaEnumTypes::GenMatchingCode::IS_FAKE: return TauGenMatchClass::FAKE;
+		default: return TauGenMatchClass::OTHER;
+	}
+}
+
+HttTauCorrectionsProducer::TauDecayModeBin HttTauCorrectionsProducer::ToTauDecayModeBin(int decayMode)
+{
+	// http://cmslxr.fnal.gov/lxr/source/DataFormats/TauReco/interface/PFTau.h#035
+	switch (decayMode)
+	{
+		case reco::PFTau::hadronicDecayMode::kOneProng0PiZero: return TauDecayModeBin::ONE_PRONG;
+		case reco::PFTau::hadronicDecayMode::kOneProng1PiZero: return TauDecayModeBin::ONE_PRONG_ONE_PI_ZERO;
+		case reco::PFTau::hadronicDecayMode::kOneProng2PiZero: return TauDecayModeBin::ONE_PRONG_TWO_PI_ZEROS;
+		case reco::PFTau::hadronicDecayMode::kThreeProng0PiZero: return TauDecayModeBin::THREE_PRONG;
+		default: return TauDecayModeBin::OTHER;
+	}
+}
+
 void HttTauCorrectionsProducer::Init(setting_type const& settings)
 {
 	TauCorrectionsProducer::Init(settings);
 	
 	tauEnergyCorrection = ToTauEnergyCorrection(boost::algorithm::to_lower_copy(boost::algorithm::trim_copy(static_cast<HttSettings const&>(settings).GetTauEnergyCorrection())));
+	m_randomStreamId = CounterBasedRandom::GetStreamId(GetProducerId());
+	
+	BuildCorrectionTable(static_cast<HttSettings const&>(settings));
+	m_tauJetFakeEnergyCorrectionShift = static_cast<HttSettings const&>(settings).GetTauJetFakeEnergyCorrection();
+	m_randomTauEnergySmearing = static_cast<HttSettings const&>(settings).GetRandomTauEnergySmearing();
 }
 
-void HttTauCorrectionsProducer::AdditionalCorrections(KTau* tau, event_type const& event,
-                                                      product_type& product, setting_type const& settings) const
+std::vector<std::string> HttTauCorrectionsProducer::GetVariedSettings() const
 {
-	TauCorrectionsProducer::AdditionalCorrections(tau, event, product, settings);
-	
-	double normalisationFactor = 1.0;
-	
-	KappaEnumTypes::GenMatchingCode genMatchingCode = KappaEnumTypes::GenMatchingCode::NONE;
-	KLepton* originalLepton = product.m_originalLeptons.find(tau) != product.m_originalLeptons.end() ? const_cast<KLepton*>(product.m_originalLeptons.at(tau)) : tau;
-	if (settings.GetUseUWGenMatching())
+	return {
+		"TauEnergyCorrectionOneProng", "TauEnergyCorrectionOneProngPiZeros", "TauEnergyCorrectionThreeProng",
+		"TauEnergyCorrectionShift", "TauEnergyCorrectionOneProngShift", "TauEnergyCorrectionOneProngPiZerosShift", "TauEnergyCorrectionThreeProngShift",
+		"TauElectronFakeEnergyCorrectionOneProng", "TauElectronFakeEnergyCorrectionOneProngPiZeros", "TauElectronFakeEnergyCorrectionThreeProng",
+		"TauElectronFakeEnergyCorrectionShift", "TauElectronFakeEnergyCorrectionOneProngShift", "TauElectronFakeEnergyCorrectionOneProngPiZerosShift", "TauElectronFakeEnergyCorrectionThreeProngShift",
+		"TauMuonFakeEnergyCorrectionOneProng", "TauMuonFakeEnergyCorrectionOneProngPiZeros", "TauMuonFakeEnergyCorrectionThreeProng",
+		"TauMuonFakeEnergyCorrectionShift", "TauMuonFakeEnergyCorrectionOneProngShift", "TauMuonFakeEnergyCorrectionOneProngPiZerosShift", "TauMuonFakeEnergyCorrectionThreeProngShift",
+		"TauJetFakeEnergyCorrection",
+		// not read, but varied together with the shifts above by the shift configurations
+		"TauElectronFakeEnergyCorrection", "TauMuonFakeEnergyCorrection"
+	};
+}
+
+void HttTauCorrectionsProducer::BuildCorrectionTable(HttSettings const& settings)
+{
+	if ((tauEnergyCorrection != TauEnergyCorrection::NONE) &&
+	    (tauEnergyCorrection != TauEnergyCorrection::SUMMER2013) &&
+	    (tauEnergyCorrection != TauEnergyCorrection::NEWTAUID) &&
+	    (tauEnergyCorrection != TauEnergyCorrection::SMHTT2016) &&
+	    (tauEnergyCorrection != TauEnergyCorrection::MSSMHTT2016))
 	{
-		genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, originalLepton);
+		LOG(FATAL) << "Tau energy correction of type " << Utility::ToUnderlyingValue(tauEnergyCorrection) << " not yet implemented!";
 	}
-	else
+	
+	// values per decay mode bin, a value of 1.0 means no correction/shift
+	auto perDecayMode = [](float oneProng, float oneProngPiZeros, float threeProng, bool twoPiZeros=true)
 	{
-		KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(originalLepton, product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
-		if (genParticle)
-			genMatchingCode = GeneratorInfo::GetGenMatchingCode(genParticle);
-		else
-			genMatchingCode = KappaEnumTypes::GenMatchingCode::IS_FAKE;
-	}
-
-	// https://twiki.cern.ch/twiki/bin/viewauth/CMS/HiggsToTauTauWorkingSummer2013#TauES_and_decay_mode_scale_facto
-	if (tauEnergyCorrection == TauEnergyCorrection::SUMMER2013)
+		return std::array<float, static_cast<size_t>(TauDecayModeBin::N_BINS)>{{oneProng, oneProngPiZeros, (twoPiZeros ? oneProngPiZeros : 1.0f), threeProng, 1.0f}};
+	};
+	auto noCorrection = perDecayMode(1.0, 1.0, 1.0);
+	
+	// nominal corrections
+	std::array<float, static_cast<size_t>(TauDecayModeBin::N_BINS)> tauHadCorrections = noCorrection;
+	std::array<float, static_cast<size_t>(TauDecayModeBin::N_BINS)> muonFakeCorrections = noCorrection;
+	std::array<float, static_cast<size_t>(TauDecayModeBin::N_BINS)> electronPromptFakeCorrections = noCorrection;
+	std::array<float, static_cast<size_t>(TauDecayModeBin::N_BINS)> electronFromTauFakeCorrections = noCorrection;
+	if (tauEnergyCorrection == TauEnergyCorrection::SMHTT2016)
 	{
-		// http://cmslxr.fnal.gov/lxr/source/DataFormats/TauReco/interface/PFTau.h#035
-		if (tau->decayMode == reco::PFTau::hadronicDecayMode::kOneProng0PiZero)
-		{
-			normalisationFactor = 0.88;
-		}
-		else if (tau->decayMode == reco::PFTau::hadronicDecayMode::kOneProng1PiZero || tau->decayMode == reco::PFTau::hadronicDecayMode::kOneProng2PiZero)
-		{
-			tau->p4 = tau->p4 * (1.012);
-// 			tau->p4 = tau->p4 * (1.015 + 0.001 * std::min(std::max(tau->p4.Pt() - 45.0, 0.0), 10.0));
-		}
-		else if (tau->decayMode == reco::PFTau::hadronicDecayMode::kThreeProng0PiZero)
-		{
-			tau->p4 = tau->p4 * (1.012);
-// 			tau->p4 = tau->p4 * (1.012 + 0.001 * std::min(std::max(tau->p4.Pt() - 32.0, 0.0), 18.0));
-		}
+		tauHadCorrections = perDecayMode(settings.GetTauEnergyCorrectionOneProng(),
+		                                 settings.GetTauEnergyCorrectionOneProngPiZeros(),
+		                                 settings.GetTauEnergyCorrectionThreeProng());
+		muonFakeCorrections = perDecayMode(settings.GetTauMuonFakeEnergyCorrectionOneProng(),
+		                                   settings.GetTauMuonFakeEnergyCorrectionOneProngPiZeros(),
+		                                   settings.GetTauMuonFakeEnergyCorrectionThreeProng());
+		electronPromptFakeCorrections = perDecayMode(settings.GetTauElectronFakeEnergyCorrectionOneProng(),
+		                                             settings.GetTauElectronFakeEnergyCorrectionOneProngPiZeros(),
+		                                             settings.GetTauElectronFakeEnergyCorrectionThreeProng());
+		electronFromTauFakeCorrections = electronPromptFakeCorrections;
 	}
-	else if (tauEnergyCorrection == TauEnergyCorrection::NEWTAUID)
+	else if (tauEnergyCorrection == TauEnergyCorrection::MSSMHTT2016)
 	{
-		tau->p4 = tau->p4 * (1.01);
+		// decay mode 2 is not corrected, only prompt electrons are corrected for decay modes 0 and 1
+		tauHadCorrections = perDecayMode(settings.GetTauEnergyCorrectionOneProng(),
+		                                 settings.GetTauEnergyCorrectionOneProngPiZeros(),
+		                                 settings.GetTauEnergyCorrectionThreeProng(), false);
+		electronPromptFakeCorrections = perDecayMode(settings.GetTauElectronFakeEnergyCorrectionOneProng(),
+		                                             settings.GetTauElectronFakeEnergyCorrectionOneProngPiZeros(),
+		                                             1.0, false);
 	}
-	else if (tauEnergyCorrection == TauEnergyCorrection::SMHTT2016)
+	
+	// energy scale shifts
+	auto tauShifts = perDecayMode(settings.GetTauEnergyCorrectionOneProngShift(),
+	                              settings.GetTauEnergyCorrectionOneProngPiZerosShift(),
+	                              settings.GetTauEnergyCorrectionThreeProngShift());
+	auto electronFakeShifts = perDecayMode(settings.GetTauElectronFakeEnergyCorrectionOneProngShift(),
+	                                       settings.GetTauElectronFakeEnergyCorrectionOneProngPiZerosShift(),
+	                                       settings.GetTauElectronFakeEnergyCorrectionThreeProngShift());
+	auto muonFakeShifts = perDecayMode(settings.GetTauMuonFakeEnergyCorrectionOneProngShift(),
+	                                   settings.GetTauMuonFakeEnergyCorrectionOneProngPiZerosShift(),
+	                                   settings.GetTauMuonFakeEnergyCorrectionThreeProngShift());
+	float tauEnergyCorrectionShift = settings.GetTauEnergyCorrectionShift();
+	float tauElectronFakeEnergyCorrectionShift = settings.GetTauElectronFakeEnergyCorrectionShift();
+	float tauMuonFakeEnergyCorrectionShift = settings.GetTauMuonFakeEnergyCorrectionShift();
+	
+	std::array<HttEnumTypes::SystematicShift, static_cast<size_t>(TauDecayModeBin::N_BINS)> tauShiftTypes{{
+			HttEnumTypes::SystematicShift::TAU_ES_1PRONG, HttEnumTypes::SystematicShift::TAU_ES_1PRONGPI0S,
+			HttEnumTypes::SystematicShift::TAU_ES_1PRONGPI0S, HttEnumTypes::SystematicShift::TAU_ES_3PRONG,
+			HttEnumTypes::SystematicShift::NONE
+	}};
+	std::array<HttEnumTypes::SystematicShift, static_cast<size_t>(TauDecayModeBin::N_BINS)> electronFakeShiftTypes{{
+			HttEnumTypes::SystematicShift::TAU_ELECTRON_FAKE_ES_1PRONG, HttEnumTypes::SystematicShift::TAU_ELECTRON_FAKE_ES_1PRONGPI0S,
+			HttEnumTypes::SystematicShift::TAU_ELECTRON_FAKE_ES_1PRONGPI0S, HttEnumTypes::SystematicShift::TAU_ELECTRON_FAKE_ES_3PRONG,
+			HttEnumTypes::SystematicShift::NONE
+	}};
+	std::array<HttEnumTypes::SystematicShift, static_cast<size_t>(TauDecayModeBin::N_BINS)> muonFakeShiftTypes{{
+			HttEnumTypes::SystematicShift::TAU_MUON_FAKE_ES_1PRONG, HttEnumTypes::SystematicShift::TAU_MUON_FAKE_ES_1PRONGPI0S,
+			HttEnumTypes::SystematicShift::TAU_MUON_FAKE_ES_1PRONGPI0S, HttEnumTypes::SystematicShift::TAU_MUON_FAKE_ES_3PRONG,
+			HttEnumTypes::SystematicShift::NONE
+	}};
+	
+	auto applyShift = [](TauEnergyScaleCorrection& correction, float shift, HttEnumTypes::SystematicShift systematicShift, float systematicShiftSigma)
 	{
-		if (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_TAU_HAD_DECAY) // correct tau->had energy scale
-		{
-			float tauEnergyCorrectionOneProng = static_cast<HttSettings const&>(settings).GetTauEnergyCorrectionOneProng();
-			float tauEnergyCorrectionOneProngPiZeros = static_cast<HttSettings const&>(settings).GetTauEnergyCorrectionOneProngPiZeros();
-			float tauEnergyCorrectionThreeProng = static_cast<HttSettings const&>(settings).GetTauEnergyCorrectionThreeProng();
-			if (tau->decayMode == 0 && tauEnergyCorrectionOneProng != 1.0)
-			{
-				tau->p4 = tau->p4 * tauEnergyCorrectionOneProng;
-			}
-			else if ((tau->decayMode == 1 || tau->decayMode == 2) && tauEnergyCorrectionOneProngPiZeros != 1.0)
-			{
-				tau->p4 = tau->p4 * tauEnergyCorrectionOneProngPiZeros;
-			}
-			else if (tau->decayMode == 10 && tauEnergyCorrectionThreeProng != 1.0)
-			{
-				tau->p4 = tau->p4 * tauEnergyCorrectionThreeProng;
-			}
-		}
-		else if ((genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_MUON_PROMPT) || (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_MUON_FROM_TAU)) // correct mu->tau fake energy scale
+		if (shift != 1.0)
 		{
-			float tauMuonFakeEnergyCorrectionOneProng = static_cast<HttSettings const&>(settings).GetTauMuonFakeEnergyCorrectionOneProng();
-			float tauMuonFakeEnergyCorrectionOneProngPiZeros = static_cast<HttSettings const&>(settings).GetTauMuonFakeEnergyCorrectionOneProngPiZeros();
-			float tauMuonFakeEnergyCorrectionThreeProng = static_cast<HttSettings const&>(settings).GetTauMuonFakeEnergyCorrectionThreeProng();
-			if (tau->decayMode == 0 && tauMuonFakeEnergyCorrectionOneProng != 1.0)
-			{
-				tau->p4 = tau->p4 * tauMuonFakeEnergyCorrectionOneProng;
-			}
-			else if ((tau->decayMode == 1 || tau->decayMode == 2) && tauMuonFakeEnergyCorrectionOneProngPiZeros != 1.0)
-			{
-				tau->p4 = tau->p4 * tauMuonFakeEnergyCorrectionOneProngPiZeros;
-			}
-			else if (tau->decayMode == 10 && tauMuonFakeEnergyCorrectionThreeProng != 1.0)
-			{
-				tau->p4 = tau->p4 * tauMuonFakeEnergyCorrectionThreeProng;
-			}
+			correction.scale *= shift;
+			correction.systematicShift = systematicShift;
+			correction.systematicShiftSigma = systematicShiftSigma;
 		}
-		else if ((genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_ELE_PROMPT) || (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_ELE_FROM_TAU)) // correct e->tau fake energy scale
+	};
+	
+	for (size_t genMatchIndex = 0; genMatchIndex < static_cast<size_t>(TauGenMatchClass::N_CLASSES); ++genMatchIndex)
+	{
+		TauGenMatchClass genMatchClass = static_cast<TauGenMatchClass>(genMatchIndex);
+		bool isMuonFake = (genMatchClass == TauGenMatchClass::MUON);
+		bool isElectronFake = ((genMatchClass == TauGenMatchClass::ELECTRON_PROMPT) || (genMatchClass == TauGenMatchClass::ELECTRON_FROM_TAU));
+		
+		for (size_t decayModeIndex = 0; decayModeIndex < static_cast<size_t>(TauDecayModeBin::N_BINS); ++decayModeIndex)
 		{
-			float tauElectronFakeEnergyCorrectionOneProng = static_cast<HttSettings const&>(settings).GetTauElectronFakeEnergyCorrectionOneProng();
-			float tauElectronFakeEnergyCorrectionOneProngPiZeros = static_cast<HttSettings const&>(settings).GetTauElectronFakeEnergyCorrectionOneProngPiZeros();
-			float tauElectronFakeEnergyCorrectionThreeProng = static_cast<HttSettings const&>(settings).GetTauElectronFakeEnergyCorrectionThreeProng();
-			if (tau->decayMode == 0 && tauElectronFakeEnergyCorrectionOneProng != 1.0)
+			TauDecayModeBin decayModeBin = static_cast<TauDecayModeBin>(decayModeIndex);
+			TauEnergyScaleCorrection correction;
+			
+			// https://twiki.cern.ch/twiki/bin/viewauth/CMS/HiggsToTauTauWorkingSummer2013#TauES_and_decay_mode_scale_facto
+			if (tauEnergyCorrection == TauEnergyCorrection::SUMMER2013)
 			{
-				tau->p4 = tau->p4 * tauElectronFakeEnergyCorrectionOneProng;
+				if (decayModeBin == TauDecayModeBin::ONE_PRONG)
+				{
+					correction.normalisationFactor = 0.88;
+				}
+				else if (decayModeBin != TauDecayModeBin::OTHER)
+				{
+					correction.scale *= 1.012;
+				}
 			}
-			else if ((tau->decayMode == 1 || tau->decayMode == 2) && tauElectronFakeEnergyCorrectionOneProngPiZeros != 1.0)
+			else if (tauEnergyCorrection == TauEnergyCorrection::NEWTAUID)
 			{
-				tau->p4 = tau->p4 * tauElectronFakeEnergyCorrectionOneProngPiZeros;
+				correction.scale *= 1.01;
 			}
-			else if (tau->decayMode == 10 && tauElectronFakeEnergyCorrectionThreeProng != 1.0)
+			else if (genMatchClass == TauGenMatchClass::TAU_HAD_DECAY)
 			{
-				tau->p4 = tau->p4 * tauElectronFakeEnergyCorrectionThreeProng;
+				correction.scale *= tauHadCorrections[decayModeIndex];
 			}
-		}
-	}
-	else if (tauEnergyCorrection == TauEnergyCorrection::MSSMHTT2016)
-	{
-		if (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_TAU_HAD_DECAY)
-		{
-			if (tau->decayMode == 0)
+			else if (isMuonFake)
 			{
-				tau->p4 = tau->p4 * static_cast<HttSettings const&>(settings).GetTauEnergyCorrectionOneProng();
+				correction.scale *= muonFakeCorrections[decayModeIndex];
 			}
-			else if (tau->decayMode == 1)
+			else if (genMatchClass == TauGenMatchClass::ELECTRON_PROMPT)
 			{
-				tau->p4 = tau->p4 * static_cast<HttSettings const&>(settings).GetTauEnergyCorrectionOneProngPiZeros();
+				correction.scale *= electronPromptFakeCorrections[decayModeIndex];
 			}
-			else if (tau->decayMode == 10)
+			else if (genMatchClass == TauGenMatchClass::ELECTRON_FROM_TAU)
 			{
-				tau->p4 = tau->p4 * static_cast<HttSettings const&>(settings).GetTauEnergyCorrectionThreeProng();
+				correction.scale *= electronFromTauFakeCorrections[decayModeIndex];
 			}
-		}
-		// correct e->tau fake energy scale
-		if (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_ELE_PROMPT)
-		{
-			if (tau->decayMode == 0)
+			
+			// tau energy scale shifts: inclusive, then per decay mode
+			applyShift(correction, tauEnergyCorrectionShift, HttEnumTypes::SystematicShift::TAU_ES, tauEnergyCorrectionShift);
+			applyShift(correction, tauShifts[decayModeIndex], tauShiftTypes[decayModeIndex], tauShifts[decayModeIndex]);
+			
+			// electron->tau fake energy scale shifts
+			// (the inclusive shift is stored with the sigma of the inclusive tau energy scale shift for the Svfit cache)
+			if (isElectronFake)
 			{
-				tau->p4 = tau->p4 * static_cast<HttSettings const&>(settings).GetTauElectronFakeEnergyCorrectionOneProng();
+				applyShift(correction, tauElectronFakeEnergyCorrectionShift, HttEnumTypes::SystematicShift::TAU_ELECTRON_FAKE_ES, tauEnergyCorrectionShift);
+				applyShift(correction, electronFakeShifts[decayModeIndex], electronFakeShiftTypes[decayModeIndex], electronFakeShifts[decayModeIndex]);
 			}
-			else if (tau->decayMode == 1)
+			
+			// muon->tau fake energy scale shifts
+			if (isMuonFake)
 			{
-				tau->p4 = tau->p4 * static_cast<HttSettings const&>(settings).GetTauElectronFakeEnergyCorrectionOneProngPiZeros();
+				applyShift(correction, tauMuonFakeEnergyCorrectionShift, HttEnumTypes::SystematicShift::TAU_MUON_FAKE_ES, tauEnergyCorrectionShift);
+				applyShift(correction, muonFakeShifts[decayModeIndex], muonFakeShiftTypes[decayModeIndex], muonFakeShifts[decayModeIndex]);
 			}
+			
+			m_correctionTable[GetCorrectionIndex(genMatchClass, decayModeBin)] = correction;
 		}
 	}
-	else if (tauEnergyCorrection != TauEnergyCorrection::NONE)
-	{
-		LOG(FATAL) << "Tau energy correction of type " << Utility::ToUnderlyingValue(tauEnergyCorrection) << " not yet implemented!";
-	}
+}
+
+void HttTauCorrectionsProducer::AdditionalCorrections(KTau* tau, event_type const& event,
+                                                      product_type& product, setting_type const& settings) const
+{
+	TauCorrectionsProducer::AdditionalCorrections(tau, event, product, settings);
 	
-	// -------------------------------------
-	// tau energy scale shifts
-	float tauEnergyCorrectionShift = static_cast<HttSettings const&>(settings).GetTauEnergyCorrectionShift();
-	float tauEnergyCorrectionOneProngShift = static_cast<HttSettings const&>(settings).GetTauEnergyCorrectionOneProngShift();
-	float tauEnergyCorrectionOneProngPiZerosShift = static_cast<HttSettings const&>(settings).GetTauEnergyCorrectionOneProngPiZerosShift();
-	float tauEnergyCorrectionThreeProngShift = static_cast<HttSettings const&>(settings).GetTauEnergyCorrectionThreeProngShift();
-	// inclusive
-	if (tauEnergyCorrectionShift != 1.0)
+	KappaEnumTypes::GenMatchingCode genMatchingCode = KappaEnumTypes::GenMatchingCode::NONE;
+	KLepton* originalLepton = product.m_originalLeptons.find(tau) != product.m_originalLeptons.end() ? const_cast<KLepton*>(product.m_originalLeptons.at(tau)) : tau;
+	if (settings.GetUseUWGenMatching())
 	{
-		tau->p4 = tau->p4 * tauEnergyCorrectionShift;
-		
-		// settings for (cached) Svfit calculation
-		(static_cast<HttProduct&>(product)).m_systematicShift = HttEnumTypes::SystematicShift::TAU_ES;
-		(static_cast<HttProduct&>(product)).m_systematicShiftSigma = tauEnergyCorrectionShift;
+		genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, originalLepton);
 	}
-	// 1-prongs only
-	if (tauEnergyCorrectionOneProngShift != 1.0 && tau->decayMode == 0)
+	else
 	{
-		tau->p4 = tau->p4 * tauEnergyCorrectionOneProngShift;
-
-		// settings for (cached) Svfit calculation
-		(static_cast<HttProduct&>(product)).m_systematicShift = HttEnumTypes::SystematicShift::TAU_ES_1PRONG;
-		(static_cast<HttProduct&>(product)).m_systematicShiftSigma = tauEnergyCorrectionOneProngShift;
+		KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(originalLepton, product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
+		if (genParticle)
+			genMatchingCode = GeneratorInfo::GetGenMatchingCode(genParticle);
+		else
+			genMatchingCode = KappaEnumTypes::GenMatchingCode::IS_FAKE;
 	}
-	// 1-prong+pi0s only
-	if (tauEnergyCorrectionOneProngPiZerosShift != 1.0 && (tau->decayMode == 1 || tau->decayMode == 2))
+	
+	TauEnergyScaleCorrection const& correction = m_correctionTable[GetCorrectionIndex(ToTauGenMatchClass(genMatchingCode), ToTauDecayModeBin(tau->decayMode))];
+	if (correction.scale != 1.0)
 	{
-		tau->p4 = tau->p4 * tauEnergyCorrectionOneProngPiZerosShift;
-
-		// settings for (cached) Svfit calculation
-		(static_cast<HttProduct&>(product)).m_systematicShift = HttEnumTypes::SystematicShift::TAU_ES_1PRONGPI0S;
-		(static_cast<HttProduct&>(product)).m_systematicShiftSigma = tauEnergyCorrectionOneProngPiZerosShift;
+		tau->p4 = tau->p4 * correction.scale;
 	}
-	// 3-prongs only
-	if (tauEnergyCorrectionThreeProngShift != 1.0 && tau->decayMode == 10)
+	if (correction.systematicShift != HttEnumTypes::SystematicShift::NONE)
 	{
-		tau->p4 = tau->p4 * tauEnergyCorrectionThreeProngShift;
-
 		// settings for (cached) Svfit calculation
-		(static_cast<HttProduct&>(product)).m_systematicShift = HttEnumTypes::SystematicShift::TAU_ES_3PRONG;
-		(static_cast<HttProduct&>(product)).m_systematicShiftSigma = tauEnergyCorrectionThreeProngShift;
-	}
-	// -------------------------------------
-	// electron->tau fake energy scale shifts
-	float tauElectronFakeEnergyCorrectionShift = static_cast<HttSettings const&>(settings).GetTauElectronFakeEnergyCorrectionShift();
-	float tauElectronFakeEnergyCorrectionOneProngShift = static_cast<HttSettings const&>(settings).GetTauElectronFakeEnergyCorrectionOneProngShift();
-	float tauElectronFakeEnergyCorrectionOneProngPiZerosShift = static_cast<HttSettings const&>(settings).GetTauElectronFakeEnergyCorrectionOneProngPiZerosShift();
-	float tauElectronFakeEnergyCorrectionThreeProngShift = static_cast<HttSettings const&>(settings).GetTauElectronFakeEnergyCorrectionThreeProngShift();
-	if (tauElectronFakeEnergyCorrectionShift != 1.0 ||
-		tauElectronFakeEnergyCorrectionOneProngShift != 1.0 ||
-		tauElectronFakeEnergyCorrectionOneProngPiZerosShift != 1.0 ||
-		tauElectronFakeEnergyCorrectionThreeProngShift != 1.0)
-	{
-		if ((genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_ELE_PROMPT) || (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_ELE_FROM_TAU))
-		{
-			// inclusive
-			if (tauElectronFakeEnergyCorrectionShift != 1.0)
-			{
-				tau->p4 = tau->p4 * tauElectronFakeEnergyCorrectionShift;
-
-				// settings for (cached) Svfit calculation
-				(static_cast<HttProduct&>(product)).m_systematicShift = HttEnumTypes::SystematicShift::TAU_ELECTRON_FAKE_ES;
-				(static_cast<HttProduct&>(product)).m_systematicShiftSigma = tauEnergyCorrectionShift;
-			}
-			// 1-prongs only
-			if (tauElectronFakeEnergyCorrectionOneProngShift != 1.0 && tau->decayMode == 0)
-			{
-				tau->p4 = tau->p4 * tauElectronFakeEnergyCorrectionOneProngShift;
-
-				// settings for (cached) Svfit calculation
-				(static_cast<HttProduct&>(product)).m_systematicShift = HttEnumTypes::SystematicShift::TAU_ELECTRON_FAKE_ES_1PRONG;
-				(static_cast<HttProduct&>(product)).m_systematicShiftSigma = tauElectronFakeEnergyCorrectionOneProngShift;
-			}
-			// 1-prong+pi0s only
-			if (tauElectronFakeEnergyCorrectionOneProngPiZerosShift != 1.0 && (tau->decayMode == 1 || tau->decayMode == 2))
-			{
-				tau->p4 = tau->p4 * tauElectronFakeEnergyCorrectionOneProngPiZerosShift;
-
-				// settings for (cached) Svfit calculation
-				(static_cast<HttProduct&>(product)).m_systematicShift = HttEnumTypes::SystematicShift::TAU_ELECTRON_FAKE_ES_1PRONGPI0S;
-				(static_cast<HttProduct&>(product)).m_systematicShiftSigma = tauElectronFakeEnergyCorrectionOneProngPiZerosShift;
-			}
-			// 3-prongs only
-			if (tauElectronFakeEnergyCorrectionThreeProngShift != 1.0 && tau->decayMode == 10)
-			{
-				tau->p4 = tau->p4 * tauElectronFakeEnergyCorrectionThreeProngShift;
-
-				// settings for (cached) Svfit calculation
-				(static_cast<HttProduct&>(product)).m_systematicShift = HttEnumTypes::SystematicShift::TAU_ELECTRON_FAKE_ES_3PRONG;
-				(static_cast<HttProduct&>(product)).m_systematicShiftSigma = tauElectronFakeEnergyCorrectionThreeProngShift;
-			}
-		}
-	}
-	// -------------------------------------
-	// muon->tau fake energy scale shifts
-	float tauMuonFakeEnergyCorrectionShift = static_cast<HttSettings const&>(settings).GetTauMuonFakeEnergyCorrectionShift();
-	float tauMuonFakeEnergyCorrectionOneProngShift = static_cast<HttSettings const&>(settings).GetTauMuonFakeEnergyCorrectionOneProngShift();
-	float tauMuonFakeEnergyCorrectionOneProngPiZerosShift = static_cast<HttSettings const&>(settings).GetTauMuonFakeEnergyCorrectionOneProngPiZerosShift();
-	float tauMuonFakeEnergyCorrectionThreeProngShift = static_cast<HttSettings const&>(settings).GetTauMuonFakeEnergyCorrectionThreeProngShift();
-	if (tauMuonFakeEnergyCorrectionShift != 1.0 ||
-		tauMuonFakeEnergyCorrectionOneProngShift != 1.0 ||
-		tauMuonFakeEnergyCorrectionOneProngPiZerosShift != 1.0 ||
-		tauMuonFakeEnergyCorrectionThreeProngShift != 1.0)
-	{
-		if ((genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_MUON_PROMPT) || (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_MUON_FROM_TAU))
-		{
-			// inclusive
-			if (tauMuonFakeEnergyCorrectionShift != 1.0)
-			{
-				tau->p4 = tau->p4 * tauMuonFakeEnergyCorrectionShift;
-
-				// settings for (cached) Svfit calculation
-				(static_cast<HttProduct&>(product)).m_systematicShift = HttEnumTypes::SystematicShift::TAU_MUON_FAKE_ES;
-				(static_cast<HttProduct&>(product)).m_systematicShiftSigma = tauEnergyCorrectionShift;
-			}
-			// 1-prongs only
-			if (tauMuonFakeEnergyCorrectionOneProngShift != 1.0 && tau->decayMode == 0)
-			{
-				tau->p4 = tau->p4 * tauMuonFakeEnergyCorrectionOneProngShift;
-
-				// settings for (cached) Svfit calculation
-				(static_cast<HttProduct&>(product)).m_systematicShift = HttEnumTypes::SystematicShift::TAU_MUON_FAKE_ES_1PRONG;
-				(static_cast<HttProduct&>(product)).m_systematicShiftSigma = tauMuonFakeEnergyCorrectionOneProngShift;
-			}
-			// 1-prong+pi0s only
-			if (tauMuonFakeEnergyCorrectionOneProngPiZerosShift != 1.0 && (tau->decayMode == 1 || tau->decayMode == 2))
-			{
-				tau->p4 = tau->p4 * tauMuonFakeEnergyCorrectionOneProngPiZerosShift;
-
-				// settings for (cached) Svfit calculation
-				(static_cast<HttProduct&>(product)).m_systematicShift = HttEnumTypes::SystematicShift::TAU_MUON_FAKE_ES_1PRONGPI0S;
-				(static_cast<HttProduct&>(product)).m_systematicShiftSigma = tauMuonFakeEnergyCorrectionOneProngPiZerosShift;
-			}
-			// 3-prongs only
-			if (tauMuonFakeEnergyCorrectionThreeProngShift != 1.0 && tau->decayMode == 10)
-			{
-				tau->p4 = tau->p4 * tauMuonFakeEnergyCorrectionThreeProngShift;
-
-				// settings for (cached) Svfit calculation
-				(static_cast<HttProduct&>(product)).m_systematicShift = HttEnumTypes::SystematicShift::TAU_MUON_FAKE_ES_3PRONG;
-				(static_cast<HttProduct&>(product)).m_systematicShiftSigma = tauMuonFakeEnergyCorrectionThreeProngShift;
-			}
-		}
+		(static_cast<HttProduct&>(product)).m_systematicShift = correction.systematicShift;
+		(static_cast<HttProduct&>(product)).m_systematicShiftSigma = correction.systematicShiftSigma;
 	}
+	
 	// -------------------------------------
 	// jet->tau fake energy scale shifts
-	float tauJetFakeEnergyCorrectionShift = static_cast<HttSettings const&>(settings).GetTauJetFakeEnergyCorrection();
-	if (tauJetFakeEnergyCorrectionShift != 0.0)
+	if (m_tauJetFakeEnergyCorrectionShift != 0.0)
 	{
 		if (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_FAKE)
 		{
 			// maximum shift of 40% for pt > 200 GeV
 			double shift = tau->p4.Pt() < 200. ? 0.2 * tau->p4.Pt() / 100. : 0.4;
 
-			tau->p4 = tau->p4 * (1 - tauJetFakeEnergyCorrectionShift * shift);
+			tau->p4 = tau->p4 * (1 - m_tauJetFakeEnergyCorrectionShift * shift);
 
 			// settings for (cached) Svfit calculation
 			(static_cast<HttProduct&>(product)).m_systematicShift = HttEnumTypes::SystematicShift::TAU_JET_FAKE_ES;
-			(static_cast<HttProduct&>(product)).m_systematicShiftSigma = tauJetFakeEnergyCorrectionShift;
+			(static_cast<HttProduct&>(product)).m_systematicShiftSigma = m_tauJetFakeEnergyCorrectionShift;
 		}
 	}
-	(static_cast<HttProduct&>(product)).m_tauEnergyScaleWeight[tau] = normalisationFactor;
-		float randomTauEnergySmearing = static_cast<HttSettings const&>(settings).GetRandomTauEnergySmearing();
+	(static_cast<HttProduct&>(product)).m_tauEnergyScaleWeight[tau] = correction.normalisationFactor;
+}
+
+void HttTauCorrectionsProducer::Produce(event_type const& event, product_type& product,
+                                        setting_type const& settings) const
+{
+	TauCorrectionsProducer::Produce(event, product, settings);
 	
-	if (randomTauEnergySmearing != 0.0)
-	{	
-		double r;
-		TRandom *r3 = new TRandom3();
-		r3->SetSeed(event.m_eventInfo->nEvent);
-		r = (1.0+r3->Gaus(0,randomTauEnergySmearing));
-		tau->p4 = tau->p4 * r;
+	// the smearing is applied in the loop over all corrected taus, such that the index is known
+	if (m_randomTauEnergySmearing != 0.0)
+	{
+		CounterBasedRandom::SmearMomenta(product.m_correctedTaus, event.m_eventInfo, m_randomStreamId, m_randomTauEnergySmearing);
 	}
 }
 
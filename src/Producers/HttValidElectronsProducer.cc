@@ -79,6 +79,16 @@ void HttValidElectronsProducer::Init(setting_type const& settings)
 	electronIDName = (settings.*GetElectronIDName)();
 	electronIDList = (settings.*GetElectronIDList)();
 
+	// the positions of the IDs in the metadata are resolved once per lumi section
+	electronIDNameHandle = electronIdBinding.Register(electronIDName);
+	electronIDListHandles.clear();
+	for (std::string const& idName : electronIDList)
+	{
+		electronIDListHandles.push_back(electronIdBinding.Register(idName));
+	}
+	mvaTrigV0Handle = electronIdBinding.Register("mvaTrigV0");
+	mvaNonTrigV0Handle = electronIdBinding.Register("mvaNonTrigV0");
+
 	electronMvaIDCutEB1 = (settings.*GetElectronMvaIDCutEB1)();
 	electronMvaIDCutEB2 = (settings.*GetElectronMvaIDCutEB2)();
 	electronMvaIDCutEE = (settings.*GetElectronMvaIDCutEE)();
@@ -92,23 +102,23 @@ void HttValidElectronsProducer::Init(setting_type const& settings)
 	});
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("id_e_mva_nt_loose_1", [this](event_type const& event, product_type const& product)
 	{
-		return (product.m_validElectrons.size() >= 1 && electronIDType != ElectronIDType::NONE) ? product.m_validElectrons[0]->getId(electronIDList.at(0), event.m_electronMetadata) : DefaultValues::UndefinedFloat;
+		return (product.m_validElectrons.size() >= 1 && electronIDType != ElectronIDType::NONE) ? electronIdBinding.GetId(product.m_validElectrons[0], electronIDListHandles.at(0), event.m_electronMetadata, event.m_eventInfo) : DefaultValues::UndefinedFloat;
 	});
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("id_e_cut_veto_1", [this](event_type const& event, product_type const& product)
 	{
-		return (product.m_validElectrons.size() >= 1 && electronIDType != ElectronIDType::NONE) ? product.m_validElectrons[0]->getId(electronIDList.at(1), event.m_electronMetadata) : DefaultValues::UndefinedFloat;
+		return (product.m_validElectrons.size() >= 1 && electronIDType != ElectronIDType::NONE) ? electronIdBinding.GetId(product.m_validElectrons[0], electronIDListHandles.at(1), event.m_electronMetadata, event.m_eventInfo) : DefaultValues::UndefinedFloat;
 	});
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("id_e_cut_loose_1", [this](event_type const& event, product_type const& product)
 	{
-		return (product.m_validElectrons.size() >= 1 && electronIDType != ElectronIDType::NONE) ? product.m_validElectrons[0]->getId(electronIDList.at(2), event.m_electronMetadata) : DefaultValues::UndefinedFloat;
+		return (product.m_validElectrons.size() >= 1 && electronIDType != ElectronIDType::NONE) ? electronIdBinding.GetId(product.m_validElectrons[0], electronIDListHandles.at(2), event.m_electronMetadata, event.m_eventInfo) : DefaultValues::UndefinedFloat;
 	});
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("id_e_cut_medium_1", [this](event_type const& event, product_type const& product)
 	{
-		return (product.m_validElectrons.size() >= 1 && electronIDType != ElectronIDType::NONE) ? product.m_validElectrons[0]->getId(electronIDList.at(3), event.m_electronMetadata) : DefaultValues::UndefinedFloat;
+		return (product.m_validElectrons.size() >= 1 && electronIDType != ElectronIDType::NONE) ? electronIdBinding.GetId(product.m_validElectrons[0], electronIDListHandles.at(3), event.m_electronMetadata, event.m_eventInfo) : DefaultValues::UndefinedFloat;
 	});
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("id_e_cut_tight_1", [this](event_type const& event, product_type const& product)
 	{
-		return (product.m_validElectrons.size() >= 1 && electronIDType != ElectronIDType::NONE) ? product.m_validElectrons[0]->getId(electronIDList.at(4), event.m_electronMetadata) : DefaultValues::UndefinedFloat;
+		return (product.m_validElectrons.size() >= 1 && electronIDType != ElectronIDType::NONE) ? electronIdBinding.GetId(product.m_validElectrons[0], electronIDListHandles.at(4), event.m_electronMetadata, event.m_eventInfo) : DefaultValues::UndefinedFloat;
 	});
 }
 
@@ -150,13 +160,13 @@ bool HttValidElectronsProducer::AdditionalCriteria(KElectron* electron,
 		{
 			assert(CheckElectronMetadata(event.m_electronMetadata, electronIDName, electronIDInMetadata));
 			assert(CheckElectronMetadata(event.m_electronMetadata, electronIDList, electronIDListInMetadata));
-			validElectron = validElectron && IsCutBased(&(*electron), event, electronIDName);
+			validElectron = validElectron && IsCutBased(&(*electron), event, electronIDNameHandle);
 		}
 		else if (electronIDType == ElectronIDType::MVABASED2015ANDLATER)
 		{
 			assert(CheckElectronMetadata(event.m_electronMetadata, electronIDName, electronIDInMetadata));
 			assert(CheckElectronMetadata(event.m_electronMetadata, electronIDList, electronIDListInMetadata));
-			validElectron = validElectron && IsMVABased(&(*electron), event, electronIDName);
+			validElectron = validElectron && IsMVABased(&(*electron), event, electronIDNameHandle);
 		}
 		else if (electronIDType == ElectronIDType::CUTBASED2015NOISOANDIPCUTSVETO)
 		{
@@ -307,7 +317,7 @@ bool HttValidElectronsProducer::IsMVATrigElectronTTHSummer2013(KElectron* electr
 {
 	bool validElectron = true;
 	
-	validElectron = validElectron && electron->getId("mvaTrigV0", event.m_electronMetadata) > (tightID ? 0.5 : 0.5);
+	validElectron = validElectron && electronIdBinding.GetId(electron, mvaTrigV0Handle, event.m_electronMetadata, event.m_eventInfo) > (tightID ? 0.5 : 0.5);
 
 	return validElectron;
 }
@@ -323,18 +333,18 @@ bool HttValidElectronsProducer::IsMVANonTrigElectronHttSummer2013(KElectron* ele
 				(electron->p4.Pt() < 20.0)
 				&&
 				(
-					(std::abs(electron->superclusterPosition.Eta()) < 0.8 && electron->getId("mvaNonTrigV0", event.m_electronMetadata) > 0.925)
-					|| (std::abs(electron->superclusterPosition.Eta()) > 0.8 && std::abs(electron->superclusterPosition.Eta()) < DefaultValues::EtaBorderEB && electron->getId("mvaNonTrigV0", event.m_electronMetadata) > 0.915)
-					|| (std::abs(electron->superclusterPosition.Eta()) > DefaultValues::EtaBorderEB && electron->getId("mvaNonTrigV0", event.m_electronMetadata) > 0.965)
+					(std::abs(electron->superclusterPosition.Eta()) < 0.8 && electronIdBinding.GetId(electron, mvaNonTrigV0Handle, event.m_electronMetadata, event.m_eventInfo) > 0.925)
+					|| (std::abs(electron->superclusterPosition.Eta()) > 0.8 && std::abs(electron->superclusterPosition.Eta()) < DefaultValues::EtaBorderEB && electronIdBinding.GetId(electron, mvaNonTrigV0Handle, event.m_electronMetadata, event.m_eventInfo) > 0.915)
+					|| (std::abs(electron->superclusterPosition.Eta()) > DefaultValues::EtaBorderEB && electronIdBinding.GetId(electron, mvaNonTrigV0Handle, event.m_electronMetadata, event.m_eventInfo) > 0.965)
 				)
 			)
 			||
 			(
 				(electron->p4.Pt() >= 20.0) &&
 				(
-					(std::abs(electron->superclusterPosition.Eta()) < 0.8 && electron->getId("mvaNonTrigV0", event.m_electronMetadata) > (tightID ? 0.925 : 0.905))
-					|| (std::abs(electron->superclusterPosition.Eta()) > 0.8 && std::abs(electron->superclusterPosition.Eta()) < DefaultValues::EtaBorderEB && electron->getId("mvaNonTrigV0", event.m_electronMetadata) > (tightID ? 0.975 : 0.955))
-					|| (std::abs(electron->superclusterPosition.Eta()) > DefaultValues::EtaBorderEB && electron->getId("mvaNonTrigV0", event.m_electronMetadata) > (tightID ? 0.985 : 0.975))
+					(std::abs(electron->superclusterPosition.Eta()) < 0.8 && electronIdBinding.GetId(electron, mvaNonTrigV0Handle, event.m_electronMetadata, event.m_eventInfo) > (tightID ? 0.925 : 0.905))
+					|| (std::abs(electron->superclusterPosition.Eta()) > 0.8 && std::abs(electron->superclusterPosition.Eta()) < DefaultValues::EtaBorderEB && electronIdBinding.GetId(electron, mvaNonTrigV0Handle, event.m_electronMetadata, event.m_eventInfo) > (tightID ? 0.975 : 0.955))
+					|| (std::abs(electron->superclusterPosition.Eta()) > DefaultValues::EtaBorderEB && electronIdBinding.GetId(electron, mvaNonTrigV0Handle, event.m_electronMetadata, event.m_eventInfo) > (tightID ? 0.985 : 0.975))
 				)
 			)
 		);
@@ -342,12 +352,12 @@ bool HttValidElectronsProducer::IsMVANonTrigElectronHttSummer2013(KElectron* ele
 	return validElectron;
 }
 
-bool HttValidElectronsProducer::IsCutBased(KElectron* electron, event_type const& event, const std::string &idName) const
+bool HttValidElectronsProducer::IsCutBased(KElectron* electron, event_type const& event, size_t idHandle) const
 {
 	bool validElectron = true;
 
 	validElectron = validElectron
-			&& electron->getId(idName, event.m_electronMetadata);
+			&& electronIdBinding.GetId(electron, idHandle, event.m_electronMetadata, event.m_eventInfo);
 
 	return validElectron;
 }
@@ -380,7 +390,7 @@ bool HttValidElectronsProducer::IsCutBased(KElectron* electron, event_type const
 	return validElectron;
 }
 
-bool HttValidElectronsProducer::IsMVABased(KElectron* electron, event_type const& event, const std::string &idName) const
+bool HttValidElectronsProducer::IsMVABased(KElectron* electron, event_type const& event, size_t idHandle) const
 {
 	bool validElectron = true;
 
@@ -388,11 +398,11 @@ bool HttValidElectronsProducer::IsMVABased(KElectron* electron, event_type const
 	// pT always greater than 10 GeV
 	validElectron = validElectron &&
 		(
-			(std::abs(electron->superclusterPosition.Eta()) < 0.8 && electron->getId(idName, event.m_electronMetadata) > electronMvaIDCutEB1)
+			(std::abs(electron->superclusterPosition.Eta()) < 0.8 && electronIdBinding.GetId(electron, idHandle, event.m_electronMetadata, event.m_eventInfo) > electronMvaIDCutEB1)
 			||
-			(std::abs(electron->superclusterPosition.Eta()) > 0.8 && std::abs(electron->superclusterPosition.Eta()) < DefaultValues::EtaBorderEB && electron->getId(idName, event.m_electronMetadata) > electronMvaIDCutEB2)
+			(std::abs(electron->superclusterPosition.Eta()) > 0.8 && std::abs(electron->superclusterPosition.Eta()) < DefaultValues::EtaBorderEB && electronIdBinding.GetId(electron, idHandle, event.m_electronMetadata, event.m_eventInfo) > electronMvaIDCutEB2)
 			||
-			(std::abs(electron->superclusterPosition.Eta()) > DefaultValues::EtaBorderEB && electron->getId(idName, event.m_electronMetadata) > electronMvaIDCutEE)
+			(std::abs(electron->superclusterPosition.Eta()) > DefaultValues::EtaBorderEB && electronIdBinding.GetId(electron, idHandle, event.m_electronMetadata, event.m_eventInfo) > electronMvaIDCutEE)
 		);
 
 	return validElectron;
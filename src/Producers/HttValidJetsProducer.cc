@@ -12,6 +12,16 @@ bool HttValidJetsProducer::AdditionalCriteria(KBasicJet* jet,
 }
 
 
+void HttValidTaggedJetsProducer::Produce(event_type const& event, product_type& product,
+                                         setting_type const& settings) const
+{
+	m_validTTHTauIndex.Clear();
+	m_validTTHTauIndex.AddAll(static_cast<HttProduct const&>(product).m_validTTHTaus);
+
+	ValidTaggedJetsProducer::Produce(event, product, settings);
+}
+
+
 bool HttValidTaggedJetsProducer::AdditionalCriteria(KJet* jet,
                                                     event_type const& event, product_type& product,
                                                     setting_type const& settings) const
@@ -19,15 +29,10 @@ bool HttValidTaggedJetsProducer::AdditionalCriteria(KJet* jet,
 	bool validJet = ValidTaggedJetsProducer::AdditionalCriteria(jet, event, product, settings);
 	
 	HttSettings const& specSettings = static_cast<HttSettings const&>(settings);
-	HttProduct const& specProduct = static_cast<HttProduct const&>(product);
 	
 	// remove taus from list of jets via simple DeltaR isolation
 	// (targeted at ttH analysis, harmless if m_validTTHTaus is not filled)
-	for (std::vector<KTau*>::const_iterator tau = specProduct.m_validTTHTaus.begin();
-		validJet && tau != specProduct.m_validTTHTaus.end(); ++tau)
-		{
-			validJet = validJet && ROOT::Math::VectorUtil::DeltaR(jet->p4, (*tau)->p4) > specSettings.GetJetTauLowerDeltaRCut();
-		}
+	validJet = validJet && (! m_validTTHTauIndex.Overlaps(jet->p4, specSettings.GetJetTauLowerDeltaRCut()));
 
 	return validJet;
 }
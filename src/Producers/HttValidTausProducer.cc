@@ -2,6 +2,17 @@
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/HttValidTausProducer.h"
 
 
+void HttValidTausProducer::Produce(KappaEvent const& event, KappaProduct& product,
+                                   KappaSettings const& settings) const
+{
+	validElectronIndex.Clear();
+	validElectronIndex.AddAll(product.m_validElectrons);
+	validMuonIndex.Clear();
+	validMuonIndex.AddAll(product.m_validMuons);
+
+	ValidTausProducer::Produce(event, product, settings);
+}
+
 bool HttValidTausProducer::AdditionalCriteria(KTau* tau,
                                               KappaEvent const& event, KappaProduct& product,
                                               KappaSettings const& settings) const
@@ -14,7 +25,7 @@ bool HttValidTausProducer::AdditionalCriteria(KTau* tau,
 
 	bool validTau = ValidTausProducer::AdditionalCriteria(tau, event, product, settings);
 	
-	double isolationPtSum = tau->getDiscriminator(specSettings.GetTauDiscriminatorIsolationName(), event.m_tauMetadata);
+	double isolationPtSum = tauDiscriminatorBinding.GetDiscriminator(tau, isolationDiscriminatorHandle, event.m_tauMetadata, event.m_eventInfo);
 	double isolationPtSumOverPt = isolationPtSum / tau->p4.Pt();
 	
 	specProduct.m_leptonIsolation[tau] = isolationPtSum;
@@ -57,14 +68,8 @@ bool HttValidTausProducer::AdditionalCriteria(KTau* tau,
 	}
 	
 	// remove taus which overlap with electrons and muons in a DeltaR cone
-	for (std::vector<KElectron*>::const_iterator electron = product.m_validElectrons.begin(); validTau && electron != product.m_validElectrons.end(); ++electron)
-		{
-			validTau = validTau && ROOT::Math::VectorUtil::DeltaR(tau->p4, (*electron)->p4) > specSettings.GetTauElectronLowerDeltaRCut();
-		}
-	for (std::vector<KMuon*>::const_iterator muon = product.m_validMuons.begin(); validTau && muon != product.m_validMuons.end(); ++muon)
-		{
-			validTau = validTau && ROOT::Math::VectorUtil::DeltaR(tau->p4, (*muon)->p4) > specSettings.GetTauMuonLowerDeltaRCut();
-		}
+	validTau = validTau && (! validElectronIndex.Overlaps(tau->p4, specSettings.GetTauElectronLowerDeltaRCut()));
+	validTau = validTau && (! validMuonIndex.Overlaps(tau->p4, specSettings.GetTauMuonLowerDeltaRCut()));
 
 	// cut on impact parameters of track
 	validTau = validTau
@@ -86,7 +91,7 @@ bool HttValidTausProducer::ApplyCustomMvaIsolationCut(KTau* tau, KappaEvent cons
 {
 	bool validTau = true;
 
-	float discriminator = tau->getDiscriminator("hpsPFTauDiscriminationByIsolationMVA2raw", event.m_tauMetadata);
+	float discriminator = tauDiscriminatorBinding.GetDiscriminator(tau, mvaIsolationDiscriminatorHandle, event.m_tauMetadata, event.m_eventInfo);
 
 	validTau = validTau && discriminator > *std::max_element(MvaIsolationCuts.begin(), MvaIsolationCuts.end());
 	
@@ -108,8 +113,8 @@ bool HttValidTausProducer::ApplyCustomElectronRejection(KTau* tau, KappaEvent co
 		return validTau;
 	}
 
-	int category = (int)(tau->getDiscriminator("hpsPFTauDiscriminationByMVA3rawElectronRejectioncategory", event.m_tauMetadata) + 0.5);
-	float discriminator = tau->getDiscriminator("hpsPFTauDiscriminationByMVA3rawElectronRejection", event.m_tauMetadata);
+	int category = (int)(tauDiscriminatorBinding.GetDiscriminator(tau, antiElectronMvaCategoryHandle, event.m_tauMetadata, event.m_eventInfo) + 0.5);
+	float discriminator = tauDiscriminatorBinding.GetDiscriminator(tau, antiElectronMvaDiscriminatorHandle, event.m_tauMetadata, event.m_eventInfo);
 
 	if (category < 0)
 	{
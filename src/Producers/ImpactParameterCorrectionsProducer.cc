@@ -1,3 +1,11 @@
+#include <cmath>
+
+#include <TFile.h>
+#include <TH1.h>
+#include <TF1.h>
+#include <TGraph.h>
+#include <TMath.h>
+
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/DefaultValues.h"
 #include "Artus/KappaAnalysis/interface/Utility/GeneratorInfo.h"
@@ -108,6 +116,30 @@ void ImpactParameterCorrectionsProducer::Init(setting_type const& settings)
 					if (config[dca_direction][dca_reference][gen_match][source]!="none" && config[dca_direction][dca_reference][gen_match][target]!="none"){
 						shifter[dca_direction][dca_reference][gen_match].init(rootfile, config[dca_direction][dca_reference][gen_match][source], config[dca_direction][dca_reference][gen_match][target], true);
 						shift[dca_direction][dca_reference][gen_match] = true;
+
+						// convert the shifter into a lookup table over the range of the source distribution
+						double xMin = 0.0;
+						double xMax = 0.0;
+						if (settings.GetUseQuantileMappingTables() && GetSourceRange(rootfile, config[dca_direction][dca_reference][gen_match][source], xMin, xMax))
+						{
+							QuantileShifter* exactShifter = &(shifter[dca_direction][dca_reference][gen_match]);
+							TabulatedQuantileShifter::mapping_function mapping = [exactShifter](double x) { return exactShifter->shift(x); };
+							double tolerance = settings.GetQuantileMappingTableTolerance() * std::abs(mapping(xMax) - mapping(xMin));
+							tabulatedShifter[dca_direction][dca_reference][gen_match].Build(
+									mapping, xMin, xMax,
+									settings.GetQuantileMappingTableInitialPoints(),
+									settings.GetQuantileMappingTableMaxPoints(),
+									tolerance
+							);
+							LOG(INFO) << "Quantile mapping " << config[dca_direction][dca_reference][gen_match][source] << " -> " << config[dca_direction][dca_reference][gen_match][target]
+							          << " tabulated in [" << xMin << ", " << xMax << "] with " << tabulatedShifter[dca_direction][dca_reference][gen_match].GetNPoints()
+							          << " points, maximal deviation " << tabulatedShifter[dca_direction][dca_reference][gen_match].GetMaxDeviation()
+							          << " (tolerance " << tolerance << ").";
+							if (! tabulatedShifter[dca_direction][dca_reference][gen_match].IsMonotone())
+							{
+								LOG(WARNING) << "Tabulated quantile mapping " << config[dca_direction][dca_reference][gen_match][source] << " -> " << config[dca_direction][dca_reference][gen_match][target] << " is not monotone!";
+							}
+						}
 					}
 				}
 			}
@@ -155,7 +187,15 @@ void ImpactParameterCorrectionsProducer::Produce(event_type const& event, produc
 			for (int dca_direction = 0; dca_direction < 2; dca_direction++){
 				for (int dca_reference = 0; dca_reference < 2; dca_reference++){
 					if (shift[dca_direction][dca_reference][gen_match]){
-						product.m_DCAcalib[dca_direction][dca_reference][leptonIndex] = shifter[dca_direction][dca_reference][gen_match].shift(DCA[dca_direction][dca_reference][leptonIndex]);
+						TabulatedQuantileShifter const& table = tabulatedShifter[dca_direction][dca_reference][gen_match];
+						if (table.InRange(DCA[dca_direction][dca_reference][leptonIndex]))
+						{
+							product.m_DCAcalib[dca_direction][dca_reference][leptonIndex] = table.Shift(DCA[dca_direction][dca_reference][leptonIndex]);
+						}
+						else
+						{
+							product.m_DCAcalib[dca_direction][dca_reference][leptonIndex] = shifter[dca_direction][dca_reference][gen_match].shift(DCA[dca_direction][dca_reference][leptonIndex]);
+						}
 					}
 					// if one correction is applied, however use uncalibrated value in order to get a partially calibrated distribution
 					else if(shift[dca_direction][dca_reference][1] || shift[dca_direction][dca_reference][2] || shift[dca_direction][dca_reference][3] || shift[dca_direction][dca_reference][4] || shift[dca_direction][dca_reference][5]){
@@ -165,4 +205,40 @@ void ImpactParameterCorrectionsProducer::Produce(event_type const& event, produc
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+bool ImpactParameterCorrectionsProducer::GetSourceRange(std::string const& rootfile, std::string const& source, double& xMin, double& xMax)
+{
+	TDirectory* savedir(gDirectory);
+	TFile* savefile(gFile);
+	TFile file(rootfile.c_str());
+	TObject* object = file.Get(source.c_str());
+
+	bool found = true;
+	if (object && object->InheritsFrom(TH1::Class()))
+	{
+		xMin = static_cast<TH1*>(object)->GetXaxis()->GetXmin();
+		xMax = static_cast<TH1*>(object)->GetXaxis()->GetXmax();
+	}
+	else if (object && object->InheritsFrom(TGraph::Class()) && (static_cast<TGraph*>(object)->GetN() > 1))
+	{
+		TGraph* graph = static_cast<TGraph*>(object);
+		xMin = TMath::MinElement(graph->GetN(), graph->GetX());
+		xMax = TMath::MaxElement(graph->GetN(), graph->GetX());
+	}
+	else if (object && object->InheritsFrom(TF1::Class()))
+	{
+		xMin = static_cast<TF1*>(object)->GetXmin();
+		xMax = static_cast<TF1*>(object)->GetXmax();
+	}
+	else
+	{
+		LOG(WARNING) << "Could not determine the range of the quantile mapping source " << source << " in " << rootfile << ", the exact quantile mapping is used.";
+		found = false;
+	}
+
+	file.Close();
+	gDirectory = savedir;
+	gFile = savefile;
+	return found && (xMin < xMax);
+}
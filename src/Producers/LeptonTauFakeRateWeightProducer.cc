@@ -0,0 +1,253 @@
+
+#include <algorithm>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/SafeMap.h"
+#include "Artus/KappaAnalysis/interface/Utility/GeneratorInfo.h"
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/LeptonTauFakeRateWeightProducer.h"
+
+
+size_t LeptonTauFakeRateWeightProducer::Binning::GetNBins() const
+{
+	return ((variable == BinningVariable::DECAY_MODE) ? edges.size() : (edges.size() - 1));
+}
+
+int LeptonTauFakeRateWeightProducer::Binning::FindBin(float value) const
+{
+	if (variable == BinningVariable::DECAY_MODE)
+	{
+		std::vector<float>::const_iterator decayMode = std::find(edges.begin(), edges.end(), value);
+		return ((decayMode != edges.end()) ? (decayMode - edges.begin()) : -1);
+	}
+
+	if ((value < edges.front()) || (! (value < edges.back())))
+	{
+		return -1;
+	}
+	return ((std::upper_bound(edges.begin(), edges.end(), value) - edges.begin()) - 1);
+}
+
+std::string LeptonTauFakeRateWeightProducer::GetProducerId() const
+{
+	return "LeptonTauFakeRateWeightProducer";
+}
+
+void LeptonTauFakeRateWeightProducer::Init(setting_type const& settings)
+{
+	ProducerBase<HttTypes>::Init(settings);
+
+	m_decayChannel = HttEnumTypes::ToDecayChannel(boost::algorithm::to_lower_copy(boost::algorithm::trim_copy(settings.GetChannel())));
+	m_weightNames.clear();
+	m_tablesByLeg[0].clear();
+	m_tablesByLeg[1].clear();
+
+	AddTables(settings);
+}
+
+void LeptonTauFakeRateWeightProducer::AddTables(setting_type const& settings)
+{
+	for (std::string const& table : settings.GetLeptonTauFakeRateWeightTables())
+	{
+		ParseTable(table);
+	}
+}
+
+void LeptonTauFakeRateWeightProducer::AddTable(std::string const& weightName, HttEnumTypes::DecayChannel decayChannel, size_t leg,
+                                               GenMatchClass genMatchClass, std::vector<Binning> const& binnings, std::vector<float> const& values)
+{
+	// the weight is written in all channels
+	std::vector<std::string>::iterator weightNamePosition = std::find(m_weightNames.begin(), m_weightNames.end(), weightName);
+	size_t weightIndex = weightNamePosition - m_weightNames.begin();
+	if (weightNamePosition == m_weightNames.end())
+	{
+		m_weightNames.push_back(weightName);
+	}
+
+	if ((leg < 1) || (leg > 2))
+	{
+		LOG(FATAL) << "Invalid leg " << leg << " for the lepton to tau fake rate weight \"" << weightName << "\", only 1 and 2 are allowed!";
+	}
+
+	size_t nBins = 1;
+	for (Binning const& binning : binnings)
+	{
+		if (((binning.variable == BinningVariable::DECAY_MODE) && binning.edges.empty()) ||
+		    ((binning.variable != BinningVariable::DECAY_MODE) && ((binning.edges.size() < 2) || (! std::is_sorted(binning.edges.begin(), binning.edges.end())))))
+		{
+			LOG(FATAL) << "Invalid binning for the lepton to tau fake rate weight \"" << weightName << "\"!";
+		}
+		nBins *= binning.GetNBins();
+	}
+	if (values.size() != nBins)
+	{
+		LOG(FATAL) << "The lepton to tau fake rate weight \"" << weightName << "\" has " << values.size() << " values for " << nBins << " bins!";
+	}
+
+	if (decayChannel == m_decayChannel)
+	{
+		FakeRateTable fakeRateTable;
+		fakeRateTable.weightIndex = weightIndex;
+		fakeRateTable.genMatchClass = genMatchClass;
+		fakeRateTable.binnings = binnings;
+		fakeRateTable.values = values;
+		m_tablesByLeg[leg - 1].push_back(fakeRateTable);
+	}
+}
+
+void LeptonTauFakeRateWeightProducer::ParseTable(std::string const& table)
+{
+	std::vector<std::string> fields;
+	boost::algorithm::split(fields, table, boost::algorithm::is_any_of(":"));
+	for (std::string& field : fields)
+	{
+		boost::algorithm::trim(field);
+	}
+	if (fields.size() != 6)
+	{
+		LOG(FATAL) << "Lepton to tau fake rate weight table \"" << table << "\" does not follow the format \"<weight name>:<channel>:<leg>:<ele|muon>:<binning>:<values>\"!";
+	}
+
+	HttEnumTypes::DecayChannel decayChannel = HttEnumTypes::ToDecayChannel(boost::algorithm::to_lower_copy(fields[1]));
+	if (decayChannel == HttEnumTypes::DecayChannel::NONE)
+	{
+		LOG(FATAL) << "Invalid channel \"" << fields[1] << "\" in lepton to tau fake rate weight table \"" << table << "\"!";
+	}
+	size_t leg = boost::lexical_cast<size_t>(fields[2]);
+
+	GenMatchClass genMatchClass = GenMatchClass::ELECTRON;
+	if (fields[3] == "ele")
+	{
+		genMatchClass = GenMatchClass::ELECTRON;
+	}
+	else if (fields[3] == "muon")
+	{
+		genMatchClass = GenMatchClass::MUON;
+	}
+	else
+	{
+		LOG(FATAL) << "Invalid gen matching \"" << fields[3] << "\" in lepton to tau fake rate weight table \"" << table << "\", only \"ele\" and \"muon\" are allowed!";
+	}
+
+	std::vector<Binning> binnings;
+	std::vector<std::string> binningStrings;
+	boost::algorithm::split(binningStrings, fields[4], boost::algorithm::is_any_of(";"));
+	for (std::string const& binningString : binningStrings)
+	{
+		std::vector<std::string> variableAndEdges;
+		boost::algorithm::split(variableAndEdges, binningString, boost::algorithm::is_any_of("="));
+		if (variableAndEdges.size() != 2)
+		{
+			LOG(FATAL) << "Invalid binning \"" << binningString << "\" in lepton to tau fake rate weight table \"" << table << "\"!";
+		}
+
+		Binning binning;
+		std::string variable = boost::algorithm::trim_copy(variableAndEdges[0]);
+		if (variable == "absEta") binning.variable = BinningVariable::ABS_ETA;
+		else if (variable == "pt") binning.variable = BinningVariable::PT;
+		else if (variable == "decayMode") binning.variable = BinningVariable::DECAY_MODE;
+		else LOG(FATAL) << "Invalid binning variable \"" << variable << "\" in lepton to tau fake rate weight table \"" << table << "\", only \"absEta\", \"pt\" and \"decayMode\" are allowed!";
+
+		std::vector<std::string> edges;
+		boost::algorithm::split(edges, variableAndEdges[1], boost::algorithm::is_any_of(","));
+		for (std::string const& edge : edges)
+		{
+			binning.edges.push_back(boost::lexical_cast<float>(boost::algorithm::trim_copy(edge)));
+		}
+		binnings.push_back(binning);
+	}
+
+	std::vector<float> values;
+	std::vector<std::string> valueStrings;
+	boost::algorithm::split(valueStrings, fields[5], boost::algorithm::is_any_of(","));
+	for (std::string const& value : valueStrings)
+	{
+		values.push_back(boost::lexical_cast<float>(boost::algorithm::trim_copy(value)));
+	}
+
+	AddTable(fields[0], decayChannel, leg, genMatchClass, binnings, values);
+}
+
+void LeptonTauFakeRateWeightProducer::Produce(event_type const& event, product_type& product,
+                                              setting_type const& settings) const
+{
+	std::vector<float> weights(m_weightNames.size(), 1.0);
+
+	for (size_t legIndex = 0; legIndex < 2; ++legIndex)
+	{
+		if (m_tablesByLeg[legIndex].empty())
+		{
+			continue;
+		}
+
+		// one gen matching per leg for all tables
+		KappaEnumTypes::GenMatchingCode genMatchingCode = KappaEnumTypes::GenMatchingCode::NONE;
+		KLepton* lepton = product.m_flavourOrderedLeptons[legIndex];
+		KLepton* originalLepton = const_cast<KLepton*>(SafeMap::GetWithDefault(product.m_originalLeptons, const_cast<const KLepton*>(lepton), const_cast<const KLepton*>(lepton)));
+		if (settings.GetUseUWGenMatching())
+		{
+			genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, originalLepton);
+		}
+		else
+		{
+			KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(originalLepton, product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
+			if (genParticle)
+				genMatchingCode = GeneratorInfo::GetGenMatchingCode(genParticle);
+			else
+				genMatchingCode = KappaEnumTypes::GenMatchingCode::IS_FAKE;
+		}
+
+		GenMatchClass genMatchClass = GenMatchClass::ELECTRON;
+		if ((genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_ELE_PROMPT) || (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_ELE_FROM_TAU))
+		{
+			genMatchClass = GenMatchClass::ELECTRON;
+		}
+		else if ((genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_MUON_PROMPT) || (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_MUON_FROM_TAU))
+		{
+			genMatchClass = GenMatchClass::MUON;
+		}
+		else
+		{
+			continue;
+		}
+
+		float binningValues[3];
+		binningValues[static_cast<int>(BinningVariable::ABS_ETA)] = std::abs(lepton->p4.Eta());
+		binningValues[static_cast<int>(BinningVariable::PT)] = lepton->p4.Pt();
+		binningValues[static_cast<int>(BinningVariable::DECAY_MODE)] = ((lepton->flavour() == KLeptonFlavour::TAU) ? static_cast<KTau*>(lepton)->decayMode : DefaultValues::UndefinedInt);
+
+		for (FakeRateTable const& fakeRateTable : m_tablesByLeg[legIndex])
+		{
+			if (fakeRateTable.genMatchClass != genMatchClass)
+			{
+				continue;
+			}
+
+			int valueIndex = 0;
+			for (Binning const& binning : fakeRateTable.binnings)
+			{
+				int bin = binning.FindBin(binningValues[static_cast<int>(binning.variable)]);
+				if (bin < 0)
+				{
+					valueIndex = -1;
+					break;
+				}
+				valueIndex = valueIndex * binning.GetNBins() + bin;
+			}
+			if (valueIndex >= 0)
+			{
+				weights[fakeRateTable.weightIndex] *= fakeRateTable.values[valueIndex];
+			}
+		}
+	}
+
+	for (size_t weightIndex = 0; weightIndex < m_weightNames.size(); ++weightIndex)
+	{
+		product.m_weights[m_weightNames[weightIndex]] = weights[weightIndex];
+	}
+}
+
@@ -7,6 +7,7 @@
 void MVAInputQuantitiesProducer::Init(setting_type const& settings)
 {
 	ProducerBase<HttTypes>::Init(settings);
+	m_combinedSecondaryVertexHandle = m_jetTagBinding.Register(settings.GetBTaggedJetCombinedSecondaryVertexName());
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("TrainingSelectionValue", [](event_type const& event, product_type const& product) {
 		return (event.m_eventInfo->nEvent)%100;
 	});
@@ -140,7 +141,7 @@ void MVAInputQuantitiesProducer::Produce(event_type const& event, product_type&
 			csvleading = 0;
 			break;
 		case 2:
-			if(static_cast<KJet*>(product.m_validJets.at(1))->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata) > static_cast<KJet*>(product.m_validJets.at(0))->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata)){
+			if(m_jetTagBinding.GetTag(static_cast<KJet*>(product.m_validJets.at(1)), m_combinedSecondaryVertexHandle, event.m_jetMetadata, event.m_eventInfo) > m_jetTagBinding.GetTag(static_cast<KJet*>(product.m_validJets.at(0)), m_combinedSecondaryVertexHandle, event.m_jetMetadata, event.m_eventInfo)){
 				csvleading = 1;
 				csvtrailing = 0;
 			}
@@ -152,7 +153,7 @@ void MVAInputQuantitiesProducer::Produce(event_type const& event, product_type&
 		default:
 			double csv=-1000;
 			for(int i=0; i < int(product.m_validJets.size()); i++){
-				double probecsv = static_cast<KJet*>(product.m_validJets.at(i))->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata);
+				double probecsv = m_jetTagBinding.GetTag(static_cast<KJet*>(product.m_validJets.at(i)), m_combinedSecondaryVertexHandle, event.m_jetMetadata, event.m_eventInfo);
 				if (probecsv > csv){
 					csvleading = i;
 					csv = probecsv;
@@ -160,7 +161,7 @@ void MVAInputQuantitiesProducer::Produce(event_type const& event, product_type&
 			}
 			csv=-1000;
 			for(int i=0; i < int(product.m_validJets.size()); i++){
-				double probecsv = static_cast<KJet*>(product.m_validJets.at(i))->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata);
+				double probecsv = m_jetTagBinding.GetTag(static_cast<KJet*>(product.m_validJets.at(i)), m_combinedSecondaryVertexHandle, event.m_jetMetadata, event.m_eventInfo);
 				if (i != csvleading && probecsv > csv){
 					csvtrailing = i;
 					csv = probecsv;
@@ -168,7 +169,7 @@ void MVAInputQuantitiesProducer::Produce(event_type const& event, product_type&
 			}
 			csv=-1000;
 			for(int i=0; i < int(product.m_validJets.size()); i++){
-				double probecsv = static_cast<KJet*>(product.m_validJets.at(i))->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata);
+				double probecsv = m_jetTagBinding.GetTag(static_cast<KJet*>(product.m_validJets.at(i)), m_combinedSecondaryVertexHandle, event.m_jetMetadata, event.m_eventInfo);
 				if (i != csvleading && i != csvtrailing && probecsv > csv){
 					csv3 = i;
 					csv = probecsv;
@@ -176,7 +177,7 @@ void MVAInputQuantitiesProducer::Produce(event_type const& event, product_type&
 			}
 			csv=-1000;
 			for(int i=0; i < int(product.m_validJets.size()); i++){
-				double probecsv = static_cast<KJet*>(product.m_validJets.at(i))->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata);
+				double probecsv = m_jetTagBinding.GetTag(static_cast<KJet*>(product.m_validJets.at(i)), m_combinedSecondaryVertexHandle, event.m_jetMetadata, event.m_eventInfo);
 				if (i != csvleading && i != csvtrailing && i != csv3 && probecsv > csv && csv4 == -1){
 					csv4 = i;
 					csv = probecsv;
@@ -227,41 +228,41 @@ void MVAInputQuantitiesProducer::Produce(event_type const& event, product_type&
 		product.m_diCJetMass = (product.m_validJets[csvleading]->p4 + product.m_validJets[csvtrailing]->p4).mass();
 		product.m_pVecSumCSVJets = (product.m_met.p4 + product.m_diLeptonSystem + product.m_validJets[csvleading]->p4 + product.m_validJets[csvtrailing]->p4).M();
 	}
-	if (KappaProduct::GetNJetsAbovePtThreshold(product.m_validJets, 30.0) >=1 and product.m_svfitResults.fittedHiggsLV)
+	if (KappaProduct::GetNJetsAbovePtThreshold(product.m_validJets, 30.0) >=1 and product.m_svfitResults.available)
 	{
 		double jet1_eta = product.m_validJets[0]->p4.Eta();
 		double jet1_phi = product.m_validJets[0]->p4.Phi();
-		double svfit_eta = product.m_svfitResults.fittedHiggsLV->Eta();
-		double svfit_phi = product.m_svfitResults.fittedHiggsLV->Phi();
-// 		double svfit_pt = product.m_svfitResults.fittedHiggsLV->Pt();
+		double svfit_eta = product.m_svfitResults.fittedHiggsLV.Eta();
+		double svfit_phi = product.m_svfitResults.fittedHiggsLV.Phi();
+// 		double svfit_pt = product.m_svfitResults.fittedHiggsLV.Pt();
 		product.m_diLepJet1DeltaR = TMath::Sqrt((svfit_eta-jet1_eta)*(svfit_eta-jet1_eta)+(svfit_phi-jet1_phi)*(svfit_phi-jet1_phi));
 	}
 	if (product.m_validJets.size() >= 1)
 	{
 		product.m_diCJetSymEta1 = std::abs(product.m_validJets[csvleading]->p4.Eta());
-		product.m_jccsv1 = static_cast<KJet*>(product.m_validJets.at(csvleading))->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata);
+		product.m_jccsv1 = m_jetTagBinding.GetTag(static_cast<KJet*>(product.m_validJets.at(csvleading)), m_combinedSecondaryVertexHandle, event.m_jetMetadata, event.m_eventInfo);
 		product.m_csv1JetPt = product.m_validJets[csvleading]->p4.Pt();
 		product.m_csv1JetMass = product.m_validJets[csvleading]->p4.mass();
 	}
 	if (product.m_validJets.size() >= 2)
 	{
-		product.m_jccsv2 = static_cast<KJet*>(product.m_validJets.at(csvtrailing))->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata);
+		product.m_jccsv2 = m_jetTagBinding.GetTag(static_cast<KJet*>(product.m_validJets.at(csvtrailing)), m_combinedSecondaryVertexHandle, event.m_jetMetadata, event.m_eventInfo);
 		product.m_csv2JetPt = product.m_validJets[csvtrailing]->p4.Pt();
 		product.m_csv2JetMass = product.m_validJets[csvtrailing]->p4.mass();
 	}
 	if (product.m_validJets.size() >= 3)
 	{
-		product.m_jccsv3 = static_cast<KJet*>(product.m_validJets.at(csv3))->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata);
+		product.m_jccsv3 = m_jetTagBinding.GetTag(static_cast<KJet*>(product.m_validJets.at(csv3)), m_combinedSecondaryVertexHandle, event.m_jetMetadata, event.m_eventInfo);
 	}
 	if (product.m_validJets.size() >= 4)
 	{
-		product.m_jccsv4 = static_cast<KJet*>(product.m_validJets.at(csv4))->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata);
+		product.m_jccsv4 = m_jetTagBinding.GetTag(static_cast<KJet*>(product.m_validJets.at(csv4)), m_combinedSecondaryVertexHandle, event.m_jetMetadata, event.m_eventInfo);
 	}
-	if (product.m_svfitResults.fittedHiggsLV)
+	if (product.m_svfitResults.available)
 	{
-		double svfit_eta = product.m_svfitResults.fittedHiggsLV->Eta();
-// 		double svfit_phi = product.m_svfitResults.fittedHiggsLV->Phi();
-		double svfit_pt = product.m_svfitResults.fittedHiggsLV->Pt();
+		double svfit_eta = product.m_svfitResults.fittedHiggsLV.Eta();
+// 		double svfit_phi = product.m_svfitResults.fittedHiggsLV.Phi();
+		double svfit_pt = product.m_svfitResults.fittedHiggsLV.Pt();
 		product.m_diLepBoost = svfit_pt*TMath::CosH(svfit_eta);
 	}
 
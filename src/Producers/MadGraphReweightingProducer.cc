@@ -19,6 +19,11 @@ std::string MadGraphReweightingProducer::GetProducerId() const
 	return "MadGraphReweightingProducer";
 }
 
+std::vector<std::string> MadGraphReweightingProducer::GetOptionalInputs() const
+{
+	return { "LHEParticles" };
+}
+
 void MadGraphReweightingProducer::Init(setting_type const& settings)
 {
 	ProducerBase<HttTypes>::Init(settings);
@@ -110,7 +115,8 @@ void MadGraphReweightingProducer::Produce(event_type const& event, product_type&
                                           setting_type const& settings) const
 {
 	// TODO: should this be an assertion?
-	if (event.m_lheParticles != nullptr)
+	KLHEParticles* lheParticles = event.GetOptionalCollection(&event_type::m_lheParticles, "LHEParticles");
+	if (lheParticles != nullptr)
 	{
 		//HttEnumTypes::MadGraphProductionModeGGH productionMode = HttEnumTypes::MadGraphProductionModeGGH::NONE;
 		
@@ -163,7 +169,7 @@ void MadGraphReweightingProducer::Produce(event_type const& event, product_type&
 		//"incoming particle" "incoming particle" "higgs" "outgoing particle" "outgoing particle" "outgoing particle"
 		std::string Names [6] = {"", "", "", "", "", ""};
 		int Name_Index = 0;
-		for (std::vector<KLHEParticle>::const_iterator lheParticle = event.m_lheParticles->particles.begin(); lheParticle != event.m_lheParticles->particles.end(); ++lheParticle)
+		for (std::vector<KLHEParticle>::const_iterator lheParticle = lheParticles->particles.begin(); lheParticle != lheParticles->particles.end(); ++lheParticle)
 		{
 			ParticlesGroup* selectedParticles = nullptr;
 			//construct name of events 
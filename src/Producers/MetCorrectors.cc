@@ -17,6 +17,7 @@ MetCorrector::MetCorrector() :
 
 void MetCorrector::Init(setting_type const& settings)
 {
+	m_correctGlobalMet = !settings.GetChooseMvaMet();
 	MetCorrectorBase<KMET>::Init(settings);
 	
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("uncorrmet", [](event_type const& event, product_type const& product) {
@@ -37,8 +38,6 @@ void MetCorrector::Init(setting_type const& settings)
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("pfMetCorr", [](event_type const& event, product_type const& product) {
 		return product.m_pfmet.p4.Pt();
 	});
-
-	m_correctGlobalMet = !settings.GetChooseMvaMet();
 }
 
 std::string MetCorrector::GetProducerId() const
@@ -60,6 +59,7 @@ MvaMetCorrector::MvaMetCorrector() :
 
 void MvaMetCorrector::Init(setting_type const& settings)
 {
+	m_correctGlobalMet = settings.GetChooseMvaMet();
 	MetCorrectorBase<KMET>::Init(settings);
 	
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("mvaMetUncorr", [](event_type const& event, product_type const& product) {
@@ -97,8 +97,6 @@ void MvaMetCorrector::Init(setting_type const& settings)
 	{
 		return product.m_mvametCorrections.size() > 0 ? LambdaNtupleConsumer<HttTypes>::GetFloatQuantities()["mvaMetCorrectionVisPy"](event, product) : DefaultValues::UndefinedFloat;
 	});
-
-	m_correctGlobalMet = settings.GetChooseMvaMet();
 }
 
 std::string MvaMetCorrector::GetProducerId() const
@@ -33,7 +33,7 @@ std::string MetSelectorPuppi::GetProducerId() const
 }
 
 MvaMetTTSelector::MvaMetTTSelector() :
-	MetSelectorBase(&HttTypes::event_type::m_mvaMetTT, &HttTypes::event_type::m_mvaMetsTT)
+	MetSelectorBase(&HttTypes::event_type::m_mvaMetTT, &HttTypes::event_type::m_mvaMetsTT, "MvaMetTT", "MvaMetsTT")
 {
 }
 
@@ -44,7 +44,7 @@ std::string MvaMetTTSelector::GetProducerId() const
 
 
 MvaMetMTSelector::MvaMetMTSelector() :
-	MetSelectorBase(&HttTypes::event_type::m_mvaMetMT, &HttTypes::event_type::m_mvaMetsMT)
+	MetSelectorBase(&HttTypes::event_type::m_mvaMetMT, &HttTypes::event_type::m_mvaMetsMT, "MvaMetMT", "MvaMetsMT")
 {
 }
 
@@ -55,7 +55,7 @@ std::string MvaMetMTSelector::GetProducerId() const
 
 
 MvaMetETSelector::MvaMetETSelector() :
-	MetSelectorBase(&HttTypes::event_type::m_mvaMetET, &HttTypes::event_type::m_mvaMetsET)
+	MetSelectorBase(&HttTypes::event_type::m_mvaMetET, &HttTypes::event_type::m_mvaMetsET, "MvaMetET", "MvaMetsET")
 {
 }
 
@@ -66,7 +66,7 @@ std::string MvaMetETSelector::GetProducerId() const
 
 
 MvaMetEMSelector::MvaMetEMSelector() :
-	MetSelectorBase(&HttTypes::event_type::m_mvaMetEM, &HttTypes::event_type::m_mvaMetsEM)
+	MetSelectorBase(&HttTypes::event_type::m_mvaMetEM, &HttTypes::event_type::m_mvaMetsEM, "MvaMetEM", "MvaMetsEM")
 {
 }
 
@@ -76,7 +76,7 @@ std::string MvaMetEMSelector::GetProducerId() const
 }
 
 MvaMetSelector::MvaMetSelector() :
-	MetSelectorBase(&HttTypes::event_type::m_mvaMet, &HttTypes::event_type::m_mvaMets)
+	MetSelectorBase(&HttTypes::event_type::m_mvaMet, &HttTypes::event_type::m_mvaMets, "", "MvaMets")
 {
 }
 
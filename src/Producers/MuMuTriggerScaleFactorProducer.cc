@@ -14,8 +14,8 @@ void MuMuTriggerScaleFactorProducer::Produce( event_type const& event, product_t
     double WeightMu = 1.0;
 	for(int index = 0; index < 2; index++)
     {
-        auto args = std::vector<double>{product.m_flavourOrderedLeptons[index]->p4.Pt(),product.m_flavourOrderedLeptons[index]->p4.Eta(),SafeMap::GetWithDefault(product.m_leptonIsolationOverPt, product.m_flavourOrderedLeptons[index], std::numeric_limits<double>::max())};
-        WeightMu *= (1.0-m_functorMu->eval(args.data()));
+        m_muonTriggerFunctors.SetLeptonArguments(product.m_flavourOrderedLeptons[index], SafeMap::GetWithDefault(product.m_leptonIsolationOverPt, product.m_flavourOrderedLeptons[index], std::numeric_limits<double>::max()));
+        WeightMu *= (1.0-m_muonTriggerFunctors.Eval(0));
     }
     product.m_weights["triggerWeight"] = 1-WeightMu;
 
@@ -101,7 +101,11 @@ void PolarisationQuantitiesProducer::Produce(
 			}
 		
 			// SVfit version
-			RMFLV* fittedTauSvfit = (indexLepton == 0 ? product.m_svfitResults.fittedTau1LV : product.m_svfitResults.fittedTau2LV);
+			RMFLV const* fittedTauSvfit = nullptr;
+			if (product.m_svfitResults.available)
+			{
+				fittedTauSvfit = (indexLepton == 0 ? &(product.m_svfitResults.fittedTau1LV) : &(product.m_svfitResults.fittedTau2LV));
+			}
 			if (fittedTauSvfit != nullptr)
 			{
 				product.m_visibleOverFullEnergySvfit[*lepton] = (indexLepton == 0 ? (*lepton)->p4.E() / fittedTauSvfit->E() : product.m_svfitResults.fittedTau2ERatio);
@@ -143,28 +147,34 @@ void PolarisationQuantitiesProducer::Produce(
 			}
 			std::vector<RMFLV*> pions = { piDoubleChargeSign1, piDoubleChargeSign2, piSingleChargeSign };
 			
+			// inputs shared by both versions, converted only once
+			TLorentzVector osPion = Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>(*piSingleChargeSign);
+			TLorentzVector ssPion1 = Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>(*piDoubleChargeSign1);
+			TLorentzVector ssPion2 = Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>(*piDoubleChargeSign2);
+			TLorentzVector referenceFrame = Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>((*tau)->p4);
+			
 			// HHKinFit version
 			if (Utility::Contains(product.m_hhKinFitTaus, static_cast<KLepton*>(*tau)))
 			{
-				std::vector<TLorentzVector> a1HelperInputsHHKinFit;
-				a1HelperInputsHHKinFit.push_back(Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>(SafeMap::Get(product.m_hhKinFitTaus, static_cast<KLepton*>(*tau))));
-				a1HelperInputsHHKinFit.push_back(Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>(*piSingleChargeSign));
-				a1HelperInputsHHKinFit.push_back(Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>(*piDoubleChargeSign1));
-				a1HelperInputsHHKinFit.push_back(Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>(*piDoubleChargeSign2));
-				a1Helper a1QuantitiesHHKinFit(a1HelperInputsHHKinFit, Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>((*tau)->p4));
+				a1Helper a1QuantitiesHHKinFit(
+						Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>(SafeMap::Get(product.m_hhKinFitTaus, static_cast<KLepton*>(*tau))),
+						osPion, ssPion1, ssPion2, referenceFrame
+				);
 				product.m_a1OmegaHHKinFit[*tau] = a1QuantitiesHHKinFit.getA1omega();
 			}
 		
 			// SVfit version
-			RMFLV* fittedTauSvfit = (indexLepton == 0 ? product.m_svfitResults.fittedTau1LV : product.m_svfitResults.fittedTau2LV);
+			RMFLV const* fittedTauSvfit = nullptr;
+			if (product.m_svfitResults.available)
+			{
+				fittedTauSvfit = (indexLepton == 0 ? &(product.m_svfitResults.fittedTau1LV) : &(product.m_svfitResults.fittedTau2LV));
+			}
 			if (fittedTauSvfit != nullptr)
 			{
-				std::vector<TLorentzVector> a1HelperInputsSvfit;
-				a1HelperInputsSvfit.push_back(Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>(*fittedTauSvfit));
-				a1HelperInputsSvfit.push_back(Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>(*piSingleChargeSign));
-				a1HelperInputsSvfit.push_back(Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>(*piDoubleChargeSign1));
-				a1HelperInputsSvfit.push_back(Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>(*piDoubleChargeSign2));
-				a1Helper a1QuantitiesSvfit(a1HelperInputsSvfit, Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>((*tau)->p4));
+				a1Helper a1QuantitiesSvfit(
+						Utility::ConvertPtEtaPhiMLorentzVector<RMFLV, TLorentzVector>(*fittedTauSvfit),
+						osPion, ssPion1, ssPion2, referenceFrame
+				);
 				product.m_a1OmegaSvfit[*tau] = a1QuantitiesSvfit.getA1omega();
 			}
 		
@@ -292,15 +292,15 @@ void RecoTauCPProducer::Produce(event_type const& event, product_type& product,
 	KLepton* chargedPart1  = product.m_chargeOrderedLeptons.at(0);
 	KLepton* chargedPart2  = product.m_chargeOrderedLeptons.at(1);
 
-	// Defining CPQuantities object to use variables and functions of this class
-	CPQuantities cpq;
-
 	// quantitites needed for calculation of recoPhiStarCP
-	KTrack trackP = chargedPart1->track; // in case of tau_h, the track of the lead. prong is saved in the KTau track member
-	KTrack trackM = chargedPart2->track;
+	KTrack const& trackP = chargedPart1->track; // in case of tau_h, the track of the lead. prong is saved in the KTau track member
+	KTrack const& trackM = chargedPart2->track;
 	RMFLV momentumP = ((chargedPart1->flavour() == KLeptonFlavour::TAU) ? static_cast<KTau*>(chargedPart1)->chargedHadronCandidates.at(0).p4 : chargedPart1->p4);
 	RMFLV momentumM = ((chargedPart2->flavour() == KLeptonFlavour::TAU) ? static_cast<KTau*>(chargedPart2)->chargedHadronCandidates.at(0).p4 : chargedPart2->p4);
 
+	// the rho and the ip method share the ZMF of the two charged prongs
+	CPQuantities::ZeroMomentumFrame zmf = CPQuantities::CalculateZeroMomentumFrame(momentumP, momentumM);
+
 	// ----------
 	// rho-method
 	// ----------
@@ -308,9 +308,9 @@ void RecoTauCPProducer::Produce(event_type const& event, product_type& product,
 	RMFLV piZeroM = ((chargedPart2->flavour() == KLeptonFlavour::TAU) ? static_cast<KTau*>(chargedPart2)->piZeroMomentum() : DefaultValues::UndefinedRMFLV);
 
 
-	double phiStarCP_rho = cpq.CalculatePhiStarCP_rho(momentumP, momentumM, piZeroP, piZeroM);
-	double posyL_rho = cpq.CalculateSpinAnalysingDiscriminant_rho(momentumP, piZeroP);
-	double negyL_rho = cpq.CalculateSpinAnalysingDiscriminant_rho(momentumM, piZeroM);
+	double phiStarCP_rho = CPQuantities::CalculatePhiStarCP_rho(zmf, piZeroP, piZeroM);
+	double posyL_rho = CPQuantities::CalculateSpinAnalysingDiscriminant_rho(momentumP, piZeroP);
+	double negyL_rho = CPQuantities::CalculateSpinAnalysingDiscriminant_rho(momentumM, piZeroM);
 
 	product.m_recoPhiStarCP_rho = phiStarCP_rho;
 	product.m_reco_posyTauL = posyL_rho;
@@ -334,6 +334,6 @@ void RecoTauCPProducer::Produce(event_type const& event, product_type& product,
 	// ip-method
 	// ---------
 	// phi*CP wrt thePV
-	product.m_recoPhiStarCP = cpq.CalculatePhiStarCP(product.m_thePV, trackP, trackM, momentumP, momentumM);
+	product.m_recoPhiStarCP = CPQuantities::CalculatePhiStarCP(zmf, product.m_thePV, trackP, trackM).phiStarCP;
 
 }
@@ -46,17 +46,16 @@ void RooWorkspaceWeightProducer::Init(setting_type const& settings)
 	m_weightNames = Utility::ParseMapTypes<int,std::string>(Utility::ParseVectorToMap((settings.*GetRooWorkspaceWeightNames)()));
 
 	std::map<int,std::vector<std::string>> objectNames = Utility::ParseMapTypes<int,std::string>(Utility::ParseVectorToMap((settings.*GetRooWorkspaceObjectNames)()));
-	m_functorArgs = Utility::ParseMapTypes<int,std::string>(Utility::ParseVectorToMap((settings.*GetRooWorkspaceObjectArguments)()));
-	for(auto objectName:objectNames)
+	std::map<int,std::vector<std::string>> functorArgs = Utility::ParseMapTypes<int,std::string>(Utility::ParseVectorToMap((settings.*GetRooWorkspaceObjectArguments)()));
+	m_functorSets.clear();
+	for(auto const& objectName:objectNames)
 	{
 		for(size_t index = 0; index < objectName.second.size(); index++)
 		{
 			std::vector<std::string> objects;
 			boost::split(objects, objectName.second[index], boost::is_any_of(","));
-			for(auto object:objects)
-			{
-				m_functors[objectName.first].push_back(m_workspace->function(object.c_str())->functor(m_workspace->argSet(m_functorArgs[objectName.first][index].c_str())));
-			}
+			m_functorSets[objectName.first].emplace_back();
+			m_functorSets[objectName.first].back().Init(m_workspace, objects, functorArgs[objectName.first].at(index));
 		}
 	}
 }
@@ -65,41 +64,21 @@ void RooWorkspaceWeightProducer::Produce( event_type const& event, product_type
 	                     setting_type const& settings) const
 {
 
-	for(auto weightNames:m_weightNames)
+	for(auto const& weightNames:m_weightNames)
 	{
 		KLepton* lepton = product.m_flavourOrderedLeptons[weightNames.first];
+		double isolationOverPt = SafeMap::GetWithDefault(product.m_leptonIsolationOverPt, lepton, std::numeric_limits<double>::max());
 		for(size_t index = 0; index < weightNames.second.size(); index++)
 		{
-			auto args = std::vector<double>{};
-			std::vector<std::string> arguments;
-			boost::split(arguments,  m_functorArgs.at(weightNames.first).at(index) , boost::is_any_of(","));
-			for(auto arg:arguments)
-			{
-				if(arg=="m_pt" || arg=="e_pt")
-				{
-					args.push_back(lepton->p4.Pt());
-				}
-				if(arg=="m_eta")
-				{
-					args.push_back(lepton->p4.Eta());
-				}
-				if(arg=="e_eta")
-				{
-					KElectron* electron = static_cast<KElectron*>(lepton);
-					args.push_back(electron->superclusterPosition.Eta());
-				}
-				if(arg=="m_iso" || arg=="e_iso")
-				{
-					args.push_back(SafeMap::GetWithDefault(product.m_leptonIsolationOverPt, lepton, std::numeric_limits<double>::max()));
-				}
-			}
+			RooFunctorSet const& functorSet = m_functorSets.at(weightNames.first).at(index);
+			functorSet.SetLeptonArguments(lepton, isolationOverPt);
 			if(weightNames.second.at(index).find("triggerWeight") != std::string::npos && m_saveTriggerWeightAsOptionalOnly)
 			{
-				product.m_optionalWeights[weightNames.second.at(index)+"_"+std::to_string(weightNames.first+1)] = m_functors.at(weightNames.first).at(index)->eval(args.data());
+				product.m_optionalWeights[weightNames.second.at(index)+"_"+std::to_string(weightNames.first+1)] = functorSet.Eval(0);
 			}
 			else
 			{
-				product.m_weights[weightNames.second.at(index)+"_"+std::to_string(weightNames.first+1)] = m_functors.at(weightNames.first).at(index)->eval(args.data());
+				product.m_weights[weightNames.second.at(index)+"_"+std::to_string(weightNames.first+1)] = functorSet.Eval(0);
 			}
 		}
 	}
@@ -143,29 +122,16 @@ void EETriggerWeightProducer::Produce( event_type const& event, product_type & p
 {
 	double eTrigWeight = 1.0;
 
-	for(auto weightNames:m_weightNames)
+	for(auto const& weightNames:m_weightNames)
 	{
 		KLepton* lepton = product.m_flavourOrderedLeptons[weightNames.first];
 		for(size_t index = 0; index < weightNames.second.size(); index++)
 		{
 			if(weightNames.second.at(index).find("triggerWeight") == std::string::npos)
 				continue;
-			auto args = std::vector<double>{};
-			std::vector<std::string> arguments;
-			boost::split(arguments,  m_functorArgs.at(weightNames.first).at(index) , boost::is_any_of(","));
-			for(auto arg:arguments)
-			{
-				if(arg=="e_pt")
-				{
-					args.push_back(lepton->p4.Pt());
-				}
-				if(arg=="e_eta")
-				{
-					KElectron* electron = static_cast<KElectron*>(lepton);
-					args.push_back(electron->superclusterPosition.Eta());
-				}
-				eTrigWeight *= (1.0 - m_functors.at(weightNames.first).at(index)->eval(args.data()));
-			}
+			RooFunctorSet const& functorSet = m_functorSets.at(weightNames.first).at(index);
+			functorSet.SetLeptonArguments(lepton, SafeMap::GetWithDefault(product.m_leptonIsolationOverPt, lepton, std::numeric_limits<double>::max()));
+			eTrigWeight *= (1.0 - functorSet.Eval(0));
 		}
 	}
 	if(m_saveTriggerWeightAsOptionalOnly)
@@ -193,28 +159,16 @@ void MuMuTriggerWeightProducer::Produce( event_type const& event, product_type &
 {
 	double muTrigWeight = 1.0;
 
-	for(auto weightNames:m_weightNames)
+	for(auto const& weightNames:m_weightNames)
 	{
 		KLepton* lepton = product.m_flavourOrderedLeptons[weightNames.first];
 		for(size_t index = 0; index < weightNames.second.size(); index++)
 		{
 			if(weightNames.second.at(index).find("triggerWeight") == std::string::npos)
 				continue;
-			auto args = std::vector<double>{};
-			std::vector<std::string> arguments;
-			boost::split(arguments,  m_functorArgs.at(weightNames.first).at(index) , boost::is_any_of(","));
-			for(auto arg:arguments)
-			{
-				if(arg=="m_pt")
-				{
-					args.push_back(lepton->p4.Pt());
-				}
-				if(arg=="m_eta")
-				{
-					args.push_back(lepton->p4.Eta());
-				}
-			}
-			muTrigWeight *= (1.0 - m_functors.at(weightNames.first).at(index)->eval(args.data()));
+			RooFunctorSet const& functorSet = m_functorSets.at(weightNames.first).at(index);
+			functorSet.SetLeptonArguments(lepton, SafeMap::GetWithDefault(product.m_leptonIsolationOverPt, lepton, std::numeric_limits<double>::max()));
+			muTrigWeight *= (1.0 - functorSet.Eval(0));
 		}
 	}
 	if(m_saveTriggerWeightAsOptionalOnly)
@@ -242,7 +196,7 @@ void TauTauTriggerWeightProducer::Produce( event_type const& event, product_type
 {
 	double tauTrigWeight = 1.0;
 
-	for(auto weightNames:m_weightNames)
+	for(auto const& weightNames:m_weightNames)
 	{
 		KLepton* lepton = product.m_flavourOrderedLeptons[weightNames.first];
 		KLepton* originalLepton = const_cast<KLepton*>(SafeMap::GetWithDefault(product.m_originalLeptons, const_cast<const KLepton*>(lepton), const_cast<const KLepton*>(lepton)));
@@ -263,37 +217,20 @@ void TauTauTriggerWeightProducer::Produce( event_type const& event, product_type
 		{
 			if(weightNames.second.at(index).find("triggerWeight") == std::string::npos)
 				continue;
-			if(m_functors.at(weightNames.first).size() != 2)
+			RooFunctorSet const& functorSet = m_functorSets.at(weightNames.first).at(index);
+			if(functorSet.GetNFunctions() != 2)
 			{
 				LOG(WARNING) << "TauTauTriggerWeightProducer: two object names are required in json config file. Trigger weight will be set to 1.0!";
 				break;
 			}
-			auto args = std::vector<double>{};
-			std::vector<std::string> arguments;
-			boost::split(arguments,  m_functorArgs.at(weightNames.first).at(index) , boost::is_any_of(","));
-			for(auto arg:arguments)
-			{
-				if(arg=="t_pt")
-				{
-					args.push_back(lepton->p4.Pt());
-				}
-				if(arg=="t_eta")
-				{
-					args.push_back(lepton->p4.Eta());
-				}
-				if(arg=="t_dm")
-				{
-					KTau* tau = static_cast<KTau*>(lepton);
-					args.push_back(tau->decayMode);
-				}
-			}
+			functorSet.SetLeptonArguments(lepton, SafeMap::GetWithDefault(product.m_leptonIsolationOverPt, lepton, std::numeric_limits<double>::max()));
 			if(genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_TAU_HAD_DECAY)
 			{
-				tauTrigWeight = m_functors.at(weightNames.first).at(index)->eval(args.data());
+				tauTrigWeight = functorSet.Eval(0);
 			}
 			else
 			{
-				tauTrigWeight = m_functors.at(weightNames.first).at(index+1)->eval(args.data());
+				tauTrigWeight = functorSet.Eval(1);
 			}
 			if(m_saveTriggerWeightAsOptionalOnly)
 			{
@@ -322,7 +259,7 @@ void MuTauTriggerWeightProducer::Produce( event_type const& event, product_type
 {
 	double muTrigWeight(1.0), tauTrigWeight(1.0);
 
-	for(auto weightNames:m_weightNames)
+	for(auto const& weightNames:m_weightNames)
 	{
 		// muon-tau cross trigger scale factors currently depend only on tau pt and eta
 		KLepton* lepton = product.m_flavourOrderedLeptons[weightNames.first];
@@ -344,7 +281,8 @@ void MuTauTriggerWeightProducer::Produce( event_type const& event, product_type
 		{
 			if(weightNames.second.at(index).find("triggerWeight") == std::string::npos)
 				continue;
-			if(lepton->flavour() == KLeptonFlavour::TAU && m_functors.at(weightNames.first).size() != 2)
+			RooFunctorSet const& functorSet = m_functorSets.at(weightNames.first).at(index);
+			if(lepton->flavour() == KLeptonFlavour::TAU && functorSet.GetNFunctions() != 2)
 			{
 				LOG(WARNING) << "MuTauTriggerWeightProducer: two object names are required for tau leg in json config file. Trigger weight for this leg will be set to 1.0!";
 				if(m_saveTriggerWeightAsOptionalOnly)
@@ -356,29 +294,16 @@ void MuTauTriggerWeightProducer::Produce( event_type const& event, product_type
 				}
 				break;
 			}
-			auto args = std::vector<double>{};
-			std::vector<std::string> arguments;
-			boost::split(arguments,  m_functorArgs.at(weightNames.first).at(index) , boost::is_any_of(","));
-			for(auto arg:arguments)
-			{
-				if(arg=="m_pt" || arg=="t_pt")
-				{
-					args.push_back(lepton->p4.Pt());
-				}
-				if(arg=="m_eta" || arg=="t_eta")
-				{
-					args.push_back(lepton->p4.Eta());
-				}
-			}
+			functorSet.SetLeptonArguments(lepton, SafeMap::GetWithDefault(product.m_leptonIsolationOverPt, lepton, std::numeric_limits<double>::max()));
 			if(lepton->flavour() == KLeptonFlavour::TAU)
 			{
 				if(genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_TAU_HAD_DECAY)
 				{
-					tauTrigWeight = m_functors.at(weightNames.first).at(index)->eval(args.data());
+					tauTrigWeight = functorSet.Eval(0);
 				}
 				else
 				{
-					tauTrigWeight = m_functors.at(weightNames.first).at(index+1)->eval(args.data());
+					tauTrigWeight = functorSet.Eval(1);
 				}
 				if(m_saveTriggerWeightAsOptionalOnly)
 				{
@@ -390,7 +315,7 @@ void MuTauTriggerWeightProducer::Produce( event_type const& event, product_type
 			}
 			else
 			{
-				muTrigWeight = m_functors.at(weightNames.first).at(index)->eval(args.data());
+				muTrigWeight = functorSet.Eval(0);
 				if(m_saveTriggerWeightAsOptionalOnly)
 				{
 					product.m_optionalWeights[weightNames.second.at(index)+"_"+std::to_string(weightNames.first+1)] = muTrigWeight;
@@ -1,5 +1,6 @@
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/ScaleVariationProducer.h"
+#include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/SafeMap.h"
 #include "Artus/Utility/interface/Utility.h"
 
@@ -14,12 +15,21 @@ void ScaleVariationProducer::Init(setting_type const& settings)
 	ProducerBase<HttTypes>::Init(settings);
 	
 	genEventInfoMetadataMap = Utility::ParseVectorToMap(settings.GetGenEventInfoMetadataNames());
+	m_lheWeightsAsArray = settings.GetLheWeightsAsArray();
+	
+	LambdaNtupleConsumer<HttTypes>::AddVFloatQuantity("lheWeights", [](event_type const& event, product_type const& product)
+	{
+		return std::vector<float>(event.m_genEventInfo->lheWeight.begin(), event.m_genEventInfo->lheWeight.end());
+	});
 }
 
 void ScaleVariationProducer::OnLumi(event_type const& event, setting_type const& settings)
 {
-	weightNames.clear();
-	for (std::string lheWeightName : event.m_genEventInfoMetadata->lheWeightNames)
+	std::vector<std::string> previousWeightNames;
+	previousWeightNames.swap(weightNames);
+	
+	// weights not configured in GenEventInfoMetadataNames keep their name in the input
+	for (std::string const& lheWeightName : event.m_genEventInfoMetadata->lheWeightNames)
 	{
 		if (Utility::Contains(genEventInfoMetadataMap, lheWeightName))
 		{
@@ -29,18 +39,26 @@ void ScaleVariationProducer::OnLumi(event_type const& event, setting_type const&
 		else
 		{
 			weightNames.push_back(lheWeightName);
-			LOG(WARNING) << "LHE weight " << lheWeightName << " not found. It will be ommitted.";
+			LOG(DEBUG) << "LHE weight " << lheWeightName << " not found in GenEventInfoMetadataNames, its name in the input is used.";
 		}
 	}
+	
+	if (m_lheWeightsAsArray && (! previousWeightNames.empty()) && (previousWeightNames != weightNames))
+	{
+		LOG(WARNING) << "The LHE weights changed between lumi sections. The entries of the lheWeights arrays do not correspond to the same names for all events.";
+	}
 }
 
 void ScaleVariationProducer::Produce(event_type const& event, product_type & product, 
 	                 setting_type const& settings) const
 {
-	size_t index = 0;
-	for(std::string weightName : weightNames)
+	product.m_lheWeightNames = &weightNames;
+	
+	if (! m_lheWeightsAsArray)
 	{
-		product.m_optionalWeights[weightName] = event.m_genEventInfo->lheWeight[index];
-		++index;
+		for (size_t index = 0; index < weightNames.size(); ++index)
+		{
+			product.m_optionalWeights[weightNames[index]] = event.m_genEventInfo->lheWeight[index];
+		}
 	}
 }
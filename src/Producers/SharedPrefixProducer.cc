@@ -0,0 +1,337 @@
+
+#include <map>
+#include <set>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/SharedPrefixProducer.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttFactory.h"
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/HttVariedSettings.h"
+
+
+namespace
+{
+	// unambiguous representation of a settings value for the comparison between pipelines
+	void AppendSettingsValue(boost::property_tree::ptree const& tree, std::string& value)
+	{
+		value += std::to_string(tree.data().size()) + ":" + tree.data() + "{";
+		for (boost::property_tree::ptree::const_iterator child = tree.begin(); child != tree.end(); ++child)
+		{
+			value += std::to_string(child->first.size()) + ":" + child->first + "=";
+			AppendSettingsValue(child->second, value);
+		}
+		value += "}";
+	}
+
+	template<class TObject>
+	void AppendMomenta(std::vector<std::shared_ptr<TObject> > const& objects, std::vector<RMFLV>& momenta)
+	{
+		for (typename std::vector<std::shared_ptr<TObject> >::const_iterator object = objects.begin(); object != objects.end(); ++object)
+		{
+			momenta.push_back((*object)->p4);
+		}
+	}
+}
+
+
+/**
+   Processor shared by all pipelines with the same identification of it, together with the product kept
+   after it for the pipelines continuing with different processors.
+*/
+class SharedPrefixProducer::SharedProcessor
+{
+public:
+	std::string name;
+	std::unique_ptr<ProducerBaseUntemplated> producer;
+	std::unique_ptr<FilterBaseUntemplated> filter;
+
+	// processors following this one by their identification
+	std::map<std::string, std::shared_ptr<SharedProcessor> > next;
+	unsigned int nPipelines = 0;
+
+	bool lumiFilled = false;
+	unsigned int lastRun = 0;
+	unsigned int lastLumi = 0;
+
+	bool IsKept(KEventInfo const* eventInfo) const;
+	void Keep(KEventInfo const* eventInfo, product_type const& product);
+	void Restore(product_type& product, setting_type const& settings) const;
+
+private:
+	static void GetCorrectedMomenta(product_type const& product, std::vector<RMFLV>& momenta);
+
+	bool m_kept = false;
+	unsigned int m_run = 0;
+	unsigned int m_lumi = 0;
+	unsigned long long m_event = 0;
+	std::unique_ptr<product_type> m_product;
+	std::vector<RMFLV> m_correctedMomenta;
+};
+
+
+bool SharedPrefixProducer::SharedProcessor::IsKept(KEventInfo const* eventInfo) const
+{
+	return (m_kept && (m_run == eventInfo->nRun) && (m_lumi == eventInfo->nLumi) && (m_event == eventInfo->nEvent));
+}
+
+void SharedPrefixProducer::SharedProcessor::Keep(KEventInfo const* eventInfo, product_type const& product)
+{
+	m_kept = true;
+	m_run = eventInfo->nRun;
+	m_lumi = eventInfo->nLumi;
+	m_event = eventInfo->nEvent;
+	if (! m_product)
+	{
+		m_product.reset(new product_type(product));
+	}
+	else
+	{
+		*m_product = product;
+	}
+	GetCorrectedMomenta(*m_product, m_correctedMomenta);
+}
+
+void SharedPrefixProducer::SharedProcessor::Restore(product_type& product, setting_type const& settings) const
+{
+	// the corrected objects are referenced by the kept product and have to be left unchanged by the pipelines that already continued
+	product_type const& keptProduct = *m_product;
+	std::vector<RMFLV> correctedMomenta;
+	GetCorrectedMomenta(keptProduct, correctedMomenta);
+	if (correctedMomenta != m_correctedMomenta)
+	{
+		LOG(FATAL) << "Objects created by the processors shared up to \"" << name << "\" have been modified by a processor following them, "
+		           << "before pipeline \"" << settings.GetName() << "\" continues from them! Processors have to modify copies of these objects.";
+	}
+	product = keptProduct;
+}
+
+void SharedPrefixProducer::SharedProcessor::GetCorrectedMomenta(product_type const& product, std::vector<RMFLV>& momenta)
+{
+	momenta.clear();
+	AppendMomenta(product.m_correctedElectrons, momenta);
+	AppendMomenta(product.m_correctedMuons, momenta);
+	AppendMomenta(product.m_correctedTaus, momenta);
+	AppendMomenta(product.m_correctedTaggedJets, momenta);
+}
+
+
+SharedPrefixProducer::SharedPrefixProducer(HttFactory* factory) :
+	ProducerBase<HttTypes>(),
+	m_factory(factory)
+{
+}
+
+void SharedPrefixProducer::Init(setting_type const& settings)
+{
+	ProducerBase<HttTypes>::Init(settings);
+
+	if (! m_factory)
+	{
+		LOG(FATAL) << "SharedPrefixProducer needs to be created by the HttFactory of the pipelines!";
+	}
+
+	boost::property_tree::ptree const& pipelineSettings = settings.GetPropTree()->get_child("Pipelines").get_child(
+			boost::property_tree::ptree::path_type(settings.GetName(), '\0'));
+
+	// the processors are created by the factory of the pipelines, such that their inputs are known to it
+	std::vector<std::shared_ptr<SharedProcessor> > processors;
+	std::vector<std::vector<std::string> > processorSettings;
+	std::vector<bool> pipelineSpecific;
+	std::set<std::string> variedSettings;
+	for (std::vector<std::string>::const_iterator processorName = settings.GetSharedPrefixProcessors().begin();
+	     processorName != settings.GetSharedPrefixProcessors().end(); ++processorName)
+	{
+		std::vector<std::string> splitProcessorName;
+		boost::algorithm::split(splitProcessorName, *processorName, boost::algorithm::is_any_of(":"));
+		if (splitProcessorName.size() != 2)
+		{
+			LOG(FATAL) << "Processor \"" << *processorName << "\" in SharedPrefixProcessors does not follow the format \"producer:<id>\" or \"filter:<id>\"!";
+		}
+		std::string processorType = boost::algorithm::trim_copy(splitProcessorName[0]);
+		std::string processorId = boost::algorithm::trim_copy(splitProcessorName[1]);
+
+		std::shared_ptr<SharedProcessor> processor = std::make_shared<SharedProcessor>();
+		processor->name = processorType + ":" + processorId;
+		HttVariedSettings::Reader const* reader = nullptr;
+		if (processorType == "producer")
+		{
+			processor->producer.reset(m_factory->createProducer(processorId));
+			if (! processor->producer)
+			{
+				LOG(FATAL) << "Producer \"" << processorId << "\" in SharedPrefixProcessors not found!";
+			}
+			reader = dynamic_cast<HttVariedSettings::Reader const*>(processor->producer.get());
+		}
+		else if (processorType == "filter")
+		{
+			processor->filter.reset(m_factory->createFilter(processorId));
+			if (! processor->filter)
+			{
+				LOG(FATAL) << "Filter \"" << processorId << "\" in SharedPrefixProcessors not found!";
+			}
+			reader = dynamic_cast<HttVariedSettings::Reader const*>(processor->filter.get());
+		}
+		else
+		{
+			LOG(FATAL) << "Unknown processor type \"" << processorType << "\" in SharedPrefixProcessors!";
+		}
+
+		// processors of other packages without declaration depend on unknown settings and are not shared
+		std::vector<std::string> declaredSettings;
+		std::vector<std::string> const* externalSettings = HttVariedSettings::GetExternalProcessorSettings(processor->name);
+		bool undeclared = false;
+		if (reader)
+		{
+			declaredSettings = reader->GetVariedSettings();
+		}
+		else if (externalSettings)
+		{
+			declaredSettings = *externalSettings;
+		}
+		else if (m_factory->IsExternalProcessor(processor->name))
+		{
+			LOG(WARNING) << "No varied settings declared for the processor " << processor->name
+			             << " in pipeline \"" << settings.GetName() << "\". It is not shared with other pipelines.";
+			undeclared = true;
+		}
+		variedSettings.insert(declaredSettings.begin(), declaredSettings.end());
+		processors.push_back(processor);
+		processorSettings.push_back(declaredSettings);
+		pipelineSpecific.push_back(undeclared);
+	}
+
+	// all settings of this pipeline that are not declared by its processors identify the first processor
+	boost::property_tree::ptree commonPipelineSettings = pipelineSettings;
+	for (std::set<std::string>::const_iterator variedSetting = variedSettings.begin(); variedSetting != variedSettings.end(); ++variedSetting)
+	{
+		commonPipelineSettings.erase(*variedSetting);
+	}
+	commonPipelineSettings.erase("Processors");
+	commonPipelineSettings.erase("SharedPrefixProcessors");
+	std::string commonSettings;
+	AppendSettingsValue(commonPipelineSettings, commonSettings);
+
+	std::shared_ptr<SharedProcessor>& root = m_factory->GetSharedPrefixes()[commonSettings];
+	if (! root)
+	{
+		root = std::make_shared<SharedProcessor>();
+	}
+
+	std::shared_ptr<SharedProcessor> previousProcessor = root;
+	for (size_t processorIndex = 0; processorIndex < processors.size(); ++processorIndex)
+	{
+		std::string identification = processors[processorIndex]->name;
+		if (pipelineSpecific[processorIndex])
+		{
+			identification += ("|pipeline=" + settings.GetName());
+		}
+		for (std::vector<std::string>::const_iterator declaredSetting = processorSettings[processorIndex].begin();
+		     declaredSetting != processorSettings[processorIndex].end(); ++declaredSetting)
+		{
+			identification += ("|" + *declaredSetting + "=");
+			boost::optional<boost::property_tree::ptree const&> value = pipelineSettings.get_child_optional(
+					boost::property_tree::ptree::path_type(*declaredSetting, '\0'));
+			if (value)
+			{
+				AppendSettingsValue(*value, identification);
+			}
+		}
+
+		std::shared_ptr<SharedProcessor>& sharedProcessor = previousProcessor->next[identification];
+		if (! sharedProcessor)
+		{
+			sharedProcessor = processors[processorIndex];
+			if (sharedProcessor->producer)
+			{
+				sharedProcessor->producer->baseInit(settings);
+			}
+			else
+			{
+				sharedProcessor->filter->baseInit(settings);
+			}
+			LOG(DEBUG) << "\tShared processor " << sharedProcessor->name << " created by pipeline \"" << settings.GetName() << "\".";
+		}
+		else
+		{
+			LOG(DEBUG) << "\tShared processor " << sharedProcessor->name << " reused by pipeline \"" << settings.GetName() << "\".";
+		}
+		++(sharedProcessor->nPipelines);
+		m_processors.push_back(sharedProcessor);
+		previousProcessor = sharedProcessor;
+	}
+}
+
+void SharedPrefixProducer::OnLumi(event_type const& event, setting_type const& settings)
+{
+	assert(event.m_lumiInfo);
+
+	// the processors are shared, they are notified only by the first pipeline reaching a new lumi section
+	for (std::vector<std::shared_ptr<SharedProcessor> >::iterator processor = m_processors.begin();
+	     processor != m_processors.end(); ++processor)
+	{
+		if ((*processor)->lumiFilled &&
+		    ((*processor)->lastRun == event.m_lumiInfo->nRun) &&
+		    ((*processor)->lastLumi == event.m_lumiInfo->nLumi))
+		{
+			continue;
+		}
+		(*processor)->lumiFilled = true;
+		(*processor)->lastRun = event.m_lumiInfo->nRun;
+		(*processor)->lastLumi = event.m_lumiInfo->nLumi;
+
+		if ((*processor)->producer)
+		{
+			(*processor)->producer->baseOnLumi(event, settings);
+		}
+		else
+		{
+			(*processor)->filter->baseOnLumi(event, settings);
+		}
+	}
+}
+
+void SharedPrefixProducer::Produce(event_type const& event, product_type& product,
+                                   setting_type const& settings) const
+{
+	assert(event.m_eventInfo);
+
+	// continue after the last processor that has already been run for this event by another pipeline
+	size_t firstProcessor = 0;
+	for (size_t processorIndex = m_processors.size(); processorIndex > 0; --processorIndex)
+	{
+		if (m_processors[processorIndex-1]->IsKept(event.m_eventInfo))
+		{
+			m_processors[processorIndex-1]->Restore(product, settings);
+			firstProcessor = processorIndex;
+			break;
+		}
+	}
+	if (firstProcessor == 0)
+	{
+		product.m_sharedPrefixFilterDecisions.clear();
+	}
+
+	bool passed = (product.m_sharedPrefixFilterDecisions.empty() || product.m_sharedPrefixFilterDecisions.back().second);
+	for (size_t processorIndex = firstProcessor; passed && (processorIndex < m_processors.size()); ++processorIndex)
+	{
+		SharedProcessor& processor = *(m_processors[processorIndex]);
+		if (processor.producer)
+		{
+			processor.producer->baseProduce(event, product, settings);
+		}
+		else
+		{
+			passed = processor.filter->baseDoesEventPass(event, product, settings);
+			product.m_sharedPrefixFilterDecisions.push_back(std::make_pair(processor.filter->GetFilterId(), passed));
+		}
+
+		// the product is kept where pipelines sharing this processor continue differently or stop
+		unsigned int nContinuingPipelines = ((passed && (processorIndex + 1 < m_processors.size())) ? m_processors[processorIndex+1]->nPipelines : 1);
+		if (processor.nPipelines > nContinuingPipelines)
+		{
+			processor.Keep(event.m_eventInfo, product);
+		}
+	}
+}
@@ -1,6 +1,7 @@
+#include <limits>
+
 
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Producers/SimpleEleTauFakeRateWeightProducer.h"
-#include "Artus/KappaAnalysis/interface/Utility/GeneratorInfo.h"
 
 SimpleEleTauFakeRateWeightProducer::SimpleEleTauFakeRateWeightProducer(
 		std::vector<float>& (setting_type::*GetSimpleEleTauFakeRateWeightVLoose)(void) const,
@@ -17,120 +18,32 @@ SimpleEleTauFakeRateWeightProducer::SimpleEleTauFakeRateWeightProducer():
 {
 }
 
-void SimpleEleTauFakeRateWeightProducer::Init(setting_type const& settings)
-{
-	ProducerBase<HttTypes>::Init(settings);
-
-	SimpleEleTauFakeRateWeightVLoose = (settings.*GetSimpleEleTauFakeRateWeightVLoose)();
-	SimpleEleTauFakeRateWeightTight = (settings.*GetSimpleEleTauFakeRateWeightTight)();
-}
-
 std::string SimpleEleTauFakeRateWeightProducer::GetProducerId() const
 {
 	return "SimpleEleTauFakeRateWeightProducer";
 }
 
-void SimpleEleTauFakeRateWeightProducer::Produce(event_type const& event, product_type& product,
-                                                 setting_type const& settings) const
+void SimpleEleTauFakeRateWeightProducer::AddTables(setting_type const& settings)
 {
 	// 04.11.2016: numbers taken from https://indico.cern.ch/event/563239/contributions/2279020/attachments/1325496/1989607/lepTauFR_tauIDmeeting_20160822.pdf
 	//             as recommended in https://twiki.cern.ch/twiki/bin/viewauth/CMS/SMTauTau2016#e_tau_fake_rate
-	
-	float eTauFakeRateWeight = 1.0;
-
-	assert(SimpleEleTauFakeRateWeightVLoose.size() == 2);
-	assert(SimpleEleTauFakeRateWeightTight.size() == 2);
 
-	if (product.m_decayChannel == HttEnumTypes::DecayChannel::ET)
+	std::vector<float> const& simpleEleTauFakeRateWeightVLoose = (settings.*GetSimpleEleTauFakeRateWeightVLoose)();
+	std::vector<float> const& simpleEleTauFakeRateWeightTight = (settings.*GetSimpleEleTauFakeRateWeightTight)();
+	if ((simpleEleTauFakeRateWeightVLoose.size() != 2) || (simpleEleTauFakeRateWeightTight.size() != 2))
 	{
-		KappaEnumTypes::GenMatchingCode genMatchingCode = KappaEnumTypes::GenMatchingCode::NONE;
-		KLepton* lepton = product.m_flavourOrderedLeptons[1];
-		KLepton* originalLepton = const_cast<KLepton*>(SafeMap::GetWithDefault(product.m_originalLeptons, const_cast<const KLepton*>(lepton), const_cast<const KLepton*>(lepton)));
-		if (settings.GetUseUWGenMatching())
-		{
-			genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, originalLepton);
-		}
-		else
-		{
-			KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(originalLepton, product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
-			if (genParticle)
-				genMatchingCode = GeneratorInfo::GetGenMatchingCode(genParticle);
-			else
-				genMatchingCode = KappaEnumTypes::GenMatchingCode::IS_FAKE;
-		}
-		if ((genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_ELE_PROMPT) || (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_ELE_FROM_TAU))
-		{
-			if(std::abs(lepton->p4.Eta()) < 1.460)
-			{
-				eTauFakeRateWeight = SimpleEleTauFakeRateWeightTight.at(0);
-			}
-			else if(std::abs(lepton->p4.Eta()) > 1.558)
-			{
-				eTauFakeRateWeight = SimpleEleTauFakeRateWeightTight.at(1);
-			}
-		}
+		LOG(FATAL) << "SimpleEleTauFakeRateWeightProducer needs two weights (barrel, endcap) per working point!";
 	}
-	else if (product.m_decayChannel == HttEnumTypes::DecayChannel::MT)
-	{
-		KappaEnumTypes::GenMatchingCode genMatchingCode = KappaEnumTypes::GenMatchingCode::NONE;
-		KLepton* lepton = product.m_flavourOrderedLeptons[1];
-		KLepton* originalLepton = const_cast<KLepton*>(SafeMap::GetWithDefault(product.m_originalLeptons, const_cast<const KLepton*>(lepton), const_cast<const KLepton*>(lepton)));
-		if (settings.GetUseUWGenMatching())
-		{
-			genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, originalLepton);
-		}
-		else
-		{
-			KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(originalLepton, product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
-			if (genParticle)
-				genMatchingCode = GeneratorInfo::GetGenMatchingCode(genParticle);
-			else
-				genMatchingCode = KappaEnumTypes::GenMatchingCode::IS_FAKE;
-		}
-		if ((genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_ELE_PROMPT) || (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_ELE_FROM_TAU))
-		{
-			if(std::abs(lepton->p4.Eta()) < 1.460)
-			{
-				eTauFakeRateWeight = SimpleEleTauFakeRateWeightVLoose.at(0);
-			}
-			else if(std::abs(lepton->p4.Eta()) > 1.558)
-			{
-				eTauFakeRateWeight = SimpleEleTauFakeRateWeightVLoose.at(1);
-			}
-		}
-	}
-	else if (product.m_decayChannel == HttEnumTypes::DecayChannel::TT)
-	{
-		for (int index = 0; index < 2; index++)
-		{
-			KappaEnumTypes::GenMatchingCode genMatchingCode = KappaEnumTypes::GenMatchingCode::NONE;
-			KLepton* lepton = product.m_flavourOrderedLeptons[index];
-			KLepton* originalLepton = const_cast<KLepton*>(SafeMap::GetWithDefault(product.m_originalLeptons, const_cast<const KLepton*>(lepton), const_cast<const KLepton*>(lepton)));
-			if (settings.GetUseUWGenMatching())
-			{
-				genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, originalLepton);
-			}
-			else
-			{
-				KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(originalLepton, product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
-				if (genParticle)
-					genMatchingCode = GeneratorInfo::GetGenMatchingCode(genParticle);
-				else
-					genMatchingCode = KappaEnumTypes::GenMatchingCode::IS_FAKE;
-			}
-			if ((genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_ELE_PROMPT) || (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_ELE_FROM_TAU))
-			{
-				if(std::abs(lepton->p4.Eta()) < 1.460)
-				{
-					eTauFakeRateWeight *= SimpleEleTauFakeRateWeightVLoose.at(0);
-				}
-				else if(std::abs(lepton->p4.Eta()) > 1.558)
-				{
-					eTauFakeRateWeight *= SimpleEleTauFakeRateWeightVLoose.at(1);
-				}
-			}
-		}
-	}
-	product.m_weights["eleTauFakeRateWeight"] = eTauFakeRateWeight;
-	
+
+	// barrel and endcap, no correction in the transition region
+	Binning absEtaBinning;
+	absEtaBinning.variable = BinningVariable::ABS_ETA;
+	absEtaBinning.edges = {0.0, 1.460, 1.558, std::numeric_limits<float>::max()};
+	std::vector<float> vLooseWeights = {simpleEleTauFakeRateWeightVLoose.at(0), 1.0, simpleEleTauFakeRateWeightVLoose.at(1)};
+	std::vector<float> tightWeights = {simpleEleTauFakeRateWeightTight.at(0), 1.0, simpleEleTauFakeRateWeightTight.at(1)};
+
+	AddTable("eleTauFakeRateWeight", HttEnumTypes::DecayChannel::ET, 2, GenMatchClass::ELECTRON, {absEtaBinning}, tightWeights);
+	AddTable("eleTauFakeRateWeight", HttEnumTypes::DecayChannel::MT, 2, GenMatchClass::ELECTRON, {absEtaBinning}, vLooseWeights);
+	AddTable("eleTauFakeRateWeight", HttEnumTypes::DecayChannel::TT, 1, GenMatchClass::ELECTRON, {absEtaBinning}, vLooseWeights);
+	AddTable("eleTauFakeRateWeight", HttEnumTypes::DecayChannel::TT, 2, GenMatchClass::ELECTRON, {absEtaBinning}, vLooseWeights);
 }
@@ -1,4 +1,6 @@
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/filesystem/convenience.hpp>
@@ -32,26 +34,31 @@ void SvfitProducer::Init(setting_type const& settings)
 		);
 	}
 	
+	svfitTools.SetInJobCacheSize(static_cast<size_t>(std::max(0, settings.GetSvfitInJobCacheSize())));
+	
 	svfitCacheMissBehaviour = HttEnumTypes::ToSvfitCacheMissBehaviour(settings.GetSvfitCacheMissBehaviour());
 	// add possible quantities for the lambda ntuples consumers
 	LambdaNtupleConsumer<HttTypes>::AddBoolQuantity("svfitAvailable", [](event_type const& event, product_type const& product) {
-		return (product.m_svfitResults.fittedHiggsLV ? true : false);
+		return product.m_svfitResults.available;
+	});
+	LambdaNtupleConsumer<HttTypes>::AddBoolQuantity("svfitFastEstimate", [](event_type const& event, product_type const& product) {
+		return product.m_svfitResults.fastEstimate;
 	});
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("svfitPt", [](event_type const& event, product_type const& product) {
-		return (product.m_svfitResults.fittedHiggsLV ? product.m_svfitResults.fittedHiggsLV->Pt() : DefaultValues::UndefinedFloat);
+		return (product.m_svfitResults.available ? product.m_svfitResults.fittedHiggsLV.Pt() : DefaultValues::UndefinedFloat);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("svfitEta", [](event_type const& event, product_type const& product) {
-		return (product.m_svfitResults.fittedHiggsLV ? product.m_svfitResults.fittedHiggsLV->Eta() : DefaultValues::UndefinedFloat);
+		return (product.m_svfitResults.available ? product.m_svfitResults.fittedHiggsLV.Eta() : DefaultValues::UndefinedFloat);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("svfitPhi", [](event_type const& event, product_type const& product) {
-		return (product.m_svfitResults.fittedHiggsLV ? product.m_svfitResults.fittedHiggsLV->Phi() : DefaultValues::UndefinedFloat);
+		return (product.m_svfitResults.available ? product.m_svfitResults.fittedHiggsLV.Phi() : DefaultValues::UndefinedFloat);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("svfitMass", [](event_type const& event, product_type const& product) {
-		return (product.m_svfitResults.fittedHiggsLV ? product.m_svfitResults.fittedHiggsLV->mass() : DefaultValues::UndefinedFloat);
+		return (product.m_svfitResults.available ? product.m_svfitResults.fittedHiggsLV.mass() : DefaultValues::UndefinedFloat);
 	});
 
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("svfitLV", [](event_type const& event, product_type const& product) {
-		return (product.m_svfitResults.fittedHiggsLV ? *(product.m_svfitResults.fittedHiggsLV) : DefaultValues::UndefinedRMFLV);
+		return (product.m_svfitResults.available ? product.m_svfitResults.fittedHiggsLV : DefaultValues::UndefinedRMFLV);
 	});
 	
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("svfitTransverseMass", [](event_type const& event, product_type const& product) {
@@ -59,20 +66,20 @@ void SvfitProducer::Init(setting_type const& settings)
 	});
 	
 	LambdaNtupleConsumer<HttTypes>::AddBoolQuantity("svfitTau1Available", [](event_type const& event, product_type const& product) {
-		return (product.m_svfitResults.fittedTau1LV ? true : false);
+		return product.m_svfitResults.available;
 	});
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("svfitTau1LV", [](event_type const& event, product_type const& product) {
-		return (product.m_svfitResults.fittedTau1LV ? *(product.m_svfitResults.fittedTau1LV) : DefaultValues::UndefinedRMFLV);
+		return (product.m_svfitResults.available ? product.m_svfitResults.fittedTau1LV : DefaultValues::UndefinedRMFLV);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("svfitTau1ERatio", [](event_type const& event, product_type const& product) {
 		return product.m_svfitResults.fittedTau1ERatio;
 	});
 	
 	LambdaNtupleConsumer<HttTypes>::AddBoolQuantity("svfitTau2Available", [](event_type const& event, product_type const& product) {
-		return (product.m_svfitResults.fittedTau2LV ? true : false);
+		return product.m_svfitResults.available;
 	});
 	LambdaNtupleConsumer<HttTypes>::AddRMFLVQuantity("svfitTau2LV", [](event_type const& event, product_type const& product) {
-		return (product.m_svfitResults.fittedTau2LV ? *(product.m_svfitResults.fittedTau2LV) : DefaultValues::UndefinedRMFLV);
+		return (product.m_svfitResults.available ? product.m_svfitResults.fittedTau2LV : DefaultValues::UndefinedRMFLV);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("svfitTau2ERatio", [](event_type const& event, product_type const& product) {
 		return product.m_svfitResults.fittedTau2ERatio;
@@ -176,9 +183,9 @@ void SvfitProducer::Produce(event_type const& event, product_type& product,
 		);
 		
 		// apply systematic shifts
-		if(product.m_svfitResults.fittedHiggsLV)
+		if(product.m_svfitResults.available)
 		{
-			product.m_svfitResults.fittedHiggsLV->SetM(product.m_svfitResults.fittedHiggsLV->M() * settings.GetSvfitMassShift());
+			product.m_svfitResults.fittedHiggsLV.SetM(product.m_svfitResults.fittedHiggsLV.M() * settings.GetSvfitMassShift());
 		}
 	}
 	
@@ -6,6 +6,8 @@ void TTHTauPairProducer::Init(setting_type const& settings)
 {
 	ProducerBase<HttTypes>::Init(settings);
 	
+	m_isolationDiscriminatorHandle = m_tauDiscriminatorBinding.Register("hpsPFTauDiscriminationByIsolationMVA2raw");
+	
 	// add possible quantities for the lambda ntuples consumers
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("TTHTau1Pt", [this](HttTypes::event_type const& event, HttTypes::product_type const& product) {
 		return product.m_validTTHTaus[0]->p4.Pt();
@@ -20,10 +22,10 @@ void TTHTauPairProducer::Init(setting_type const& settings)
 		return product.m_validTTHTaus[1]->p4.Eta();
 	});
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("TTHTau1Iso", [this](HttTypes::event_type const& event, HttTypes::product_type const& product) {
-		return product.m_validTTHTaus[0]->getDiscriminator("hpsPFTauDiscriminationByIsolationMVA2raw", event.m_tauMetadata);
+		return m_tauDiscriminatorBinding.GetDiscriminator(product.m_validTTHTaus[0], m_isolationDiscriminatorHandle, event.m_tauMetadata, event.m_eventInfo);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddFloatQuantity("TTHTau2Iso", [this](HttTypes::event_type const& event, HttTypes::product_type const& product) {
-		return product.m_validTTHTaus[1]->getDiscriminator("hpsPFTauDiscriminationByIsolationMVA2raw", event.m_tauMetadata);
+		return m_tauDiscriminatorBinding.GetDiscriminator(product.m_validTTHTaus[1], m_isolationDiscriminatorHandle, event.m_tauMetadata, event.m_eventInfo);
 	});
 	LambdaNtupleConsumer<HttTypes>::AddIntQuantity("TTHTau1DecayMode", [this](HttTypes::event_type const& event, HttTypes::product_type const& product) {
 		return product.m_validTTHTaus[0]->decayMode;
@@ -71,8 +73,8 @@ void TTHTauPairProducer::Produce(event_type const& event, product_type& product,
 				continue;
 		
 			//check the combined isolation of the tau pair
-			float iso1 = tau1->getDiscriminator("hpsPFTauDiscriminationByIsolationMVA2raw", event.m_tauMetadata);
-			float iso2 = tau2->getDiscriminator("hpsPFTauDiscriminationByIsolationMVA2raw", event.m_tauMetadata);
+			float iso1 = m_tauDiscriminatorBinding.GetDiscriminator(tau1, m_isolationDiscriminatorHandle, event.m_tauMetadata, event.m_eventInfo);
+			float iso2 = m_tauDiscriminatorBinding.GetDiscriminator(tau2, m_isolationDiscriminatorHandle, event.m_tauMetadata, event.m_eventInfo);
 			
 			float tempCombinedIso = (iso1 + 1.0)*(iso1 + 1.0) + (iso2 + 1.0)*(iso2 + 1.0);
 			
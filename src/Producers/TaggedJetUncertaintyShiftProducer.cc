@@ -16,6 +16,11 @@ std::string TaggedJetUncertaintyShiftProducer::GetProducerId() const
 	return "TaggedJetUncertaintyShiftProducer";
 }
 
+std::vector<std::string> TaggedJetUncertaintyShiftProducer::GetVariedSettings() const
+{
+	return { "JetEnergyCorrectionUncertaintyShift" };
+}
+
 void TaggedJetUncertaintyShiftProducer::Init(setting_type const& settings)
 {
 	ProducerBase<HttTypes>::Init(settings);
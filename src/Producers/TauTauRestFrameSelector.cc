@@ -68,7 +68,7 @@ void TauTauRestFrameSelector::Produce(event_type const& event, product_type& pro
 	else if (tauTauRestFrameReco == HttEnumTypes::TauTauRestFrameReco::SVFIT)
 	{
 		product.m_tauMomentaReconstructed = false;
-		product.m_diTauSystem = *(product.m_svfitResults.fittedHiggsLV);
+		product.m_diTauSystem = product.m_svfitResults.fittedHiggsLV;
 		product.m_diTauSystemReconstructed = (product.m_diTauSystem.mass() > 0.0); // TODO
 	}
 	else
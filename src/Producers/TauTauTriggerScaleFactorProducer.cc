@@ -15,7 +15,7 @@ void TauTauTriggerScaleFactorProducer::Produce( event_type const& event, product
 	{
 		double WeightTau = 1.0;
 		KLepton* lepton = product.m_flavourOrderedLeptons[index];
-		auto args = std::vector<double>{lepton->p4.Pt()};
+		m_tauTriggerFunctors.SetArgument(RooFunctorSet::ArgumentRole::LEPTON_PT, lepton->p4.Pt());
 		KappaEnumTypes::GenMatchingCode genMatchingCode = KappaEnumTypes::GenMatchingCode::NONE;
 		KLepton* originalLepton = const_cast<KLepton*>(SafeMap::GetWithDefault(product.m_originalLeptons, const_cast<const KLepton*>(lepton), const_cast<const KLepton*>(lepton)));
 		if (settings.GetUseUWGenMatching())
@@ -32,11 +32,11 @@ void TauTauTriggerScaleFactorProducer::Produce( event_type const& event, product
 		}
 		if (genMatchingCode == KappaEnumTypes::GenMatchingCode::IS_TAU_HAD_DECAY)
 		{
-			WeightTau = m_functorTau1->eval(args.data());
+			WeightTau = m_tauTriggerFunctors.Eval(0);
 		}
 		else
 		{
-			WeightTau = m_functorTau1ss->eval(args.data());
+			WeightTau = m_tauTriggerFunctors.Eval(1);
 		}
 		product.m_weights["triggerWeight_"+std::to_string(index+1)] = WeightTau;
 	}
@@ -20,20 +20,30 @@ void ZPtReweightProducer::Init(setting_type const& settings)
 	gDirectory = savedir;
 	gFile = savefile;
 
-	m_ZptWeightFunktor = m_workspace->function("zpt_weight_nom")->functor(m_workspace->argSet({"z_gen_mass,z_gen_pt"}));
+	std::vector<std::string> functionNames = {"zpt_weight_nom"};
+	m_ZptWeightNames = {"zPtReweightWeight"};
 	if (settings.GetDoZptUncertainties())
 	{
-		m_ZptWeightUncertaintiesFunktor["zPtWeightEsUp"] = m_workspace->function("zpt_weight_esup")->functor(m_workspace->argSet("z_gen_mass,z_gen_pt"));
-		m_ZptWeightUncertaintiesFunktor["zPtWeightEsDown"] = m_workspace->function("zpt_weight_esdown")->functor(m_workspace->argSet("z_gen_mass,z_gen_pt"));
-		m_ZptWeightUncertaintiesFunktor["zPtWeightStatPt0Up"] = m_workspace->function("zpt_weight_statpt0up")->functor(m_workspace->argSet("z_gen_mass,z_gen_pt"));
-		m_ZptWeightUncertaintiesFunktor["zPtWeightStatPt0Down"] = m_workspace->function("zpt_weight_statpt0down")->functor(m_workspace->argSet("z_gen_mass,z_gen_pt"));
-		m_ZptWeightUncertaintiesFunktor["zPtWeightStatPt40Up"] = m_workspace->function("zpt_weight_statpt40up")->functor(m_workspace->argSet("z_gen_mass,z_gen_pt"));
-		m_ZptWeightUncertaintiesFunktor["zPtWeightStatPt40Down"] = m_workspace->function("zpt_weight_statpt40down")->functor(m_workspace->argSet("z_gen_mass,z_gen_pt"));
-		m_ZptWeightUncertaintiesFunktor["zPtWeightStatPt80Up"] = m_workspace->function("zpt_weight_statpt80up")->functor(m_workspace->argSet("z_gen_mass,z_gen_pt"));
-		m_ZptWeightUncertaintiesFunktor["zPtWeightStatPt80Down"] = m_workspace->function("zpt_weight_statpt80down")->functor(m_workspace->argSet("z_gen_mass,z_gen_pt"));
-		m_ZptWeightUncertaintiesFunktor["zPtWeightTTbarUp"] = m_workspace->function("zpt_weight_ttup")->functor(m_workspace->argSet("z_gen_mass,z_gen_pt"));
-		m_ZptWeightUncertaintiesFunktor["zPtWeightTTbarDown"] = m_workspace->function("zpt_weight_ttdown")->functor(m_workspace->argSet("z_gen_mass,z_gen_pt"));
+		std::vector<std::pair<std::string, std::string> > uncertainties = {
+				{"zPtWeightEsUp", "zpt_weight_esup"},
+				{"zPtWeightEsDown", "zpt_weight_esdown"},
+				{"zPtWeightStatPt0Up", "zpt_weight_statpt0up"},
+				{"zPtWeightStatPt0Down", "zpt_weight_statpt0down"},
+				{"zPtWeightStatPt40Up", "zpt_weight_statpt40up"},
+				{"zPtWeightStatPt40Down", "zpt_weight_statpt40down"},
+				{"zPtWeightStatPt80Up", "zpt_weight_statpt80up"},
+				{"zPtWeightStatPt80Down", "zpt_weight_statpt80down"},
+				{"zPtWeightTTbarUp", "zpt_weight_ttup"},
+				{"zPtWeightTTbarDown", "zpt_weight_ttdown"}
+		};
+		for (std::pair<std::string, std::string> const& uncertainty : uncertainties)
+		{
+			m_ZptWeightNames.push_back(uncertainty.first);
+			functionNames.push_back(uncertainty.second);
+		}
 	}
+	m_ZptWeightFunktors.Init(m_workspace, functionNames, "z_gen_mass,z_gen_pt");
+	m_ZptWeights.resize(m_ZptWeightFunktors.GetNFunctions());
 	
 	m_applyReweighting = boost::regex_search(settings.GetNickname(), boost::regex("DY.?JetsToLLM(50|150)", boost::regex::icase | boost::regex::extended));
 }
@@ -58,14 +68,12 @@ void ZPtReweightProducer::Produce( event_type const& event, product_type & produ
 		}
 		genPt = genMomentum.Pt();
 		genMass = genMomentum.M();
-		auto args = std::vector<double>{genMass,genPt};
-		product.m_optionalWeights["zPtReweightWeight"] = m_ZptWeightFunktor->eval(args.data());
-		if (settings.GetDoZptUncertainties())
+		m_ZptWeightFunktors.SetArgument(RooFunctorSet::ArgumentRole::GEN_BOSON_MASS, genMass);
+		m_ZptWeightFunktors.SetArgument(RooFunctorSet::ArgumentRole::GEN_BOSON_PT, genPt);
+		m_ZptWeightFunktors.EvalMany(m_ZptWeights.data());
+		for (size_t index = 0; index < m_ZptWeightNames.size(); ++index)
 		{
-			for(auto uncertainty: m_ZptWeightUncertaintiesFunktor)
-			{
-				product.m_optionalWeights[uncertainty.first] = uncertainty.second->eval(args.data());
-			}
+			product.m_optionalWeights[m_ZptWeightNames[index]] = m_ZptWeights[index];
 		}
 	}
 }
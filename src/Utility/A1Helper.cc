@@ -2,9 +2,10 @@
 #include <iostream>
 
 a1Helper::a1Helper(){
+  SetParameters();
 }
 
-a1Helper::a1Helper(vector<TLorentzVector> TauA1andProd){
+a1Helper::a1Helper(vector<TLorentzVector> const& TauA1andProd){
   if(TauA1andProd.size()!=4){
     std::cout<<" Warning!! Size of input vector != 4 !! "<<std::endl;
   }
@@ -13,16 +14,21 @@ a1Helper::a1Helper(vector<TLorentzVector> TauA1andProd){
 }
 
 
-a1Helper::a1Helper(vector<TLorentzVector> TauA1andProd, TLorentzVector RefernceFrame){
+a1Helper::a1Helper(vector<TLorentzVector> const& TauA1andProd, TLorentzVector const& RefernceFrame){
   if(TauA1andProd.size()!=4){
     std::cout<<" Warning!! Size of input vector != 4 !! "<<std::endl;
   }
   Setup(TauA1andProd,RefernceFrame);
 }
 
+a1Helper::a1Helper(TLorentzVector const& tau, TLorentzVector const& osPion, TLorentzVector const& ss1Pion, TLorentzVector const& ss2Pion, TLorentzVector const& RefernceFrame){
+  TLorentzVector TauA1andProd[4] = {tau, osPion, ss1Pion, ss2Pion};
+  Setup(TauA1andProd,RefernceFrame);
+}
 
-void 
-a1Helper::Setup(vector<TLorentzVector> TauA1andProd, TLorentzVector ReferenceFrame){
+
+void
+a1Helper::SetParameters(){
    mpi   = 0.13957018; // GeV 
    mpi0 = 0.1349766;   // GeV
    mtau = 1.776; // GeV
@@ -41,21 +47,40 @@ a1Helper::Setup(vector<TLorentzVector> TauA1andProd, TLorentzVector ReferenceFra
    grhopipi = 6.08;  //GeV
    beta = -0.145;
    debug  = false;
-   for(unsigned int i=0; i<TauA1andProd.size(); i++){
-     TauA1andProd_RF.push_back(Boost(TauA1andProd.at(i),ReferenceFrame));
+   isConfigured_ = false;
+
+   ppiAtMrho = ppi(mrho*mrho);
+   ga1AtMa1 = ga1(ma1);
+}
+
+void 
+a1Helper::Setup(vector<TLorentzVector> const& TauA1andProd, TLorentzVector const& ReferenceFrame){
+  if(TauA1andProd.size()<4){
+    SetParameters();
+    return;
+  }
+  Setup(&(TauA1andProd[0]),ReferenceFrame);
+}
+
+void 
+a1Helper::Setup(TLorentzVector const TauA1andProd[4], TLorentzVector const& ReferenceFrame){
+   SetParameters();
+   for(unsigned int i=0; i<4; i++){
+     TauA1andProd_RF[i] = Boost(TauA1andProd[i],ReferenceFrame);
    }
-   LFosPionLV  = TauA1andProd.at(1);
-   LFss1pionLV =TauA1andProd.at(2);
-   LFss2pionLV =TauA1andProd.at(3);
+   isConfigured_ = true;
+   LFosPionLV  = TauA1andProd[1];
+   LFss1pionLV =TauA1andProd[2];
+   LFss2pionLV =TauA1andProd[3];
    LFa1LV = LFosPionLV+LFss1pionLV+LFss2pionLV;
-   LFtauLV = TauA1andProd.at(0);
+   LFtauLV = TauA1andProd[0];
    LFQ= LFa1LV.M();
 
-   _osPionLV   = TauA1andProd_RF.at(1);
-   _ss1pionLV =TauA1andProd_RF.at(2);
-   _ss2pionLV =TauA1andProd_RF.at(3);
+   _osPionLV   = TauA1andProd_RF[1];
+   _ss1pionLV =TauA1andProd_RF[2];
+   _ss2pionLV =TauA1andProd_RF[3];
    _a1LV = _osPionLV+_ss1pionLV+_ss2pionLV;
-   _tauLV = TauA1andProd_RF.at(0);
+   _tauLV = TauA1andProd_RF[0];
    _s12 = _ss1pionLV +_ss2pionLV;
    _s13 = _ss1pionLV + _osPionLV;
    _s23 = _ss2pionLV + _osPionLV;
@@ -63,6 +88,9 @@ a1Helper::Setup(vector<TLorentzVector> TauA1andProd, TLorentzVector ReferenceFra
    _s2  =  _s13.M2();
    _s3  =  _s12.M2();
    _Q = _a1LV.M();
+
+   UpdateStructureFunctions();
+   UpdateAngles();
 }
 
 void 
@@ -71,12 +99,69 @@ a1Helper::subSetup(double s1, double s2, double s3, double Q){
    _s2  =   s2;
    _s3  =   s3;
    _Q = Q;
+   UpdateStructureFunctions();
+}
+
+void
+a1Helper::UpdateStructureFunctions(){
+  // kinematic factors
+  double QQ = _Q*_Q;
+  _VV1 = _s2 - 4*mpi*mpi + pow(_s3 - _s1,2)/4/QQ; //  this is -V1^{2}
+  _VV2 = _s1 - 4*mpi*mpi + pow(_s3 - _s2,2)/4/QQ; //  this is -V2^{2}
+  _V1V2 = (QQ/2 - _s3 - 0.5*mpi*mpi) + (_s3 - _s1)*(_s3 - _s2)/4/QQ; // this is -V1V2
+  _h0 = -4*mpi*mpi + pow(2*mpi*mpi - _s1 - _s2,2)/QQ; // this is -3sqrt{h0}/2
+  _h = (_s1*_s2*_s3 - mpi*mpi*pow(QQ - mpi*mpi,2))/_h0/QQ;  // this is sqrt{h}
+
+  // form factors
+  TComplex BWa1 = BreitWigner(_Q,ResonanceType::A1);
+  TComplex BRho1 = BRho(sqrt(_s1));
+  TComplex BRho2 = BRho(sqrt(_s2));
+  TComplex scale12(0, -2*sqrt(2)/3/fpi);
+  _F1 = scale12*BWa1*BRho2;
+  _F2 = scale12*BWa1*BRho1;
+  TComplex scale4(0, -gpiprimerhopi*grhopipi*fpiprime/2/pow(mrho,4)/pow(mpiprime,3));
+  _F4 = scale4*BreitWigner(_Q,ResonanceType::PiPrime)*(_s1*(_s2-_s3)*BRho1 + _s2*(_s1-_s3)*BRho2);
+
+  // structure functions
+  double undersqrt1 = _VV1  -_h;
+  double undersqrt2 = _VV2  -_h;
+  double F1Rho2 = _F1.Rho2();
+  double F2Rho2 = _F2.Rho2();
+  TComplex F1F2 = _F1*Conjugate(_F2);
+  TComplex F1F4 = _F1*Conjugate(_F4);
+  TComplex F2F4 = _F2*Conjugate(_F4);
+
+  _WA = _VV1*F1Rho2 + _VV2*F2Rho2  + 2*_V1V2*F1F2.Re();
+  _WC = -(-_VV1 + 2*_h )*F1Rho2 - (-_VV2 + 2*_h)*F2Rho2   -   (-2*_V1V2 - 4*_h)*F1F2.Re();
+  _WD = -sqrt(_h) * ( 2 * sqrt(undersqrt1) * F1Rho2 - 2*sqrt(undersqrt2)*F2Rho2  
+		      + (QQ - mpi*mpi + _s3)*(_s1 - _s2 )*F1F2.Re()/QQ/sqrt(_h0 ) );
+  _WE = 3*sqrt(_h*_h0)*F1F2.Im();
+  _WSA = QQ*_F4.Rho2();
+  _WSB = -2*_Q* (sqrt(undersqrt1) * F1F4.Re() +   sqrt(undersqrt2)*F2F4.Re()  );
+  _WSD = 2*sqrt(QQ*_h)* ( F1F4.Re() - F2F4.Re()   );
+  _WSC = 2*_Q* (sqrt(undersqrt1) * F1F4.Im() +   sqrt(undersqrt2)*F2F4.Im()  );
+  _WSE = -2*sqrt(QQ*_h)* ( F1F4.Im() - F2F4.Im()   );
+}
+
+void
+a1Helper::UpdateAngles(){
+  // the order matters, since the sine functions use the cached cosine values
+  _costhetaLF = computeCosthetaLF();
+  _sinthetaLF = computeSinthetaLF();
+  _cospsiLF = computeCospsiLF();
+  _sinpsiLF = computeSinpsiLF();
+  _cosbeta = computeCosbeta();
+  _sinbeta = computeSinbeta();
+  _cosgamma = computeCosgamma();
+  _singamma = computeSingamma();
+  _cosalpha = computeCosalpha();
+  _sinalpha = computeSinalpha();
 }
 
 
 
 void 
-a1Helper::Configure(vector<TLorentzVector> TauA1andProd){
+a1Helper::Configure(vector<TLorentzVector> const& TauA1andProd){
 
   if(TauA1andProd.size()!=4){
     std::cout<<" Warning!! Size of input vector != 4 !! "<<std::endl;
@@ -87,7 +172,7 @@ a1Helper::Configure(vector<TLorentzVector> TauA1andProd){
 }
 
 void 
-a1Helper::Configure(vector<TLorentzVector> TauA1andProd, TLorentzVector RefernceFrame){
+a1Helper::Configure(vector<TLorentzVector> const& TauA1andProd, TLorentzVector const& RefernceFrame){
   if(TauA1andProd.size()!=4){
     std::cout<<" a1 helper:  Warning!! Size of input vector != 4!   Size = "<< TauA1andProd.size()<<std::endl;
   }
@@ -96,7 +181,7 @@ a1Helper::Configure(vector<TLorentzVector> TauA1andProd, TLorentzVector Refernce
 }
 bool
 a1Helper::isConfigured(){
-  if(TauA1andProd_RF.size()!=4){ std::cout<<"Error:   a1Helper is not Configured! Check  the size of input vector!  Size =  "<< TauA1andProd_RF.size() <<std::endl; return false;} return true;
+  if(!isConfigured_){ std::cout<<"Error:   a1Helper is not Configured! Check  the size of input vector!"<<std::endl; return false;} return true;
 }
 
 
@@ -132,30 +217,49 @@ a1Helper::lambda(double x, double y, double z){
     return x*x +y*y +z*z - 2*x*y - 2*x*z - 2*z*y;
 }
 TLorentzVector 
-a1Helper::Boost(TLorentzVector pB, TLorentzVector frame){
-   TMatrixT<double> transform(4,4);
-   TMatrixT<double> result(4,1);
-   TVectorT<double> vec(4); 
+a1Helper::Boost(TLorentzVector const& pB, TLorentzVector const& frame){
    TVector3 b;
    if(frame.Vect().Mag()==0){ std::cout<<" Boost is not set, perfrom calculation in the Lab Frame   "<<std::endl; return pB;}
     if(frame.E()==0){ std::cout<<" Caution: Please check that you perform boost correctly!  " <<std::endl; return pB;} 
    else   b=frame.Vect()*(1/frame.E());
-   vec(0)  = pB.E();    vec(1)  = pB.Px();
-   vec(2)  = pB.Py();  vec(3)  = pB.Pz();
    double gamma  = 1/sqrt( 1 - b.Mag2());
-   transform(0,0)=gamma; transform(0,1) =- gamma*b.X() ;  transform(0,2) =  - gamma*b.Y();  transform(0,3) = - gamma*b.Z(); 
-   transform(1,0)=-gamma*b.X(); transform(1,1) =(1+ (gamma-1)*b.X()*b.X()/b.Mag2()) ;  transform(1,2) = ((gamma-1)*b.X()*b.Y()/b.Mag2());  transform(1,3) = ((gamma-1)*b.X()*b.Z()/b.Mag2());
-   transform(2,0)=-gamma*b.Y(); transform(2,1) = ((gamma-1)*b.Y()*b.X()/b.Mag2());  transform(2,2) = (1 + (gamma-1)*b.Y()*b.Y()/b.Mag2());  transform(2,3) =  ((gamma-1)*b.Y()*b.Z()/b.Mag2()); 
-   transform(3,0)=-gamma*b.Z(); transform(3,1) =((gamma-1)*b.Z()*b.X()/b.Mag2()) ;  transform(3,2) = ((gamma-1)*b.Z()*b.Y()/b.Mag2());  transform(3,3) = (1 + (gamma-1)*b.Z()*b.Z()/b.Mag2()); 
-   result=transform*convertToMatrix(vec);
-   return TLorentzVector(result(1,0), result(2,0) ,result(3,0), result(0,0));
+   double bp = b.Dot(pB.Vect());
+   TVector3 p = pB.Vect() + ((gamma-1)*bp/b.Mag2() - gamma*pB.E())*b;
+   return TLorentzVector(p.X(), p.Y(), p.Z(), gamma*(pB.E() - bp));
 }
 double 
-a1Helper::Scalar(TLorentzVector p1, TLorentzVector p2){
+a1Helper::Scalar(TLorentzVector const& p1, TLorentzVector const& p2){
     return p1.Vect()*p2.Vect();
 }
+a1Helper::StructureFunctionType
+a1Helper::ToStructureFunctionType(string const& type){
+  if(type=="WA") return StructureFunctionType::WA;
+  if(type=="WC") return StructureFunctionType::WC;
+  if(type=="WSA") return StructureFunctionType::WSA;
+  if(type=="WSB") return StructureFunctionType::WSB;
+  if(type=="WD") return StructureFunctionType::WD;
+  if(type=="WE") return StructureFunctionType::WE;
+  if(type=="WSD") return StructureFunctionType::WSD;
+  return StructureFunctionType::NONE;
+}
+
 double 
 a1Helper::MomentSFunction(double s, string type){
+  return MomentSFunction(s,ToStructureFunctionType(type));
+}
+
+double 
+a1Helper::MomentSFunction(double s, StructureFunctionType type){
+  if(type==StructureFunctionType::NONE) return 0;
+
+  double s1(_s1), s2(_s2), s3(_s3), Q(_Q);
+  double integral = IntegrateMomentSFunction(s,type);
+  subSetup(s1,s2,s3,Q);
+  return integral;
+}
+
+double 
+a1Helper::IntegrateMomentSFunction(double s, StructureFunctionType type){
   int cells(50);
   //  double s = Q*Q;
   double intx(0);
@@ -164,14 +268,8 @@ a1Helper::MomentSFunction(double s, string type){
   double m3 = mpi;
 
   double m13(0);
-  double integral(0);
 
   double da1(0), db1(0);
-  vector<double> set;
-  set.push_back(_s1);
-  set.push_back(_s2);
-  set.push_back(_s3);
-  set.push_back(_Q);
   double  stepx  = (pow(sqrt(s)-m2,2) - pow( m1+m3,2) ) / cells;
   for(int i=1;i<cells + 1;i++){ 
     da1 = pow(m1+m3,2) + stepx*(i-1);
@@ -192,100 +290,25 @@ a1Helper::MomentSFunction(double s, string type){
       m23 = 0.5*(da2 + db2);
       m12 = s +m1*m1 + m2*m2 + m3*m3 - m13 - m23;
       subSetup(m23,m13,m12,sqrt(s)); 
-      // if(s >1.88 && s < 1.90)    std::cout<<"  WD=    "<< WD() << "        m23 = "<< m23 << "       m13= " << m13 <<    "     m12=   "<< m12 << "    sqrts=  " << sqrt(s) <<std::endl;
-      // if(s >1.88 && s < 1.90)    std::cout<<"  F1  "<< F1() << "  F2 "<< F2() << " h0 " << h0()<<    "  VV1()-h()=   "<< VV1()-h() << " VV2() -h()=  " <<VV2()-h() <<std::endl;
       double SFunction(0);
-      if(type=="WA")SFunction=WA();
-      if(type=="WC")SFunction=WC();
-      if(type=="WSA")SFunction=WSA();
-      if(type=="WSB")SFunction=WSB();
-      if(type=="WD"  ){
-	if(m23 > m13)SFunction=WD();
-	else SFunction=-WD();
-      }
-      if(type=="WE"){
-	if(m23 > m13)SFunction=WE();
-	else SFunction=-WE();
+      switch(type){
+        case StructureFunctionType::WA: SFunction=WA(); break;
+        case StructureFunctionType::WC: SFunction=WC(); break;
+        case StructureFunctionType::WSA: SFunction=WSA(); break;
+        case StructureFunctionType::WSB: SFunction=WSB(); break;
+        case StructureFunctionType::WD: SFunction=((m23 > m13) ? WD() : -WD()); break;
+        case StructureFunctionType::WE: SFunction=((m23 > m13) ? WE() : -WE()); break;
+        case StructureFunctionType::WSD: SFunction=((m23 > m13) ? WSD() : -WSD()); break;
+        default: break;
       }
-      if(type=="WSD"){
-	if(m23 > m13)SFunction=WSD();
-	else SFunction=-WSD();
-      }
-      //      std::cout<<"SFunction  "<< SFunction<< std::endl;
       inty+=stepx*stepy*SFunction;
     }
     intx+=inty;
   }
-  integral = intx;
-  subSetup(set.at(0),set.at(1),set.at(2),set.at(3));
-
-
-
-  return integral;
+  return intx;
 }
  
 
-//---------------------------------------  hadronic current ---------------------------
-double 
-a1Helper::WA(){
-   return  VV1()*F1().Rho2() + VV2()*F2().Rho2()  + 2*V1V2()*( F1()*Conjugate(F2()) ).Re();
-
- }
-
- double 
-a1Helper::WC(){
-   return  -(-VV1() + 2*h() )*F1().Rho2() - (-VV2() + 2*h())*F2().Rho2()   -   (-2*V1V2() - 4*h())*( F1()*Conjugate(F2()) ).Re();
- } 
-
- double
- a1Helper::WD(){
-   double QQ = _Q*_Q;
-   double undersqrt1 = VV1()  -h();
-   double undersqrt2 = VV2()  -h();
-
-   return  -sqrt(h()) * ( 2 * sqrt(undersqrt1) * F1().Rho2() - 2*sqrt(undersqrt2)*F2().Rho2()  
-			  + (QQ - mpi*mpi + _s3)*(_s1 - _s2 )*( F1()*Conjugate(F2()) ).Re()/QQ/sqrt(h0() ) );
-
-
- }
-
- double
- a1Helper::WE(){
-  return  3*sqrt(h()*h0())*( F1()*Conjugate(F2()) ).Im();
- }
-
-double
- a1Helper::WSA(){
-  double QQ = _Q*_Q;
-  return  QQ*F4().Rho2();
- }
-double
- a1Helper::WSB(){
-  //  double QQ = _Q*_Q;
-   double undersqrt1 = VV1()  -h();
-   double undersqrt2 = VV2()  -h();
-   return  -2*_Q* (sqrt(undersqrt1) * (F1()*Conjugate(F4())).Re() +   sqrt(undersqrt2)*(F2()*Conjugate(F4())).Re()  );
- }
-double
- a1Helper::WSD(){
-  double QQ = _Q*_Q;
-  return  2*sqrt(QQ*h())* ( (F1()*Conjugate(F4())).Re() - (F2()*Conjugate(F4())).Re()   );
- }
-double
- a1Helper::WSC(){
-  //  double QQ = _Q*_Q;
-   double undersqrt1 = VV1()  -h();
-   double undersqrt2 = VV2()  -h();
-   return  2*_Q* (sqrt(undersqrt1) * (F1()*Conjugate(F4())).Im() +   sqrt(undersqrt2)*(F2()*Conjugate(F4())).Im()  );
- }
-double
- a1Helper::WSE(){
-  double QQ = _Q*_Q;
-   return  -2*sqrt(QQ*h())* ( (F1()*Conjugate(F4())).Im() - (F2()*Conjugate(F4())).Im()   );
- }
-
-
-
 double
 a1Helper::cosgammaLF(){
   double QQ=LFQ*LFQ;
@@ -337,7 +360,7 @@ a1Helper::sin2gamma(){
   return 2*singamma()*cosgamma();
 }
 double 
-a1Helper::cospsiLF(){
+a1Helper::computeCospsiLF(){
   double QQ = LFQ*LFQ;
   double s = 4*LFtauLV.E()*LFtauLV.E();
   double x = 2*LFa1LV.E()/sqrt(s);
@@ -345,7 +368,7 @@ a1Helper::cospsiLF(){
   return    ( x*(mtau*mtau + QQ)  - 2*QQ  )   /   ( mtau*mtau  - QQ   ) / sqrt(x*x  - 4*QQ/s); 
 }
 double 
-a1Helper::sinpsiLF(){
+a1Helper::computeSinpsiLF(){
   if(cospsiLF()*cospsiLF() > 1  ){if(debug){std::cout<<"Warning! In a1Helper::sinpsi root square <=0! return nan"<<std::endl;}}
   return    sqrt(1 - cospsiLF()*cospsiLF());
 }
@@ -358,7 +381,7 @@ a1Helper::ultrarel_cospsiLF(){
 }
 
 double 
-a1Helper::costhetaLF(){
+a1Helper::computeCosthetaLF(){
   double QQ = LFQ*LFQ;
   double x = LFa1LV.E()/LFtauLV.E();
   double s = 4*LFtauLV.E()*LFtauLV.E();
@@ -366,7 +389,7 @@ a1Helper::costhetaLF(){
   return (2*x*mtau*mtau - mtau*mtau - QQ)/( (mtau*mtau - QQ)*sqrt(1 - 4*mtau*mtau/s) );
 }
 double 
-a1Helper::sinthetaLF(){
+a1Helper::computeSinthetaLF(){
   if( costhetaLF()*costhetaLF() > 1 ) {if(debug){std::cout<<"Warning! In a1Helper::sin theta root square <=0! return nan;   costheta = "<< costhetaLF()<<std::endl; }}
   return sqrt(1- costhetaLF()*costhetaLF());
 }
@@ -387,71 +410,14 @@ a1Helper::cosbetaLF(){
   return ospionVect.Dot(ss1pionVect.Cross(ss2pionVect)) /LFa1LV.P()/T;
 }
 
-double
-a1Helper::VV1(){ //  this is -V1^{2}
-  double QQ = _Q*_Q;
-  return  _s2 - 4*mpi*mpi + pow(_s3 - _s1,2)/4/QQ;
-}
-
-double
-a1Helper::VV2(){ //  this is -V2^{2}
-  double QQ = _Q*_Q;
-  return  _s1 - 4*mpi*mpi + pow(_s3 - _s2,2)/4/QQ;
-}
-
-double
-a1Helper::V1V2(){  // this is -V1V2
-  double QQ = _Q*_Q;
-  return  (QQ/2 - _s3 - 0.5*mpi*mpi) + (_s3 - _s1)*(_s3 - _s2)/4/QQ;
-}
-
-
-double
-a1Helper::h0(){ // this is -3sqrt{h0}/2
-  double QQ = _Q*_Q;
-  return -4*mpi*mpi + pow(2*mpi*mpi - _s1 - _s2,2)/QQ;
-}
-
-double
-a1Helper::h(){
-  double QQ = _Q*_Q;
-  return (_s1*_s2*_s3 - mpi*mpi*pow(QQ - mpi*mpi,2))/h0()/QQ;  // this is sqrt{h}
-}
-
-
-
-TComplex 
-a1Helper::F1(){
-  TComplex scale(0, -2*sqrt(2)/3/fpi);
-  TComplex res = scale*BreitWigner(_Q,"a1")*BRho(sqrt(_s2));
-  //  std::cout<<"  BreitWigner(_Q,a1)  " << BreitWigner(_Q,"a1") << " BRho(_s2)  " << BRho(sqrt(_s2))<< std::endl;
-  return res;
-}
-
-
-TComplex 
-a1Helper::F2(){
-  TComplex scale(0, -2*sqrt(2)/3/fpi);
-  TComplex res = scale*BreitWigner(_Q,"a1")*BRho(sqrt(_s1));
-  return res;
-}
-
-TComplex 
-a1Helper::F4(){
-  TComplex scale(0, -gpiprimerhopi*grhopipi*fpiprime/2/pow(mrho,4)/pow(mpiprime,3));
-  TComplex res = scale*BreitWigner(_Q,"piprime")*(_s1*(_s2-_s3)*BRho(sqrt(_s1)) + _s2*(_s1-_s3)*BRho(sqrt(_s2)));
-  return res;
-}
-
-
 TComplex 
 a1Helper::BRho(double Q){
   //  std::cout<<"BRho:      BreitWigner(Q) " << BreitWigner(Q) << " BreitWigner(Q,rhoprime) " << BreitWigner(Q,"rhoprime")<< std::endl;
-  return (BreitWigner(Q) + beta*BreitWigner(Q,"rhoprime"))/(1+beta);
+  return (BreitWigner(Q) + beta*BreitWigner(Q,ResonanceType::RhoPrime))/(1+beta);
 }
 
 TComplex 
-a1Helper::BreitWigner(double Q, string type){
+a1Helper::BreitWigner(double Q, ResonanceType type){
   double QQ=Q*Q;
   double re,im;
   double m = Mass(type);
@@ -463,19 +429,21 @@ a1Helper::BreitWigner(double Q, string type){
 }
 
 double
-a1Helper::Widths(double Q, string type){
+a1Helper::Widths(double Q, ResonanceType type){
   double QQ = Q*Q;
   double Gamma;
-  Gamma = Gamma0rho*mrho*pow( ppi(QQ)  / ppi(mrho*mrho), 3) /sqrt(QQ);
-  if(type == "rhoprime"){
+  if(type == ResonanceType::RhoPrime){
     Gamma=Gamma0rhoprime*QQ/mrhoprime/mrhoprime;
- }
-  if(type == "a1"){
-    Gamma=Gamma0a1*ga1(Q)/ga1(ma1);
- }
-  if(type == "piprime"){
+  }
+  else if(type == ResonanceType::A1){
+    Gamma=Gamma0a1*ga1(Q)/ga1AtMa1;
+  }
+  else if(type == ResonanceType::PiPrime){
     Gamma = Gamma0piprime*pow( sqrt(QQ)/mpiprime  ,5)*pow( (1-mrho*mrho/QQ)/(1-mrho*mrho/mpiprime/mpiprime) ,3);
   }
+  else{
+    Gamma = Gamma0rho*mrho*pow( ppi(QQ)  / ppiAtMrho, 3) /sqrt(QQ);
+  }
   //  std::cout<< " Widths :   type   " << type << " Gamma  " << Gamma << "  QQ  "<< QQ <<std::endl;
   return Gamma;
 }
@@ -484,11 +452,11 @@ double a1Helper::ga1(double  Q){
   return (QQ > pow(mrho + mpi,2)) ?  QQ*(1.623 + 10.38/QQ - 9.32/QQ/QQ   + 0.65/QQ/QQ/QQ)  : 4.1*pow(QQ - 9*mpi*mpi,3)*(  1 - 3.3*(QQ - 9*mpi*mpi)  + 5.8*pow(QQ - 9*mpi*mpi,2)  );
 }
 double
-a1Helper::Mass(string type){
+a1Helper::Mass(ResonanceType type){
   double m = mrho;
-  if(type == "rhoprime") return mrhoprime; 
-  if(type == "a1") return ma1;
-  if(type == "piprime") return mpiprime;
+  if(type == ResonanceType::RhoPrime) return mrhoprime; 
+  if(type == ResonanceType::A1) return ma1;
+  if(type == ResonanceType::PiPrime) return mpiprime;
   //std::cout<< "  type   " << type << " Mass  " << std::endl;
   return m;
 }
@@ -757,28 +725,28 @@ double a1Helper::TRF_singamma(){
  // double  TRF_cosbeta();      double  TRF_cosalpha();   double  TRF_cosgamma();  
  // double TRF_sinbeta();        double TRF_sinalpha();    double  TRF_singamma();  
 
-double a1Helper::cosalpha(){
+double a1Helper::computeCosalpha(){
    TVector3 nLCrossnT  = nL().Cross(nT());
    TVector3 nLCrossnPerp  = nL().Cross(nPerp());
 
    if(nLCrossnPerp.Mag() ==0 || nLCrossnT.Mag() ==0){if(debug){std::cout<<" Can not compute cos alpha, one denominator is 0, return cos alpha =0  "<< std::endl;} return 0;}
   return nLCrossnT.Dot(nLCrossnPerp)/nLCrossnT.Mag()/nLCrossnPerp.Mag();
 }
-double a1Helper::sinalpha(){
+double a1Helper::computeSinalpha(){
   TVector3 nLCrossnT  = nL().Cross(nT());
   TVector3 nLCrossnPerp  = nL().Cross(nPerp());
   if(nLCrossnPerp.Mag() ==0 || nLCrossnT.Mag() ==0){if(debug){std::cout<<" Can not compute sin alpha, one denominator is 0, return sin alpha =0  "<< std::endl; }return 0;}
   return -nT().Dot(nLCrossnPerp)/nLCrossnT.Mag()/nLCrossnPerp.Mag();
 }
-double a1Helper::cosbeta(){
+double a1Helper::computeCosbeta(){
   return nL().Dot(nPerp());
 }
-double a1Helper::sinbeta(){
+double a1Helper::computeSinbeta(){
   if(cosbeta()*cosbeta() > 1 ){if(debug){std::cout<<"Warning! Can not compute sin beta! return 0"<<std::endl;} return 0;}
   return sqrt(1 - cosbeta()*cosbeta());
 }
 
-double a1Helper::cosgamma(){
+double a1Helper::computeCosgamma(){
   TVector3 nLCrossnPerp  = nL().Cross(nPerp());
 
   TVector3 qvect = _osPionLV.Vect()*(1/_osPionLV.Vect().Mag());
@@ -787,7 +755,7 @@ double a1Helper::cosgamma(){
   return -nL()*qvect/nLCrossnPerp.Mag();
 }
 
-double a1Helper::singamma(){
+double a1Helper::computeSingamma(){
   TVector3 nLCrossnPerp  = nL().Cross(nPerp());
   TVector3 qvect = _osPionLV.Vect()*(1/_osPionLV.Vect().Mag());
 
@@ -798,7 +766,7 @@ double a1Helper::singamma(){
 
 
 TComplex 
-a1Helper::Conjugate(TComplex a){
+a1Helper::Conjugate(TComplex const& a){
   return TComplex(a.Re(), -a.Im());
 }
 TMatrixT<double> a1Helper::convertToMatrix(TVectorT<double> V){
@@ -1,19 +1,57 @@
-
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/CPQuantities.h"
 
+
+// boost into the ZMF of the (chargPart1+, chargedPart2-) decay
+CPQuantities::ZeroMomentumFrame CPQuantities::CalculateZeroMomentumFrame(RMFLV const& chargPart1, RMFLV const& chargPart2)
+{
+	ZeroMomentumFrame zmf;
+	RMFLV ProngImp = chargPart1 + chargPart2;
+	RMFLV::BetaVector boostvec = ProngImp.BoostToCM();
+	zmf.boost = ROOT::Math::Boost(boostvec);
+
+	zmf.labP1.SetXYZ(chargPart1.Px(), chargPart1.Py(), chargPart1.Pz());
+	zmf.labP2.SetXYZ(chargPart2.Px(), chargPart2.Py(), chargPart2.Pz());
+	zmf.chargPart1 = zmf.boost * chargPart1;
+	zmf.chargPart2 = zmf.boost * chargPart2;
+	zmf.p1.SetXYZ(zmf.chargPart1.Px(), zmf.chargPart1.Py(), zmf.chargPart1.Pz());
+	zmf.p2.SetXYZ(zmf.chargPart2.Px(), zmf.chargPart2.Py(), zmf.chargPart2.Pz());
+	return zmf;
+}
+
+
+// boost into the boson rest frame
+CPQuantities::BosonRestFrame CPQuantities::CalculateBosonRestFrame(RMFLV const& boson, RMFLV const& tau1, RMFLV const& chargPart1, RMFLV const& chargPart2)
+{
+	BosonRestFrame frame;
+	RMFLV::BetaVector boostvech = boson.BoostToCM();
+	frame.boost = ROOT::Math::Boost(boostvech);
+
+	frame.boson = frame.boost * boson;
+	frame.tau1 = frame.boost * tau1;
+	frame.chargPart1 = frame.boost * chargPart1;
+	frame.chargPart2 = frame.boost * chargPart2;
+	return frame;
+}
+
+
 // this version uses tau 4-momenta to calculate decay planes (useful for GenTauCPProducer)
-double CPQuantities::CalculatePhiStarCP(RMFLV tau1, RMFLV tau2, RMFLV chargPart1, RMFLV chargPart2)
+CPQuantities::PhiStarCPResult CPQuantities::CalculatePhiStarCP(ZeroMomentumFrame const& zmf, RMFLV const& tau1, RMFLV const& tau2)
 {
 	//Momentum vectors of the Taus
 	RMFLV::BetaVector k1, k2;
 	k1.SetXYZ(tau1.Px(), tau1.Py() , tau1.Pz());
 	k2.SetXYZ(tau2.Px(), tau2.Py() , tau2.Pz());
-	return this->CalculatePhiStarCPSame(k1, k2, chargPart1, chargPart2, "gen");
+	return CalculatePhiStarCPSame(zmf, k1, k2);
+}
+
+double CPQuantities::CalculatePhiStarCP(RMFLV const& tau1, RMFLV const& tau2, RMFLV const& chargPart1, RMFLV const& chargPart2)
+{
+	return CalculatePhiStarCP(CalculateZeroMomentumFrame(chargPart1, chargPart2), tau1, tau2).phiStarCP;
 }
 
 
 // this version uses track and vertex information to calculate the decay planes (useful for RecoTauCPProducer)
-double CPQuantities::CalculatePhiStarCP(KVertex* pv, KTrack track1, KTrack track2,  RMFLV chargPart1, RMFLV chargPart2)
+CPQuantities::PhiStarCPResult CPQuantities::CalculatePhiStarCP(ZeroMomentumFrame const& zmf, KVertex const* pv, KTrack const& track1, KTrack const& track2)
 {
 	//Primary vertex
 	RMFLV::BetaVector pvpos;
@@ -28,31 +66,30 @@ double CPQuantities::CalculatePhiStarCP(KVertex* pv, KTrack track1, KTrack track
 	RMFLV::BetaVector k1, k2;
 	k1 = track1pos - pvpos;
 	k2 = track2pos - pvpos;
-	return this->CalculatePhiStarCPSame(k1, k2, chargPart1, chargPart2, "reco");
+	return CalculatePhiStarCPSame(zmf, k1, k2);
+}
 
+double CPQuantities::CalculatePhiStarCP(KVertex const* pv, KTrack const& track1, KTrack const& track2, RMFLV const& chargPart1, RMFLV const& chargPart2)
+{
+	return CalculatePhiStarCP(CalculateZeroMomentumFrame(chargPart1, chargPart2), pv, track1, track2).phiStarCP;
 }
 
+
 //this function calculates Phi* and Phi*CP using the rho decay planes
-double CPQuantities::CalculatePhiStarCP_rho(RMFLV chargedPiP, RMFLV chargedPiM, RMFLV piZeroP, RMFLV piZeroM)
+double CPQuantities::CalculatePhiStarCP_rho(ZeroMomentumFrame const& zmf, RMFLV const& piZeroP, RMFLV const& piZeroM)
 {
-	// Part1: Boost into the ZMF frame of the two charged pions
-	RMFLV ProngImp = chargedPiP + chargedPiM;
-	RMFLV::BetaVector boostvec = ProngImp.BoostToCM();
-	ROOT::Math::Boost M(boostvec);
-
-	chargedPiP = M * chargedPiP;
-	chargedPiM = M * chargedPiM;
-	piZeroP = M * piZeroP;
-	piZeroM = M * piZeroM;
+	// Part1: Boost the neutral pions into the ZMF frame of the two charged pions
+	RMFLV piZeroPStar = zmf.boost * piZeroP;
+	RMFLV piZeroMStar = zmf.boost * piZeroM;
 
 	//Part2: Create the 3-momentum vectors of each of these. Notation according to Berge et al.
 
-	RMFLV::BetaVector qStarP, qStarM, qStarZeroP, qStarZeroM;
+	RMFLV::BetaVector qStarZeroP, qStarZeroM;
 
-	qStarP.SetXYZ(chargedPiP.Px(), chargedPiP.Py(), chargedPiP.Pz());
-	qStarM.SetXYZ(chargedPiM.Px(), chargedPiM.Py(), chargedPiM.Pz());
-	qStarZeroP.SetXYZ(piZeroP.Px(), piZeroP.Py(), piZeroP.Pz());
-	qStarZeroM.SetXYZ(piZeroM.Px(), piZeroM.Py(), piZeroM.Pz());
+	RMFLV::BetaVector const& qStarP = zmf.p1;
+	RMFLV::BetaVector const& qStarM = zmf.p2;
+	qStarZeroP.SetXYZ(piZeroPStar.Px(), piZeroPStar.Py(), piZeroPStar.Pz());
+	qStarZeroM.SetXYZ(piZeroMStar.Px(), piZeroMStar.Py(), piZeroMStar.Pz());
 
 	//Part3: Calculate transverse component of piZeroP/M to chargedPiP/M and normalise them
 	RMFLV::BetaVector qStarZeroPt = qStarZeroP - ((qStarZeroP.Dot(qStarP)) / (qStarP.Dot(qStarP))) * qStarP;
@@ -75,152 +112,101 @@ double CPQuantities::CalculatePhiStarCP_rho(RMFLV chargedPiP, RMFLV chargedPiM,
 
 }
 
-// calculation of variables Phi* and Phi*CP
-// IP vectors calculated within the function
-double CPQuantities::CalculatePhiStarCPSame(RMFLV::BetaVector k1, RMFLV::BetaVector k2, RMFLV chargPart1, RMFLV chargPart2, std::string level)
+double CPQuantities::CalculatePhiStarCP_rho(RMFLV const& chargedPiP, RMFLV const& chargedPiM, RMFLV const& piZeroP, RMFLV const& piZeroM)
 {
-	//Step 1: Creating a Boost M into the ZMF of the (chargPart1+, chargedPart2-) decay
-	RMFLV ProngImp = chargPart1 + chargPart2;
-	RMFLV::BetaVector boostvec = ProngImp.BoostToCM();
-	ROOT::Math::Boost M(boostvec);
+	return CalculatePhiStarCP_rho(CalculateZeroMomentumFrame(chargedPiP, chargedPiM), piZeroP, piZeroM);
+}
 
-	//Step 2: Calculating impact parameter vectors n1 n2
 
-	//Momentum vectors of the charged particles
-	RMFLV::BetaVector p1, p2;
-	p1.SetXYZ(chargPart1.Px(), chargPart1.Py() , chargPart1.Pz());
-	p2.SetXYZ(chargPart2.Px(), chargPart2.Py() , chargPart2.Pz());
+// calculation of variables Phi* and Phi*CP
+// IP vectors calculated within the function
+CPQuantities::PhiStarCPResult CPQuantities::CalculatePhiStarCPSame(ZeroMomentumFrame const& zmf, RMFLV::BetaVector const& k1, RMFLV::BetaVector const& k2)
+{
+	//Step 1: Calculating impact parameter vectors n1 n2 in the laboratory frame
+	RMFLV::BetaVector const& p1 = zmf.labP1;
+	RMFLV::BetaVector const& p2 = zmf.labP2;
 
 	//Not normalized n1, n2
 	RMFLV::BetaVector n1 = k1 - ((k1.Dot(p1)) / (p1.Dot(p1))) * p1;
 	RMFLV::BetaVector n2 = k2 - ((k2.Dot(p2)) / (p2.Dot(p2))) * p2;
-	
-	// FIXME: need to remove this block
-	//if(level=="reco")
-	//{
-	//	this->SetRecoIP1(n1.R());
-	//	this->SetRecoIP2(n2.R());
-	//}
-	
-	//Normalized n1, n2
-	n1 = n1.Unit();
-	n2 = n2.Unit();
 
-	//Step 3: Boosting 4-vectors (n1,0), (n2,0), p1, p2 with M
+	//Step 2: Boosting them into the ZMF and calculating Phi* and Phi*CP
+	return CalculatePhiStarCPFromIPVectors(zmf, n1.Unit(), n2.Unit());
+}
+
+
+// calculation of Phi* and Phi*CP from the normalised IP vectors in the laboratory frame
+CPQuantities::PhiStarCPResult CPQuantities::CalculatePhiStarCPFromIPVectors(ZeroMomentumFrame const& zmf, RMFLV::BetaVector const& n1, RMFLV::BetaVector const& n2)
+{
+	PhiStarCPResult result;
+
+	// boost IP vectors (n1,0), (n2,0) to the ZMF
 	RMFLV n1_mu, n2_mu;
 	n1_mu.SetPxPyPzE(n1.X(), n1.Y(), n1.Z(), 0);
 	n2_mu.SetPxPyPzE(n2.X(), n2.Y(), n2.Z(), 0);
 
-	n1_mu = M * n1_mu;
-	n2_mu = M * n2_mu;
-	chargPart1 = M * chargPart1;
-	chargPart2 = M * chargPart2;
-
-	//Step 4: Calculation of the transverse component of n1, n2 to p1, p2 (after Boosting)
-	n1.SetXYZ(n1_mu.Px(), n1_mu.Py(), n1_mu.Pz());
-	n2.SetXYZ(n2_mu.Px(), n2_mu.Py(), n2_mu.Pz());
-	p1.SetXYZ(chargPart1.Px(), chargPart1.Py(), chargPart1.Pz());
-	p2.SetXYZ(chargPart2.Px(), chargPart2.Py(), chargPart2.Pz());
-
-	RMFLV::BetaVector n1t = n1 - ((n1.Dot(p1)) / (p1.Dot(p1))) * p1;
-	n1t = n1t.Unit();
-	RMFLV::BetaVector n2t = n2 - ((n2.Dot(p2)) / (p2.Dot(p2))) * p2;
-	n2t = n2t.Unit();
-	RMFLV::BetaVector p1n = p1.Unit();
+	n1_mu = zmf.boost * n1_mu;
+	n2_mu = zmf.boost * n2_mu;
 
-	if(level=="reco")
-	{
-		this->SetRecoPhiStar(acos(n2t.Dot(n1t)));
-	}
-	else if (level=="gen")
-	{
-		this->SetGenPhiStar(acos(n2t.Dot(n1t)));
-	}
+	// get the transverse components of the IP vectors wrt corresponding momenta (after boosting)
+	RMFLV::BetaVector n1Star, n2Star;
+	n1Star.SetXYZ(n1_mu.Px(), n1_mu.Py(), n1_mu.Pz());
+	n2Star.SetXYZ(n2_mu.Px(), n2_mu.Py(), n2_mu.Pz());
+	RMFLV::BetaVector const& p1 = zmf.p1;
+	RMFLV::BetaVector const& p2 = zmf.p2;
 
-	this->SetGenOStarCP(p1n.Dot(n2t.Cross(n1t)));
-	//Step 5: Calculating Phi*CP
-	double phiStarCP = 0;
-	if(p1n.Dot(n2t.Cross(n1t))>=0)
+	result.n1t = n1Star - ((n1Star.Dot(p1)) / (p1.Dot(p1))) * p1;
+	result.n1t = result.n1t.Unit();
+	result.n2t = n2Star - ((n2Star.Dot(p2)) / (p2.Dot(p2))) * p2;
+	result.n2t = result.n2t.Unit();
+
+	// normalized momentum vector of the reference
+	RMFLV::BetaVector p1n = p1.Unit();
+
+	// calculate phi*cp
+	result.phiStar = acos(result.n2t.Dot(result.n1t));
+	result.oStarCP = p1n.Dot(result.n2t.Cross(result.n1t));
+	if(result.oStarCP>=0)
 	{
-		phiStarCP = acos(n2t.Dot(n1t));
+		result.phiStarCP = result.phiStar;
 	}
 	else
 	{
-		phiStarCP = 2*ROOT::Math::Pi()-acos(n2t.Dot(n1t));
+		result.phiStarCP = 2*ROOT::Math::Pi()-result.phiStar;
 	}
-	return phiStarCP;
+	return result;
 }
 
 
 // calculation of Phi*CP
 // passing the IP vectors as arguments
-double CPQuantities::CalculatePhiStarCP(RMFLV chargPart1, RMFLV chargPart2, TVector3 ipvec1, TVector3 ipvec2){
-
-	// create boost to the ZMF of the two particles
-	RMFLV ProngImp = chargPart1 + chargPart2;
-	RMFLV::BetaVector boostvec = ProngImp.BoostToCM();
-	ROOT::Math::Boost M(boostvec);
-
+CPQuantities::PhiStarCPResult CPQuantities::CalculatePhiStarCP(ZeroMomentumFrame const& zmf, TVector3 const& ipvec1, TVector3 const& ipvec2)
+{
 	// normalize IP vectors
 	RMFLV::BetaVector n1 = (RMFLV::BetaVector)ipvec1;
 	RMFLV::BetaVector n2 = (RMFLV::BetaVector)ipvec2;
-	n1 = n1.Unit();
-	n2 = n2.Unit();
-
-	// boost momenta and IP vectors to the ZMF
-	RMFLV n1_mu, n2_mu;
-	n1_mu.SetPxPyPzE(n1.X(), n1.Y(), n1.Z(), 0);
-	n2_mu.SetPxPyPzE(n2.X(), n2.Y(), n2.Z(), 0);
-	
-	n1_mu = M * n1_mu;
-	n2_mu = M * n2_mu;
-	chargPart1 = M * chargPart1;
-	chargPart2 = M * chargPart2;
-
-	// 3-vectors after boosting
-	RMFLV::BetaVector p1, p2;
-	n1.SetXYZ(n1_mu.Px(), n1_mu.Py(), n1_mu.Pz());
-	n2.SetXYZ(n2_mu.Px(), n2_mu.Py(), n2_mu.Pz());
-	p1.SetXYZ(chargPart1.Px(), chargPart1.Py(), chargPart1.Pz());
-	p2.SetXYZ(chargPart2.Px(), chargPart2.Py(), chargPart2.Pz());
-
-	// get the transverse components of the IP vectors wrt corresponding momenta
-	RMFLV::BetaVector n1t = n1 - ((n1.Dot(p1)) / (p1.Dot(p1))) * p1;
-	n1t = n1t.Unit();
-	RMFLV::BetaVector n2t = n2 - ((n2.Dot(p2)) / (p2.Dot(p2))) * p2;
-	n2t = n2t.Unit();
+	return CalculatePhiStarCPFromIPVectors(zmf, n1.Unit(), n2.Unit());
+}
 
-	// normalized momentum vector of the reference
-	RMFLV::BetaVector p1n = p1.Unit();
-	
-	// calculate phi*cp
-	double phiStarCP = 0;
-	if(p1n.Dot(n2t.Cross(n1t))>=0)
-	{
-		phiStarCP = acos(n2t.Dot(n1t));
-	}
-	else
-	{
-		phiStarCP = 2*ROOT::Math::Pi()-acos(n2t.Dot(n1t));
-	}
-	return phiStarCP;
-	
+double CPQuantities::CalculatePhiStarCP(RMFLV const& chargPart1, RMFLV const& chargPart2, TVector3 const& ipvec1, TVector3 const& ipvec2)
+{
+	return CalculatePhiStarCP(CalculateZeroMomentumFrame(chargPart1, chargPart2), ipvec1, ipvec2).phiStarCP;
 }
 
+
 // calculation of the hadron Energies in the approximate diTau restframe
-double CPQuantities::CalculateChargedHadronEnergy(RMFLV diTauMomentum, RMFLV chargHad)
+double CPQuantities::CalculateChargedHadronEnergy(RMFLV const& diTauMomentum, RMFLV const& chargHad)
 {
 	// Step 1: Creating Boost into diTau rest frame
 	RMFLV::BetaVector boostditau = diTauMomentum.BoostToCM();
 	ROOT::Math::Boost Mditau(boostditau);
 	// Step 2: Boosting hadron and extracting energy
-	chargHad = Mditau * chargHad;
-	return chargHad.E();
+	return (Mditau * chargHad).E();
 }
 
 
 // estimation of the impact parameter error (used on recostruction level)
-double CPQuantities::CalculateTrackReferenceError(KTrack track)
+double CPQuantities::CalculateTrackReferenceError(KTrack const& track)
 {
 	return sqrt(track.errDz*track.errDz+track.errDxy*track.errDxy);
 }
@@ -230,47 +216,40 @@ double CPQuantities::CalculateTrackReferenceError(KTrack track)
 // - using tau- direction in the tautau RF as reference
 // - calculating the normal vectors to the planes
 // - everything is defined in the Higgs boson rest frame
-double CPQuantities::CalculatePhiCP(RMFLV boson, RMFLV tau1, RMFLV tau2, RMFLV chargPart1, RMFLV chargPart2)
+CPQuantities::PhiCPResult CPQuantities::CalculatePhiCP(BosonRestFrame const& frame)
 {
-	// Step 1: Boosts into the boson rest frames to boost charged particles 4-momentums
-	RMFLV::BetaVector boostvech = boson.BoostToCM();
-	ROOT::Math::Boost Mh(boostvech);
-
-	// Step 2: Boosting the 4-momentum vectors to boson rest frame
-	tau1 = Mh * tau1;
-	tau2 = Mh * tau2;
-
-	//std::cout << tau1 << "               " << -1*tau2 << std::endl;
+	PhiCPResult result;
 
-	chargPart1 = Mh * chargPart1;
-	chargPart2 = Mh * chargPart2;
+	// Step 1: Creating 3-momentum normal vectors on decay planes
+	RMFLV::BetaVector km, pm, pp, ez;
+	km.SetXYZ(frame.tau1.Px(),frame.tau1.Py(),frame.tau1.Pz());
+	pm.SetXYZ(frame.chargPart1.Px(),frame.chargPart1.Py(),frame.chargPart1.Pz());
+	pp.SetXYZ(frame.chargPart2.Px(),frame.chargPart2.Py(),frame.chargPart2.Pz());
 
-	// Step 3: Creating 3-momentum normal vectors on decay planes
-	RMFLV::BetaVector km, pm, pp, nm, np, ez;
-	km.SetXYZ(tau1.Px(),tau1.Py(),tau1.Pz());
-	pm.SetXYZ(chargPart1.Px(),chargPart1.Py(),chargPart1.Pz());
-	pp.SetXYZ(chargPart2.Px(),chargPart2.Py(),chargPart2.Pz());
-
-	nm = (km.Cross(pm)).Unit(); np = (km.Cross(pp)).Unit(); ez = km.Unit();
+	result.nm = (km.Cross(pm)).Unit(); result.np = (km.Cross(pp)).Unit(); ez = km.Unit();
 
-	// Step 4: Calculating PhiCP
-	this->SetGenPhi(acos(np.Dot(nm)));
-	this->SetGenOCP(ez.Dot(np.Cross(nm)));
-	double phiCP = 0;
-	if(ez.Dot(np.Cross(nm))>=0)
+	// Step 2: Calculating PhiCP
+	result.phi = acos(result.np.Dot(result.nm));
+	result.oCP = ez.Dot(result.np.Cross(result.nm));
+	if(result.oCP>=0)
 	{
-		phiCP = acos(np.Dot(nm));
+		result.phiCP = result.phi;
 	}
 	else
 	{
-		phiCP = 2*ROOT::Math::Pi()-acos(np.Dot(nm));
+		result.phiCP = 2*ROOT::Math::Pi()-result.phi;
 	}
-	return phiCP;
+	return result;
+}
+
+double CPQuantities::CalculatePhiCP(RMFLV const& boson, RMFLV const& tau1, RMFLV const& tau2, RMFLV const& chargPart1, RMFLV const& chargPart2)
+{
+	return CalculatePhiCP(CalculateBosonRestFrame(boson, tau1, chargPart1, chargPart2)).phiCP;
 }
 
 
 // calculate phicp in the lab frame
-double CPQuantities::CalculatePhiCPLab(RMFLV tau1, RMFLV tau2, RMFLV chargPart1, RMFLV chargPart2)
+double CPQuantities::CalculatePhiCPLab(RMFLV const& tau1, RMFLV const& tau2, RMFLV const& chargPart1, RMFLV const& chargPart2)
 {
 	// creating 3-momentum normal vectors on decay planes
 	RMFLV::BetaVector km, pm, pp, nm, np, ez;
@@ -297,25 +276,26 @@ double CPQuantities::CalculatePhiCPLab(RMFLV tau1, RMFLV tau2, RMFLV chargPart1,
 
 
 // calculation of the charged prong energy in tau restframe
-double CPQuantities::CalculateChargedProngEnergy(RMFLV tau, RMFLV chargedProng)
+double CPQuantities::CalculateChargedProngEnergy(RMFLV const& tau, RMFLV const& chargedProng)
 {
 	// Step 1: Creating boost to Tau restframe
 	RMFLV::BetaVector boosttauvect = tau.BoostToCM();
 	ROOT::Math::Boost TauRestFrame(boosttauvect);
 
 	// Step 2: Boosting charged Prong 4-momentum vector and extracting energy
-	chargedProng = TauRestFrame * chargedProng;
-	return chargedProng.E();
+	return (TauRestFrame * chargedProng).E();
 }
 
 // calculation of the spin analysing discriminant (y^{tau}) using the rest frame of the taus (only gen level)
-double CPQuantities::CalculateSpinAnalysingDiscriminant_rho(RMFLV tau1, RMFLV tau2, RMFLV pionP, RMFLV pionM, RMFLV pi0P, RMFLV pi0M)
+double CPQuantities::CalculateSpinAnalysingDiscriminant_rho(RMFLV const& tau1, RMFLV const& tau2, RMFLV const& pionP, RMFLV const& pionM, RMFLV const& pi0P, RMFLV const& pi0M)
 {
-	// Step 1: Extract all pion energies in the tau restframe
-	double pionP_energy = CalculateChargedProngEnergy(tau1, pionP);
-	double pionM_energy = CalculateChargedProngEnergy(tau2, pionM);
-	double pi0P_energy = CalculateChargedProngEnergy(tau1, pi0P);
-	double pi0M_energy = CalculateChargedProngEnergy(tau2, pi0M);
+	// Step 1: Extract all pion energies in the tau restframes, one boost per tau
+	ROOT::Math::Boost tau1RestFrame(tau1.BoostToCM());
+	ROOT::Math::Boost tau2RestFrame(tau2.BoostToCM());
+	double pionP_energy = (tau1RestFrame * pionP).E();
+	double pionM_energy = (tau2RestFrame * pionM).E();
+	double pi0P_energy = (tau1RestFrame * pi0P).E();
+	double pi0M_energy = (tau2RestFrame * pi0M).E();
 
 	// Step 2: Calculate the y for each pair of pions respectively
 	double ytauP = (pionP_energy - pi0P_energy) / (pionP_energy + pi0P_energy);
@@ -325,25 +305,26 @@ double CPQuantities::CalculateSpinAnalysingDiscriminant_rho(RMFLV tau1, RMFLV ta
 }
 
 // calculation of the spin analysing discriminant (y^{tau}_L) using the laboratory system of the rhos
-double CPQuantities::CalculateSpinAnalysingDiscriminant_rho(RMFLV chargedPion, RMFLV pi0)
+double CPQuantities::CalculateSpinAnalysingDiscriminant_rho(RMFLV const& chargedPion, RMFLV const& pi0)
 {
 	return (chargedPion.E() - pi0.E()) / (chargedPion.E() + pi0.E());
 }
 
 
 // Calculate longitudinal polarization variables (z+, z-, zs)
-double CPQuantities::CalculateZPlusMinus(RMFLV higgs, RMFLV chargedPart)
+std::pair<double, double> CPQuantities::CalculateZPlusMinus(BosonRestFrame const& frame)
+{
+	return std::make_pair(2 * frame.chargPart1.E() / frame.boson.E(), 2 * frame.chargPart2.E() / frame.boson.E());
+}
+
+double CPQuantities::CalculateZPlusMinus(RMFLV const& higgs, RMFLV const& chargedPart)
 {
 	//calculating boost into higgs restframe
 	RMFLV::BetaVector boostHiggs = higgs.BoostToCM();
 	ROOT::Math::Boost higgsRestFrame(boostHiggs);
 
-	//boost particles into rest frame
-	higgs = higgsRestFrame * higgs;
-	chargedPart = higgsRestFrame * chargedPart;
-
-	// calculate Z+-
-	double zPlusMinus = 2 * chargedPart.E() / higgs.E();
+	// calculate Z+- from the particles boosted into the rest frame
+	double zPlusMinus = 2 * (higgsRestFrame * chargedPart).E() / (higgsRestFrame * higgs).E();
 	return zPlusMinus;
 }
 
@@ -377,7 +358,7 @@ double CPQuantities::PhiTransform(double phi)
 
 
 // calculate the gen IP vector
-TVector3 CPQuantities::CalculateIPVector(KGenParticle* genParticle, RMPoint* pv){
+TVector3 CPQuantities::CalculateIPVector(KGenParticle const* genParticle, RMPoint const* pv){
 
 	TVector3 k, p, IP;
 
@@ -401,7 +382,7 @@ TVector3 CPQuantities::CalculateIPVector(KGenParticle* genParticle, RMPoint* pv)
 // calculate the reco IP vector wrt the PV or the refitted PV
 // in case recoParticle is a tau, the track of the lead. PF candidate is consider
 // (see KLepton struct)
-TVector3 CPQuantities::CalculateIPVector(KLepton* recoParticle, KVertex* pv){
+TVector3 CPQuantities::CalculateIPVector(KLepton const* recoParticle, KVertex const* pv){
 
 	TVector3 k, p, IP;
 	k.SetXYZ(recoParticle->track.ref.x() - pv->position.x(), recoParticle->track.ref.y() - pv->position.y(), recoParticle->track.ref.z() - pv->position.z());
@@ -419,7 +400,7 @@ TVector3 CPQuantities::CalculateIPVector(KLepton* recoParticle, KVertex* pv){
 
 // calculate the cosine of the angle psi (alpha in the Berges paper 1408.0798)
 // needed to observe the DY distribution modulation
-double CPQuantities::CalculateCosPsi(RMFLV recoPart, TVector3 ipvec){
+double CPQuantities::CalculateCosPsi(RMFLV const& recoPart, TVector3 const& ipvec){
 	
 	TVector3 ez, p, n;
 	ez.SetXYZ(0,0,1);
@@ -442,7 +423,7 @@ double CPQuantities::CalculateCosPsi(RMFLV recoPart, TVector3 ipvec){
 // The errors on refP of the tracks and on the momenta
 // were estimated by Gaussian fit, and therefore they are hardcoded in here
 // FIXME: Need to find a better solution!
-std::vector<double> CPQuantities::CalculateIPErrors(KLepton* lepton, KVertex* pv, TVector3* ipvec){
+std::vector<double> CPQuantities::CalculateIPErrors(KLepton const* lepton, KVertex const* pv, TVector3 const* ipvec){
 	
 	std::vector<double> IPerrors {-999,-999,-999};
 	double sdxy=0;
@@ -0,0 +1,411 @@
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <TSystem.h>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/CorrectionSnapshot.h"
+
+
+namespace
+{
+	const char SNAPSHOT_MAGIC[8] = {'H', 'T', 'T', 'S', 'N', 'A', 'P', '\0'};
+
+	struct SnapshotHeader
+	{
+		char magic[8];
+		unsigned long long version;
+		unsigned long long nEntries;
+		unsigned long long key;
+	};
+
+	size_t PaddedLength(size_t length)
+	{
+		return ((length + 7) / 8) * 8;
+	}
+}
+
+
+CorrectionSnapshot::CorrectionSnapshot(std::string const& directory, std::string const& tag,
+                                       std::vector<std::string> const& inputFiles,
+                                       std::vector<std::string> const& objectNames) :
+	m_directory(directory)
+{
+	if (m_directory.empty())
+	{
+		return;
+	}
+
+	TString expandedDirectory(m_directory.c_str());
+	gSystem->ExpandPathName(expandedDirectory);
+	m_directory = expandedDirectory.Data();
+
+	std::string keyInfo = tag + "|" + std::to_string(FORMAT_VERSION);
+	m_key = Hash(keyInfo.c_str(), keyInfo.size());
+	for (std::vector<std::string>::const_iterator inputFile = inputFiles.begin(); inputFile != inputFiles.end(); ++inputFile)
+	{
+		TString expandedInputFile(inputFile->c_str());
+		gSystem->ExpandPathName(expandedInputFile);
+		if (! HashFileContent(expandedInputFile.Data(), m_key))
+		{
+			// e.g. remote files, which are then read directly by the producers
+			LOG(DEBUG) << "Could not read " << expandedInputFile.Data() << " to compute the correction snapshot key, snapshot " << tag << " is disabled.";
+			m_directory.clear();
+			return;
+		}
+	}
+	for (std::vector<std::string>::const_iterator objectName = objectNames.begin(); objectName != objectNames.end(); ++objectName)
+	{
+		std::string name = "|" + *objectName;
+		m_key = Hash(name.c_str(), name.size(), m_key);
+	}
+
+	std::ostringstream fileName;
+	fileName << m_directory << "/" << tag << "_" << std::hex << std::setw(16) << std::setfill('0') << m_key << ".snapshot";
+	m_fileName = fileName.str();
+
+	if (Load())
+	{
+		LOG(DEBUG) << "Loaded correction snapshot " << m_fileName << ".";
+	}
+}
+
+CorrectionSnapshot::~CorrectionSnapshot()
+{
+	if (m_mappedData)
+	{
+		munmap(m_mappedData, m_mappedSize);
+	}
+}
+
+unsigned long long CorrectionSnapshot::Hash(char const* data, size_t size, unsigned long long hash)
+{
+	for (size_t index = 0; index < size; ++index)
+	{
+		hash ^= static_cast<unsigned char>(data[index]);
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+bool CorrectionSnapshot::HashFileContent(std::string const& fileName, unsigned long long& hash)
+{
+	std::ifstream file(fileName.c_str(), std::ios::binary);
+	if (! file.is_open())
+	{
+		return false;
+	}
+	std::vector<char> buffer(1 << 16);
+	unsigned long long size = 0;
+	while (file)
+	{
+		file.read(&(buffer[0]), buffer.size());
+		std::streamsize nRead = file.gcount();
+		hash = Hash(&(buffer[0]), nRead, hash);
+		size += nRead;
+	}
+	if (! file.eof())
+	{
+		return false;
+	}
+	std::string fileInfo = "|" + std::to_string(size);
+	hash = Hash(fileInfo.c_str(), fileInfo.size(), hash);
+	return true;
+}
+
+bool CorrectionSnapshot::Load()
+{
+	int fileDescriptor = open(m_fileName.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStatus;
+	if ((fstat(fileDescriptor, &fileStatus) != 0) || (size_t(fileStatus.st_size) < sizeof(SnapshotHeader)))
+	{
+		close(fileDescriptor);
+		return false;
+	}
+	m_mappedSize = fileStatus.st_size;
+	m_mappedData = mmap(nullptr, m_mappedSize, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+	close(fileDescriptor);
+	if (m_mappedData == MAP_FAILED)
+	{
+		m_mappedData = nullptr;
+		return false;
+	}
+
+	char const* data = static_cast<char const*>(m_mappedData);
+	SnapshotHeader const* header = reinterpret_cast<SnapshotHeader const*>(data);
+	bool valid = ((std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0) &&
+	              (header->version == FORMAT_VERSION) && (header->key == m_key));
+
+	size_t position = sizeof(SnapshotHeader);
+	for (unsigned long long entry = 0; valid && (entry < header->nEntries); ++entry)
+	{
+		if (position + sizeof(unsigned long long) > m_mappedSize)
+		{
+			valid = false;
+			break;
+		}
+		unsigned long long nameLength = *reinterpret_cast<unsigned long long const*>(data + position);
+		position += sizeof(unsigned long long);
+		if (position + PaddedLength(nameLength) + 2 * sizeof(unsigned long long) > m_mappedSize)
+		{
+			valid = false;
+			break;
+		}
+		std::string name(data + position, nameLength);
+		position += PaddedLength(nameLength);
+		ArrayView view;
+		view.size = *reinterpret_cast<unsigned long long const*>(data + position);
+		position += sizeof(unsigned long long);
+		unsigned long long offset = *reinterpret_cast<unsigned long long const*>(data + position);
+		position += sizeof(unsigned long long);
+		if (offset + view.size * sizeof(double) > m_mappedSize)
+		{
+			valid = false;
+			break;
+		}
+		view.values = reinterpret_cast<double const*>(data + offset);
+		m_views[name] = view;
+	}
+
+	if (! valid)
+	{
+		LOG(WARNING) << "Correction snapshot " << m_fileName << " is invalid and will be ignored.";
+		munmap(m_mappedData, m_mappedSize);
+		m_mappedData = nullptr;
+		m_mappedSize = 0;
+		m_views.clear();
+	}
+	return valid;
+}
+
+bool CorrectionSnapshot::Has(std::string const& name) const
+{
+	return (m_views.count(name) > 0);
+}
+
+CorrectionSnapshot::ArrayView const& CorrectionSnapshot::GetView(std::string const& name) const
+{
+	std::map<std::string, ArrayView>::const_iterator view = m_views.find(name);
+	if (view == m_views.end())
+	{
+		LOG(FATAL) << "Entry \"" << name << "\" not found in correction snapshot " << m_fileName << "!";
+	}
+	return view->second;
+}
+
+std::vector<double> CorrectionSnapshot::GetArray(std::string const& name) const
+{
+	ArrayView const& view = GetView(name);
+	return std::vector<double>(view.values, view.values + view.size);
+}
+
+double CorrectionSnapshot::GetValue(std::string const& name) const
+{
+	ArrayView const& view = GetView(name);
+	if (view.size != 1)
+	{
+		LOG(FATAL) << "Entry \"" << name << "\" in correction snapshot " << m_fileName << " is not a single value!";
+	}
+	return view.values[0];
+}
+
+CorrectionSnapshot::BinnedLookup CorrectionSnapshot::GetBinnedLookup(std::string const& name) const
+{
+	BinnedLookup lookup;
+	ArrayView const& xEdges = GetView(name + "/xEdges");
+	lookup.m_xEdges = xEdges.values;
+	lookup.m_nXEdges = xEdges.size;
+	if (Has(name + "/yEdges"))
+	{
+		ArrayView const& yEdges = GetView(name + "/yEdges");
+		lookup.m_yEdges = yEdges.values;
+		lookup.m_nYEdges = yEdges.size;
+	}
+	ArrayView const& contents = GetView(name + "/contents");
+	if (contents.size != ((lookup.m_nXEdges + 1) * ((lookup.m_nYEdges > 0) ? (lookup.m_nYEdges + 1) : 1)))
+	{
+		LOG(FATAL) << "Entry \"" << name << "\" in correction snapshot " << m_fileName << " has inconsistent binning and contents!";
+	}
+	lookup.m_contents = contents.values;
+	return lookup;
+}
+
+CorrectionSnapshot::BinnedLookup::BinnedLookup(TH1 const* histogram) :
+	m_ownedData(std::make_shared<std::vector<double> >())
+{
+	int nBinsX = histogram->GetNbinsX();
+	int nBinsY = ((histogram->GetDimension() > 1) ? histogram->GetNbinsY() : 0);
+	std::vector<double>& data = *m_ownedData;
+	for (int xBin = 1; xBin <= nBinsX + 1; ++xBin)
+	{
+		data.push_back(histogram->GetXaxis()->GetBinLowEdge(xBin));
+	}
+	for (int yBin = 1; (nBinsY > 0) && (yBin <= nBinsY + 1); ++yBin)
+	{
+		data.push_back(histogram->GetYaxis()->GetBinLowEdge(yBin));
+	}
+	int nGlobalBins = (nBinsX + 2) * ((nBinsY > 0) ? (nBinsY + 2) : 1);
+	for (int globalBin = 0; globalBin < nGlobalBins; ++globalBin)
+	{
+		data.push_back(histogram->GetBinContent(globalBin));
+	}
+
+	m_nXEdges = nBinsX + 1;
+	m_nYEdges = ((nBinsY > 0) ? (nBinsY + 1) : 0);
+	m_xEdges = &(data[0]);
+	m_yEdges = ((nBinsY > 0) ? (m_xEdges + m_nXEdges) : nullptr);
+	m_contents = m_xEdges + m_nXEdges + m_nYEdges;
+}
+
+size_t CorrectionSnapshot::BinnedLookup::FindBin(double const* edges, size_t nEdges, double value)
+{
+	// 0 is the underflow and nEdges the overflow bin
+	if (value < edges[0])
+	{
+		return 0;
+	}
+	else if (! (value < edges[nEdges - 1]))
+	{
+		return nEdges;
+	}
+	return (std::upper_bound(edges, edges + nEdges, value) - edges);
+}
+
+double CorrectionSnapshot::BinnedLookup::GetBinContent(double x, double y) const
+{
+	assert(m_contents);
+	size_t globalBin = FindBin(m_xEdges, m_nXEdges, x);
+	if (m_nYEdges > 0)
+	{
+		globalBin += FindBin(m_yEdges, m_nYEdges, y) * (m_nXEdges + 1);
+	}
+	return m_contents[globalBin];
+}
+
+void CorrectionSnapshot::AddArray(std::string const& name, std::vector<double> const& values)
+{
+	m_newArrays[name] = values;
+}
+
+void CorrectionSnapshot::AddValue(std::string const& name, double value)
+{
+	m_newArrays[name] = std::vector<double>(1, value);
+}
+
+void CorrectionSnapshot::AddHistogram(std::string const& name, TH1 const* histogram)
+{
+	std::vector<double> xEdges;
+	for (int xBin = 1; xBin <= histogram->GetNbinsX() + 1; ++xBin)
+	{
+		xEdges.push_back(histogram->GetXaxis()->GetBinLowEdge(xBin));
+	}
+	AddArray(name + "/xEdges", xEdges);
+	if (histogram->GetDimension() > 1)
+	{
+		std::vector<double> yEdges;
+		for (int yBin = 1; yBin <= histogram->GetNbinsY() + 1; ++yBin)
+		{
+			yEdges.push_back(histogram->GetYaxis()->GetBinLowEdge(yBin));
+		}
+		AddArray(name + "/yEdges", yEdges);
+	}
+
+	int nGlobalBins = (histogram->GetNbinsX() + 2) * ((histogram->GetDimension() > 1) ? (histogram->GetNbinsY() + 2) : 1);
+	std::vector<double> contents(nGlobalBins, 0.0);
+	for (int globalBin = 0; globalBin < nGlobalBins; ++globalBin)
+	{
+		contents[globalBin] = histogram->GetBinContent(globalBin);
+	}
+	AddArray(name + "/contents", contents);
+}
+
+bool CorrectionSnapshot::Write()
+{
+	if (! IsEnabled())
+	{
+		return false;
+	}
+	gSystem->mkdir(m_directory.c_str(), true);
+
+	// index
+	std::vector<char> index;
+	for (std::map<std::string, std::vector<double> >::const_iterator array = m_newArrays.begin(); array != m_newArrays.end(); ++array)
+	{
+		index.resize(index.size() + 3 * sizeof(unsigned long long) + PaddedLength(array->first.size()), '\0');
+	}
+	size_t offset = sizeof(SnapshotHeader) + index.size();
+	size_t position = 0;
+	for (std::map<std::string, std::vector<double> >::const_iterator array = m_newArrays.begin(); array != m_newArrays.end(); ++array)
+	{
+		unsigned long long nameLength = array->first.size();
+		unsigned long long nValues = array->second.size();
+		unsigned long long dataOffset = offset;
+		std::memcpy(&(index[position]), &nameLength, sizeof(unsigned long long));
+		position += sizeof(unsigned long long);
+		std::memcpy(&(index[position]), array->first.c_str(), nameLength);
+		position += PaddedLength(nameLength);
+		std::memcpy(&(index[position]), &nValues, sizeof(unsigned long long));
+		position += sizeof(unsigned long long);
+		std::memcpy(&(index[position]), &dataOffset, sizeof(unsigned long long));
+		position += sizeof(unsigned long long);
+		offset += nValues * sizeof(double);
+	}
+
+	SnapshotHeader header;
+	std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+	header.version = FORMAT_VERSION;
+	header.nEntries = m_newArrays.size();
+	header.key = m_key;
+
+	// write to a temporary file first, such that concurrent jobs never see incomplete snapshots
+	std::string temporaryFileName = m_fileName + ".tmp" + std::to_string(getpid());
+	{
+		std::ofstream file(temporaryFileName.c_str(), std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<char const*>(&header), sizeof(SnapshotHeader));
+		if (! index.empty())
+		{
+			file.write(&(index[0]), index.size());
+		}
+		for (std::map<std::string, std::vector<double> >::const_iterator array = m_newArrays.begin(); array != m_newArrays.end(); ++array)
+		{
+			if (! array->second.empty())
+			{
+				file.write(reinterpret_cast<char const*>(&(array->second[0])), array->second.size() * sizeof(double));
+			}
+		}
+		if (! file.good())
+		{
+			LOG(WARNING) << "Could not write correction snapshot " << temporaryFileName << ".";
+			std::remove(temporaryFileName.c_str());
+			return false;
+		}
+	}
+	if (std::rename(temporaryFileName.c_str(), m_fileName.c_str()) != 0)
+	{
+		LOG(WARNING) << "Could not move correction snapshot to " << m_fileName << ".";
+		std::remove(temporaryFileName.c_str());
+		return false;
+	}
+	LOG(DEBUG) << "Wrote correction snapshot " << m_fileName << ".";
+	m_newArrays.clear();
+	return true;
+}
+
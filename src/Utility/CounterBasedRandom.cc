@@ -0,0 +1,128 @@
+
+#include <cmath>
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/CounterBasedRandom.h"
+
+
+namespace
+{
+	// finaliser of splitmix64, used to spread the stream inputs over the 64 bit key
+	uint64_t Mix64(uint64_t value)
+	{
+		value += 0x9E3779B97F4A7C15ULL;
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+		return value ^ (value >> 31);
+	}
+
+	inline void MulHiLo(uint32_t a, uint32_t b, uint32_t& hi, uint32_t& lo)
+	{
+		uint64_t product = static_cast<uint64_t>(a) * static_cast<uint64_t>(b);
+		hi = static_cast<uint32_t>(product >> 32);
+		lo = static_cast<uint32_t>(product);
+	}
+}
+
+uint64_t CounterBasedRandom::GetStreamId(std::string const& name)
+{
+	// FNV-1a, stable across platforms and releases (unlike std::hash)
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (unsigned char character : name)
+	{
+		hash ^= character;
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+bool CounterBasedRandom::CheckKnownAnswers()
+{
+	// known-answer tests of the Random123 reference implementation (kat_vectors, philox4x32_10)
+	struct KnownAnswer
+	{
+		std::array<uint32_t, 4> counter;
+		std::array<uint32_t, 2> key;
+		std::array<uint32_t, 4> result;
+	};
+	static KnownAnswer const knownAnswers[] = {
+		{ {{0x00000000, 0x00000000, 0x00000000, 0x00000000}}, {{0x00000000, 0x00000000}}, {{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}} },
+		{ {{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}}, {{0xffffffff, 0xffffffff}}, {{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}} },
+		{ {{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}, {{0xa4093822, 0x299f31d0}}, {{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}} }
+	};
+	for (KnownAnswer const& knownAnswer : knownAnswers)
+	{
+		if (Philox4x32(knownAnswer.counter, knownAnswer.key) != knownAnswer.result)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+CounterBasedRandom::CounterBasedRandom(uint64_t run, uint64_t lumi, uint64_t event, uint64_t streamId, uint64_t objectIndex)
+{
+	// counter: (draw block, run, lumi, lower bits of the event number)
+	// key: stream id, object index and upper bits of the event number
+	m_counter = {{0, static_cast<uint32_t>(run), static_cast<uint32_t>(lumi), static_cast<uint32_t>(event)}};
+	uint64_t key = Mix64(streamId ^ Mix64(objectIndex ^ Mix64(event >> 32)));
+	m_key = {{static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32)}};
+}
+
+CounterBasedRandom::CounterBasedRandom(KEventInfo const* eventInfo, uint64_t streamId, uint64_t objectIndex) :
+	CounterBasedRandom(eventInfo->nRun, eventInfo->nLumi, eventInfo->nEvent, streamId, objectIndex)
+{
+}
+
+std::array<uint32_t, 4> CounterBasedRandom::Philox4x32(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key)
+{
+	for (int round = 0; round < 10; ++round)
+	{
+		uint32_t hi0, lo0, hi1, lo1;
+		MulHiLo(0xD2511F53, counter[0], hi0, lo0);
+		MulHiLo(0xCD9E8D57, counter[2], hi1, lo1);
+		counter = {{hi1 ^ counter[1] ^ key[0], lo1, hi0 ^ counter[3] ^ key[1], lo0}};
+		key[0] += 0x9E3779B9;
+		key[1] += 0xBB67AE85;
+	}
+	return counter;
+}
+
+uint32_t CounterBasedRandom::Next()
+{
+	if (m_blockPosition == m_block.size())
+	{
+		m_block = Philox4x32(m_counter, m_key);
+		++m_counter[0];
+		m_blockPosition = 0;
+	}
+	return m_block[m_blockPosition++];
+}
+
+double CounterBasedRandom::Uniform()
+{
+	// 53 random bits, shifted by half a step to exclude 0 and 1
+	uint64_t high = Next() >> 5;
+	uint64_t low = Next() >> 6;
+	return (static_cast<double>((high << 26) | low) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+double CounterBasedRandom::Uniform(double min, double max)
+{
+	return min + (max - min) * Uniform();
+}
+
+double CounterBasedRandom::Gaus(double mean, double sigma)
+{
+	// Box-Muller, the second value of each pair is kept for the next call
+	if (m_hasCachedGaus)
+	{
+		m_hasCachedGaus = false;
+		return mean + sigma * m_cachedGaus;
+	}
+	double radius = std::sqrt(-2.0 * std::log(Uniform()));
+	double angle = 2.0 * M_PI * Uniform();
+	m_cachedGaus = radius * std::sin(angle);
+	m_hasCachedGaus = true;
+	return mean + sigma * radius * std::cos(angle);
+}
+
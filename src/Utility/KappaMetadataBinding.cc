@@ -0,0 +1,77 @@
+
+#include <algorithm>
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/KappaMetadataBinding.h"
+
+
+size_t KappaMetadataBinding::Register(std::string const& name)
+{
+	std::vector<std::string>::const_iterator registeredName = std::find(m_names.begin(), m_names.end(), name);
+	if (registeredName != m_names.end())
+	{
+		return (registeredName - m_names.begin());
+	}
+	m_names.push_back(name);
+	return (m_names.size() - 1);
+}
+
+bool KappaMetadataBinding::NeedsBinding(void const* metadata, KEventInfo const* eventInfo) const
+{
+	return ((metadata != m_boundMetadata) ||
+	        (eventInfo->nRun != m_boundRun) ||
+	        (eventInfo->nLumi != m_boundLumi) ||
+	        (m_names.size() != m_nBoundNames));
+}
+
+void KappaMetadataBinding::SetBound(void const* metadata, KEventInfo const* eventInfo) const
+{
+	m_boundMetadata = metadata;
+	m_boundRun = eventInfo->nRun;
+	m_boundLumi = eventInfo->nLumi;
+	m_nBoundNames = m_names.size();
+}
+
+int KappaMetadataBinding::FindPosition(std::vector<std::string> const& names, std::string const& name)
+{
+	std::vector<std::string>::const_iterator position = std::find(names.begin(), names.end(), name);
+	return ((position != names.end()) ? (position - names.begin()) : -1);
+}
+
+
+void TauDiscriminatorBinding::Bind(KTauMetadata const* metadata, KEventInfo const* eventInfo) const
+{
+	// same precedence as in KTau::getDiscriminator: float discriminators before binary ones
+	m_floatIndices.resize(m_names.size());
+	m_binaryBits.resize(m_names.size());
+	for (size_t handle = 0; handle < m_names.size(); ++handle)
+	{
+		m_floatIndices[handle] = FindPosition(metadata->floatDiscriminatorNames, m_names[handle]);
+		m_binaryBits[handle] = FindPosition(metadata->binaryDiscriminatorNames, m_names[handle]);
+		if (m_binaryBits[handle] >= 64)
+		{
+			m_binaryBits[handle] = -1;
+		}
+	}
+	SetBound(metadata, eventInfo);
+}
+
+void ElectronIdBinding::Bind(KElectronMetadata const* metadata, KEventInfo const* eventInfo) const
+{
+	m_indices.resize(m_names.size());
+	for (size_t handle = 0; handle < m_names.size(); ++handle)
+	{
+		m_indices[handle] = FindPosition(metadata->idNames, m_names[handle]);
+	}
+	SetBound(metadata, eventInfo);
+}
+
+void JetTagBinding::Bind(KJetMetadata const* metadata, KEventInfo const* eventInfo) const
+{
+	m_indices.resize(m_names.size());
+	for (size_t handle = 0; handle < m_names.size(); ++handle)
+	{
+		m_indices[handle] = FindPosition(metadata->tagNames, m_names[handle]);
+	}
+	SetBound(metadata, eventInfo);
+}
+
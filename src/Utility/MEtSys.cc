@@ -1,6 +1,37 @@
 #include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/MEtSys.h"
-
-MEtSys::MEtSys(TString fileName) {
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/CorrectionSnapshot.h"
+
+#include <algorithm>
+
+MEtSys::MEtSys(TString fileName, TString snapshotDirectory) {
+
+  // lookup data extracted from a previous job with identical inputs
+  CorrectionSnapshot snapshot(snapshotDirectory.Data(), "MEtSys",
+                              std::vector<std::string>(1, fileName.Data()),
+                              std::vector<std::string>());
+  if (snapshot.IsLoaded()) {
+    nBkgdTypes = int(snapshot.GetValue("nBkgdTypes"));
+    nJetBins = int(snapshot.GetValue("nJetBins"));
+    std::vector<double> sysUncValues = snapshot.GetArray("sysUnc");
+    for (int i=0; i<nBkgdTypes; ++i) {
+      for (int xBin=0; xBin<2; ++xBin) {
+	for (int yBin=0; yBin<3; ++yBin) {
+	  sysUnc[i][xBin][yBin] = sysUncValues[(i*2+xBin)*3+yBin];
+	}
+      }
+    }
+    // the response tables are stored as they are used, no histograms need to be rebuilt
+    responseBinCenters.resize(nBkgdTypes*nJetBins);
+    responseValues.resize(nBkgdTypes*nJetBins);
+    for (int i=0; i<nBkgdTypes; ++i) {
+      for (int j=0; j<nJetBins; ++j) {
+	std::string suffix = "_"+std::to_string(i)+"_"+std::to_string(j);
+	responseBinCenters[i*nJetBins+j] = snapshot.GetArray("responseBinCenters"+suffix);
+	responseValues[i*nJetBins+j] = snapshot.GetArray("responseValues"+suffix);
+      }
+    }
+    return;
+  }
 
   TDirectory *savedir(gDirectory);
   TFile *savefile(gFile);
@@ -55,75 +86,146 @@ MEtSys::MEtSys(TString fileName) {
 
   }
 
+  responseBinCenters.resize(nBkgdTypes*nJetBins);
+  responseValues.resize(nBkgdTypes*nJetBins);
   for (int i=0; i<nBkgdTypes; ++i) {
     for (int j=0; j<nJetBins; ++j) {
       TString histName = Bkgd[i]+"_"+JetBins[j];
 //       std::cout << histName << std::endl;
-      responseHist[i][j] = (TH1D*)file->Get(histName);
-      if (responseHist[i][j]==NULL) {
+      TH1D * hist = (TH1D*)file->Get(histName);
+      if (hist==NULL) {
 	std::cout << "Histogram " << histName << " should be contained in file " << fileName << std::endl;
 	std::cout << "Check content of the file " << fileName << std::endl;
 	exit(-1);
       }
-
+      SetResponseTable(i, j, hist);
+      if (snapshot.IsEnabled()) {
+	std::string suffix = "_"+std::to_string(i)+"_"+std::to_string(j);
+	snapshot.AddArray("responseBinCenters"+suffix, responseBinCenters[i*nJetBins+j]);
+	snapshot.AddArray("responseValues"+suffix, responseValues[i*nJetBins+j]);
+      }
     }
   }
   
+  if (snapshot.IsEnabled()) {
+    snapshot.AddValue("nBkgdTypes", nBkgdTypes);
+    snapshot.AddValue("nJetBins", nJetBins);
+    std::vector<double> sysUncValues;
+    for (int i=0; i<nBkgdTypes; ++i) {
+      for (int xBin=0; xBin<2; ++xBin) {
+	for (int yBin=0; yBin<3; ++yBin) {
+	  sysUncValues.push_back(sysUnc[i][xBin][yBin]);
+	}
+      }
+    }
+    snapshot.AddArray("sysUnc", sysUncValues);
+    snapshot.Write();
+  }
+  
+  // the histograms are not needed anymore after the conversion into flat arrays
+  file->Close();
+  delete file;
+  
   gDirectory = savedir;
   gFile = savefile;
 }
 
+void MEtSys::SetResponseTable(int bkgdType, int jetBin, TH1D const* hist) {
+
+  std::vector<double> & binCenters = responseBinCenters[bkgdType*nJetBins+jetBin];
+  std::vector<double> & values = responseValues[bkgdType*nJetBins+jetBin];
+  binCenters.resize(hist->GetNbinsX());
+  values.resize(hist->GetNbinsX());
+  for (int xBin=1; xBin<=hist->GetNbinsX(); ++xBin) {
+    binCenters[xBin-1] = hist->GetXaxis()->GetBinCenter(xBin);
+    values[xBin-1] = hist->GetBinContent(xBin);
+  }
+
+}
+
+double MEtSys::InterpolateResponse(int bkgdType, int jetBin, double genVPt) const {
+
+  // same as TH1::Interpolate: linear between the bin centers, constant beyond the outer bin centers
+  std::vector<double> const& binCenters = responseBinCenters[bkgdType*nJetBins+jetBin];
+  std::vector<double> const& values = responseValues[bkgdType*nJetBins+jetBin];
+  if (genVPt <= binCenters.front()) return values.front();
+  if (genVPt >= binCenters.back()) return values.back();
+
+  size_t upper = std::upper_bound(binCenters.begin(), binCenters.end(), genVPt) - binCenters.begin();
+  size_t lower = upper-1;
+  return values[lower] + (genVPt-binCenters[lower])*((values[upper]-values[lower])/(binCenters[upper]-binCenters[lower]));
+
+}
+
+MEtSys::RecoilAxes MEtSys::ComputeRecoilAxes(float genVPx,
+					     float genVPy) const {
+
+  RecoilAxes axes;
+  float genVPt = TMath::Sqrt(genVPx*genVPx+genVPy*genVPy);
+  axes.unitX = genVPx/genVPt;
+  axes.unitY = genVPy/genVPt;
+
+  float unitPhi = TMath::ATan2(axes.unitY,axes.unitX);
+  axes.unitPerpX = TMath::Cos(unitPhi+0.5*TMath::Pi());
+  axes.unitPerpY = TMath::Sin(unitPhi+0.5*TMath::Pi());
+  return axes;
+
+}
+
 void MEtSys::ComputeHadRecoilFromMet(float metX,
 				     float metY,
-				     float genVPx, 
-				     float genVPy,
+				     RecoilAxes const& axes,
 				     float visVPx,
 				     float visVPy,
 				     float & Hparal,
-				     float & Hperp) {
-
-  float genVPt = TMath::Sqrt(genVPx*genVPx+genVPy*genVPy);
-  float unitX = genVPx/genVPt;
-  float unitY = genVPy/genVPt;
-
-  float unitPhi = TMath::ATan2(unitY,unitX);
-  float unitPerpX = TMath::Cos(unitPhi+0.5*TMath::Pi());
-  float unitPerpY = TMath::Sin(unitPhi+0.5*TMath::Pi());
+				     float & Hperp) const {
 
   float Hx = -metX - visVPx;
   float Hy = -metY - visVPy;
 
-  Hparal = Hx*unitX + Hy*unitY;
-  Hperp = Hx*unitPerpX + Hy*unitPerpY;
+  Hparal = Hx*axes.unitX + Hy*axes.unitY;
+  Hperp = Hx*axes.unitPerpX + Hy*axes.unitPerpY;
 
 }
 
 void MEtSys::ComputeMetFromHadRecoil(float Hparal,
 				     float Hperp,
-				     float genVPx, 
-				     float genVPy,
+				     RecoilAxes const& axes,
 				     float visVPx,
 				     float visVPy,
 				     float & metX,
-				     float & metY) {
+				     float & metY) const {
 
-  float genVPt = TMath::Sqrt(genVPx*genVPx+genVPy*genVPy);
-  float unitX = genVPx/genVPt;
-  float unitY = genVPy/genVPt;
-
-  float unitPhi = TMath::ATan2(unitY,unitX);
-  float unitPerpX = TMath::Cos(unitPhi+0.5*TMath::Pi());
-  float unitPerpY = TMath::Sin(unitPhi+0.5*TMath::Pi());
-
-  float det = unitX*unitPerpY - unitY*unitPerpX;
-  float Hx = (Hparal*unitPerpY - Hperp*unitY)/det;
-  float Hy = (Hperp*unitX - Hparal*unitPerpX)/det;
+  float det = axes.unitX*axes.unitPerpY - axes.unitY*axes.unitPerpX;
+  float Hx = (Hparal*axes.unitPerpY - Hperp*axes.unitY)/det;
+  float Hy = (Hperp*axes.unitX - Hparal*axes.unitPerpX)/det;
 
   metX = -Hx - visVPx;
   metY = -Hy - visVPy;
 
 }
 
+int MEtSys::CheckInputs(int njets, int bkgdType, std::string const& caller) const {
+
+  int jets = njets; 
+  if (jets>2) jets = 2; 
+  if (jets<0) {
+    std::cout << "MEtSys::" << caller << "() : Number of jets is negative !" << std::endl;
+    exit(-1);
+  }
+
+  if (bkgdType<0||bkgdType>=nBkgdTypes) { 
+    std::cout << "MEtSys::" << caller << "() : Background type " << bkgdType << " does not correspond to any of allowed options : " << std::endl;
+    std::cout << "0 : Z(W)+Jets" << std::endl;
+    std::cout << "1 : EWK+single-top" << std::endl;
+    std::cout << "2 : top pair" << std::endl;   
+    exit(-1);
+  }
+
+  return jets;
+
+}
+
 void MEtSys::ShiftResponseMet(float metPx,
 			      float metPy,
 			      float genVPx, 
@@ -136,8 +238,6 @@ void MEtSys::ShiftResponseMet(float metPx,
 			      float & metShiftPx,
 			      float & metShiftPy) {
 
-  float Hparal = 0;
-  float Hperp = 0;
   float genVPt = TMath::Sqrt(genVPx*genVPx+genVPy*genVPy);
 
   // protection against null
@@ -147,28 +247,18 @@ void MEtSys::ShiftResponseMet(float metPx,
     return;
   }
 
-  ComputeHadRecoilFromMet(metPx,metPy,genVPx,genVPy,visVPx,visVPy,Hparal,Hperp);
+  int jets = CheckInputs(njets, bkgdType, "ShiftResponseMet");
 
-  int jets = njets; 
-  if (jets>2) jets = 2; 
-  if (jets<0) {
-    std::cout << "MEtSys::ShiftResponseMet() : Number of jets is negative !" << std::endl;
-    exit(-1);
-  }
-
-  if (bkgdType<0||bkgdType>=nBkgdTypes) { 
-    std::cout << "MEtSys::ShiftResponseMet() : Background type " << bkgdType << " does not correspond to any of allowed options : " << std::endl;
-    std::cout << "0 : Z(W)+Jets" << std::endl;
-    std::cout << "1 : EWK+single-top" << std::endl;
-    std::cout << "2 : top pair" << std::endl;   
-    exit(-1);
-  }
+  float Hparal = 0;
+  float Hperp = 0;
+  RecoilAxes axes = ComputeRecoilAxes(genVPx,genVPy);
+  ComputeHadRecoilFromMet(metPx,metPy,axes,visVPx,visVPy,Hparal,Hperp);
 
-  float mean = -responseHist[bkgdType][jets]->Interpolate(genVPt)*genVPt;
+  float mean = -InterpolateResponse(bkgdType,jets,genVPt)*genVPt;
   float shift = sysShift*mean;
   Hparal = Hparal + (shift-mean);
 
-  ComputeMetFromHadRecoil(Hparal,Hperp,genVPx,genVPy,visVPx,visVPy,metShiftPx,metShiftPy);
+  ComputeMetFromHadRecoil(Hparal,Hperp,axes,visVPx,visVPy,metShiftPx,metShiftPy);
 
 }
 
@@ -183,10 +273,7 @@ void MEtSys::ShiftResolutionMet(float metPx,
 				float sysShift,
 				float & metShiftPx,
 				float & metShiftPy) {
- 
 
-  float Hparal = 0;
-  float Hperp = 0;
   float genVPt = TMath::Sqrt(genVPx*genVPx+genVPy*genVPy);
 
   // protection against null
@@ -196,29 +283,18 @@ void MEtSys::ShiftResolutionMet(float metPx,
     return;
   }
 
-  ComputeHadRecoilFromMet(metPx,metPy,genVPx,genVPy,visVPx,visVPy,Hparal,Hperp);
+  int jets = CheckInputs(njets, bkgdType, "ShiftResolutionMet");
 
-  int jets = njets; 
-  if (jets>2) jets = 2; 
-  if (jets<0) {
-    std::cout << "MEtSys::ShiftResponseMet() : Number of jets is negative !" << std::endl;
-    exit(-1);
-  }
-
-  if (bkgdType<0||bkgdType>=nBkgdTypes) { 
-    std::cout << "MEtSys::ShiftResponseMet() : Background type " << bkgdType << " does not correspond to any of allowed options : " << std::endl;
-    std::cout << "0 : Z(W)+Jets" << std::endl;
-    std::cout << "1 : EWK+single-top" << std::endl;
-    std::cout << "2 : top pair" << std::endl;   
-    exit(-1);
-  }
+  float Hparal = 0;
+  float Hperp = 0;
+  RecoilAxes axes = ComputeRecoilAxes(genVPx,genVPy);
+  ComputeHadRecoilFromMet(metPx,metPy,axes,visVPx,visVPy,Hparal,Hperp);
 
-  float mean = -responseHist[bkgdType][jets]->Interpolate(genVPt)*genVPt;
+  float mean = -InterpolateResponse(bkgdType,jets,genVPt)*genVPt;
   Hperp = sysShift*Hperp;
   Hparal = mean + (Hparal-mean)*sysShift;
 
-  ComputeMetFromHadRecoil(Hparal,Hperp,genVPx,genVPy,visVPx,visVPy,metShiftPx,metShiftPy);
-
+  ComputeMetFromHadRecoil(Hparal,Hperp,axes,visVPx,visVPy,metShiftPx,metShiftPy);
 
 }
 
@@ -278,24 +354,8 @@ void MEtSys::ApplyMEtSys(float metPx,
 			 int sysShift,
 			 float & metShiftPx,
 			 float & metShiftPy) {
- 
-
 
-
-  if (bkgdType<0||bkgdType>=nBkgdTypes) {
-    std::cout << "MEtSys::ShiftResponseMet() : Background type " << bkgdType << " does not correspond to any of allowed options : " << std::endl;
-    std::cout << "0 : Z(W)+Jets" << std::endl;
-    std::cout << "1 : EWK+single-top" << std::endl;
-    std::cout << "2 : top pair" << std::endl;
-    exit(-1);
-  }
-
-  int jets = njets; 
-  if (jets>2) jets = 2; 
-  if (jets<0) {
-    std::cout << "MEtSys::ApplyMEtSys() : Number of jets is negative !" << std::endl;
-    exit(-1);
-  }
+  int jets = CheckInputs(njets, bkgdType, "ApplyMEtSys");
 
   int type = 0; if (sysType!=0) type = 1;
 
@@ -315,5 +375,52 @@ void MEtSys::ApplyMEtSys(float metPx,
 	   metShiftPx,
 	   metShiftPy);
 
-			
+}
+
+void MEtSys::ApplyAllMEtSys(float metPx,
+			    float metPy,
+			    float genVPx,
+			    float genVPy,
+			    float visVPx,
+			    float visVPy,
+			    int njets,
+			    int bkgdType,
+			    float metShiftPx[2][2],
+			    float metShiftPy[2][2]) const {
+
+  int jets = CheckInputs(njets, bkgdType, "ApplyAllMEtSys");
+
+  float genVPt = TMath::Sqrt(genVPx*genVPx+genVPy*genVPy);
+
+  // protection against null
+  if (genVPt<1.0) {
+    for (int type=0; type<2; ++type) {
+      for (int shift=0; shift<2; ++shift) {
+	metShiftPx[type][shift] = metPx;
+	metShiftPy[type][shift] = metPy;
+      }
+    }
+    return;
+  }
+
+  // projection onto the boson axis and response shared by all variants
+  float Hparal = 0;
+  float Hperp = 0;
+  RecoilAxes axes = ComputeRecoilAxes(genVPx,genVPy);
+  ComputeHadRecoilFromMet(metPx,metPy,axes,visVPx,visVPy,Hparal,Hperp);
+  float mean = -InterpolateResponse(bkgdType,jets,genVPt)*genVPt;
+
+  for (int shift=0; shift<2; ++shift) {
+    float responseScale = (shift==Up) ? 1 + sysUnc[bkgdType][Response][jets] : 1 - sysUnc[bkgdType][Response][jets];
+    float responseHparal = Hparal + (responseScale*mean-mean);
+    ComputeMetFromHadRecoil(responseHparal,Hperp,axes,visVPx,visVPy,
+			    metShiftPx[Response][shift],metShiftPy[Response][shift]);
+
+    float resolutionScale = (shift==Up) ? 1 + sysUnc[bkgdType][Resolution][jets] : 1 - sysUnc[bkgdType][Resolution][jets];
+    float resolutionHperp = resolutionScale*Hperp;
+    float resolutionHparal = mean + (Hparal-mean)*resolutionScale;
+    ComputeMetFromHadRecoil(resolutionHparal,resolutionHperp,axes,visVPx,visVPy,
+			    metShiftPx[Resolution][shift],metShiftPy[Resolution][shift]);
+  }
+
 }
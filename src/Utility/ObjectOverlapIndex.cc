@@ -0,0 +1,114 @@
+
+#include <algorithm>
+#include <cmath>
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/ObjectOverlapIndex.h"
+
+
+void ObjectOverlapIndex::Clear()
+{
+	m_references.clear();
+	m_identities.clear();
+	m_sorted = true;
+}
+
+void ObjectOverlapIndex::Add(RMFLV const& p4, void const* identity)
+{
+	Reference reference;
+	reference.eta = p4.Eta();
+	reference.phi = p4.Phi();
+	reference.p4 = p4;
+	m_references.push_back(reference);
+	AddIdentity(identity);
+	m_sorted = false;
+}
+
+void ObjectOverlapIndex::AddIdentity(void const* identity)
+{
+	if (identity != nullptr)
+	{
+		m_identities.push_back(identity);
+		m_sorted = false;
+	}
+}
+
+void ObjectOverlapIndex::Sort() const
+{
+	std::sort(m_references.begin(), m_references.end(), [](Reference const& reference1, Reference const& reference2) {
+		return (reference1.eta < reference2.eta);
+	});
+	std::sort(m_identities.begin(), m_identities.end());
+	m_sorted = true;
+}
+
+bool ObjectOverlapIndex::Overlaps(RMFLV const& p4, float maxDeltaR) const
+{
+	if ((maxDeltaR < 0.0) || m_references.empty())
+	{
+		return false;
+	}
+	if (! m_sorted)
+	{
+		Sort();
+	}
+
+	float eta = p4.Eta();
+	float phi = p4.Phi();
+	double maxDeltaRSquared = double(maxDeltaR) * double(maxDeltaR);
+
+	// only references with |deltaEta| <= maxDeltaR can overlap
+	std::vector<Reference>::const_iterator reference = std::lower_bound(
+			m_references.begin(), m_references.end(), eta - maxDeltaR,
+			[](Reference const& reference, float minEta) { return (reference.eta < minEta); }
+	);
+	for (; (reference != m_references.end()) && (reference->eta <= eta + maxDeltaR); ++reference)
+	{
+		double deltaEta = reference->eta - eta;
+		double deltaPhi = reference->phi - phi;
+		if (deltaPhi > M_PI)
+		{
+			deltaPhi -= 2.0 * M_PI;
+		}
+		else if (deltaPhi <= -M_PI)
+		{
+			deltaPhi += 2.0 * M_PI;
+		}
+		if ((deltaEta * deltaEta) + (deltaPhi * deltaPhi) <= maxDeltaRSquared)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ObjectOverlapIndex::IsIdentical(RMFLV const& p4, void const* identity) const
+{
+	if (m_references.empty() && m_identities.empty())
+	{
+		return false;
+	}
+	if (! m_sorted)
+	{
+		Sort();
+	}
+
+	if ((identity != nullptr) && std::binary_search(m_identities.begin(), m_identities.end(), identity))
+	{
+		return true;
+	}
+
+	float eta = p4.Eta();
+	std::vector<Reference>::const_iterator reference = std::lower_bound(
+			m_references.begin(), m_references.end(), eta,
+			[](Reference const& reference, float minEta) { return (reference.eta < minEta); }
+	);
+	for (; (reference != m_references.end()) && (reference->eta == eta); ++reference)
+	{
+		if (reference->p4 == p4)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
@@ -0,0 +1,108 @@
+
+#include <boost/algorithm/string.hpp>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/RooFunctorSet.h"
+
+
+RooFunctorSet::ArgumentRole RooFunctorSet::ToArgumentRole(std::string const& argumentName)
+{
+	if ((argumentName == "m_pt") || (argumentName == "e_pt") || (argumentName == "t_pt")) return ArgumentRole::LEPTON_PT;
+	else if ((argumentName == "m_eta") || (argumentName == "t_eta")) return ArgumentRole::LEPTON_ETA;
+	else if (argumentName == "e_eta") return ArgumentRole::ELECTRON_SUPERCLUSTER_ETA;
+	else if ((argumentName == "m_iso") || (argumentName == "e_iso")) return ArgumentRole::LEPTON_ISOLATION_OVER_PT;
+	else if (argumentName == "t_dm") return ArgumentRole::TAU_DECAY_MODE;
+	else if (argumentName == "z_gen_mass") return ArgumentRole::GEN_BOSON_MASS;
+	else if (argumentName == "z_gen_pt") return ArgumentRole::GEN_BOSON_PT;
+	return ArgumentRole::NONE;
+}
+
+void RooFunctorSet::Init(RooWorkspace* workspace, std::vector<std::string> const& functionNames, std::string const& argumentNames)
+{
+	m_functionNames = functionNames;
+	m_functors.clear();
+	m_roles.clear();
+
+	std::vector<std::string> arguments;
+	boost::algorithm::split(arguments, argumentNames, boost::algorithm::is_any_of(","));
+	for (std::string& argument : arguments)
+	{
+		boost::algorithm::trim(argument);
+		m_roles.push_back(ToArgumentRole(argument));
+		if (m_roles.back() == ArgumentRole::NONE)
+		{
+			LOG(WARNING) << "RooFunctorSet: unknown role of the argument \"" << argument << "\", it will always be set to 0!";
+		}
+	}
+	m_arguments.assign(m_roles.size(), 0.0);
+
+	for (std::string const& functionName : m_functionNames)
+	{
+		RooAbsReal* function = workspace->function(functionName.c_str());
+		if (function == nullptr)
+		{
+			LOG(FATAL) << "RooFunctorSet: function \"" << functionName << "\" not found in the workspace!";
+		}
+		m_functors.emplace_back(function->functor(workspace->argSet(argumentNames.c_str())));
+	}
+}
+
+bool RooFunctorSet::HasArgument(ArgumentRole role) const
+{
+	for (ArgumentRole argumentRole : m_roles)
+	{
+		if (argumentRole == role)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void RooFunctorSet::SetArgument(ArgumentRole role, double value) const
+{
+	for (size_t index = 0; index < m_roles.size(); ++index)
+	{
+		if (m_roles[index] == role)
+		{
+			m_arguments[index] = value;
+		}
+	}
+}
+
+void RooFunctorSet::SetLeptonArguments(KLepton const* lepton, double isolationOverPt) const
+{
+	for (size_t index = 0; index < m_roles.size(); ++index)
+	{
+		switch (m_roles[index])
+		{
+			case ArgumentRole::LEPTON_PT:
+				m_arguments[index] = lepton->p4.Pt();
+				break;
+			case ArgumentRole::LEPTON_ETA:
+				m_arguments[index] = lepton->p4.Eta();
+				break;
+			case ArgumentRole::ELECTRON_SUPERCLUSTER_ETA:
+				m_arguments[index] = static_cast<KElectron const*>(lepton)->superclusterPosition.Eta();
+				break;
+			case ArgumentRole::LEPTON_ISOLATION_OVER_PT:
+				m_arguments[index] = isolationOverPt;
+				break;
+			case ArgumentRole::TAU_DECAY_MODE:
+				m_arguments[index] = static_cast<KTau const*>(lepton)->decayMode;
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+void RooFunctorSet::EvalMany(double* results) const
+{
+	for (size_t function = 0; function < m_functors.size(); ++function)
+	{
+		results[function] = m_functors[function]->eval(m_arguments.data());
+	}
+}
+
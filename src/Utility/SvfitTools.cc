@@ -7,15 +7,42 @@
 
 #include "Kappa/DataFormats/interface/Hash.h"
 
+#include <algorithm>
+#include <cmath>
+#include <tuple>
 
-TauSVfitQuantity::TauSVfitQuantity(size_t tauIndex) :	
+#include "boost/functional/hash.hpp"
+
+
+TauSVfitQuantity::TauSVfitQuantity(size_t tauIndex, std::string const& quantityLabel) :	
 	classic_svFit::SVfitQuantity(),
 	m_tauIndex(tauIndex),
-	m_tauLabel("Tau"+std::to_string(tauIndex+1))
+	m_histogramName("SVfitAlgorithm_histogramTau"+std::to_string(tauIndex+1)+quantityLabel)
+{
+}
+
+void TauSVfitQuantity::ReleaseHistogram()
 {
+	m_releasedHistogram.reset(histogram_);
+	histogram_ = nullptr;
+}
+
+TH1* TauSVfitQuantity::GetResetHistogram(double xMin, double xMax) const
+{
+	if (m_releasedHistogram && (xMin == m_histogramXMin) && (xMax == m_histogramXMax))
+	{
+		m_releasedHistogram->Reset();
+		// the sums of squared weights are created again by SVfitQuantity::bookHistogram
+		m_releasedHistogram->Sumw2(false);
+		return m_releasedHistogram.release();
+	}
+	m_releasedHistogram.reset();
+	m_histogramXMin = xMin;
+	m_histogramXMax = xMax;
+	return nullptr;
 }
 
-TauESVfitQuantity::TauESVfitQuantity(size_t tauIndex) : TauSVfitQuantity(tauIndex)
+TauESVfitQuantity::TauESVfitQuantity(size_t tauIndex) : TauSVfitQuantity(tauIndex, "E")
 {
 }
 TH1* TauESVfitQuantity::createHistogram(const classic_svFit::LorentzVector& vis1P4, const classic_svFit::LorentzVector& vis2P4, classic_svFit::Vector const& measuredMET) const
@@ -23,7 +50,8 @@ TH1* TauESVfitQuantity::createHistogram(const classic_svFit::LorentzVector& vis1
 	double E;
 	if (m_tauIndex == 0) E = vis1P4.E();
 	else E = vis2P4.E();
-	return classic_svFit::HistogramTools::makeHistogram(std::string("SVfitAlgorithm_histogram"+m_tauLabel+"E").c_str(), E/1.025, TMath::Max(1.e+3, 1.e+1*E/1.025), 1.025);
+	TH1* histogram = GetResetHistogram(E/1.025, TMath::Max(1.e+3, 1.e+1*E/1.025));
+	return (histogram ? histogram : classic_svFit::HistogramTools::makeHistogram(m_histogramName.c_str(), E/1.025, TMath::Max(1.e+3, 1.e+1*E/1.025), 1.025));
 }
 double TauESVfitQuantity::fitFunction(const classic_svFit::LorentzVector& tau1P4, const classic_svFit::LorentzVector& tau2P4, const classic_svFit::LorentzVector& vis1P4, const classic_svFit::LorentzVector& vis2P4, classic_svFit::Vector const& measuredMET) const
 {
@@ -31,12 +59,13 @@ double TauESVfitQuantity::fitFunction(const classic_svFit::LorentzVector& tau1P4
 	else return tau2P4.E();
 }
 
-TauERatioSVfitQuantity::TauERatioSVfitQuantity(size_t tauIndex) : TauSVfitQuantity(tauIndex)
+TauERatioSVfitQuantity::TauERatioSVfitQuantity(size_t tauIndex) : TauSVfitQuantity(tauIndex, "ERatio")
 {
 }
 TH1* TauERatioSVfitQuantity::createHistogram(const classic_svFit::LorentzVector& vis1P4, const classic_svFit::LorentzVector& vis2P4, classic_svFit::Vector const& measuredMET) const
 {
-	return new TH1D(std::string("SVfitAlgorithm_histogram"+m_tauLabel+"ERatio").c_str(), std::string("SVfitAlgorithm_histogram"+m_tauLabel+"ERatio").c_str(), 200, 0.0, 1.0);
+	TH1* histogram = GetResetHistogram(0.0, 1.0);
+	return (histogram ? histogram : new TH1D(m_histogramName.c_str(), m_histogramName.c_str(), 200, 0.0, 1.0));
 }
 double TauERatioSVfitQuantity::fitFunction(const classic_svFit::LorentzVector& tau1P4, const classic_svFit::LorentzVector& tau2P4, const classic_svFit::LorentzVector& vis1P4, const classic_svFit::LorentzVector& vis2P4, classic_svFit::Vector const& measuredMET) const
 {
@@ -44,12 +73,13 @@ double TauERatioSVfitQuantity::fitFunction(const classic_svFit::LorentzVector& t
 	else return vis2P4.E() / tau2P4.E();
 }
 
-TauPtSVfitQuantity::TauPtSVfitQuantity(size_t tauIndex) : TauSVfitQuantity(tauIndex)
+TauPtSVfitQuantity::TauPtSVfitQuantity(size_t tauIndex) : TauSVfitQuantity(tauIndex, "Pt")
 {
 }
 TH1* TauPtSVfitQuantity::createHistogram(const classic_svFit::LorentzVector& vis1P4, const classic_svFit::LorentzVector& vis2P4, classic_svFit::Vector const& measuredMET) const
 {
-	return classic_svFit::HistogramTools::makeHistogram(std::string("SVfitAlgorithm_histogram"+m_tauLabel+"Pt").c_str(), 1., 1.e+3, 1.025);
+	TH1* histogram = GetResetHistogram(1., 1.e+3);
+	return (histogram ? histogram : classic_svFit::HistogramTools::makeHistogram(m_histogramName.c_str(), 1., 1.e+3, 1.025));
 }
 double TauPtSVfitQuantity::fitFunction(const classic_svFit::LorentzVector& tau1P4, const classic_svFit::LorentzVector& tau2P4, const classic_svFit::LorentzVector& vis1P4, const classic_svFit::LorentzVector& vis2P4, classic_svFit::Vector const& measuredMET) const
 {
@@ -57,12 +87,13 @@ double TauPtSVfitQuantity::fitFunction(const classic_svFit::LorentzVector& tau1P
 	else return tau2P4.pt();
 }
 
-TauEtaSVfitQuantity::TauEtaSVfitQuantity(size_t tauIndex) : TauSVfitQuantity(tauIndex)
+TauEtaSVfitQuantity::TauEtaSVfitQuantity(size_t tauIndex) : TauSVfitQuantity(tauIndex, "Eta")
 {
 }
 TH1* TauEtaSVfitQuantity::createHistogram(const classic_svFit::LorentzVector& vis1P4, const classic_svFit::LorentzVector& vis2P4, classic_svFit::Vector const& measuredMET) const
 {
-	return new TH1D(std::string("SVfitAlgorithm_histogram"+m_tauLabel+"Eta").c_str(), std::string("SVfitAlgorithm_histogram"+m_tauLabel+"Eta").c_str(), 198, -9.9, +9.9);
+	TH1* histogram = GetResetHistogram(-9.9, +9.9);
+	return (histogram ? histogram : new TH1D(m_histogramName.c_str(), m_histogramName.c_str(), 198, -9.9, +9.9));
 }
 double TauEtaSVfitQuantity::fitFunction(const classic_svFit::LorentzVector& tau1P4, const classic_svFit::LorentzVector& tau2P4, const classic_svFit::LorentzVector& vis1P4, const classic_svFit::LorentzVector& vis2P4, classic_svFit::Vector const& measuredMET) const
 {
@@ -70,12 +101,13 @@ double TauEtaSVfitQuantity::fitFunction(const classic_svFit::LorentzVector& tau1
 	else return tau2P4.eta();
 }
 
-TauPhiSVfitQuantity::TauPhiSVfitQuantity(size_t tauIndex) : TauSVfitQuantity(tauIndex)
+TauPhiSVfitQuantity::TauPhiSVfitQuantity(size_t tauIndex) : TauSVfitQuantity(tauIndex, "Phi")
 {
 }
 TH1* TauPhiSVfitQuantity::createHistogram(const classic_svFit::LorentzVector& vis1P4, const classic_svFit::LorentzVector& vis2P4, classic_svFit::Vector const& measuredMET) const
 {
-	return new TH1D(std::string("SVfitAlgorithm_histogram"+m_tauLabel+"Phi").c_str(), std::string("SVfitAlgorithm_histogram"+m_tauLabel+"Phi").c_str(), 180, -TMath::Pi(), +TMath::Pi());
+	TH1* histogram = GetResetHistogram(-TMath::Pi(), +TMath::Pi());
+	return (histogram ? histogram : new TH1D(m_histogramName.c_str(), m_histogramName.c_str(), 180, -TMath::Pi(), +TMath::Pi()));
 }
 double TauPhiSVfitQuantity::fitFunction(const classic_svFit::LorentzVector& tau1P4, const classic_svFit::LorentzVector& tau2P4, const classic_svFit::LorentzVector& vis1P4, const classic_svFit::LorentzVector& vis2P4, classic_svFit::Vector const& measuredMET) const
 {
@@ -95,6 +127,18 @@ MCTauTauQuantitiesAdapter::MCTauTauQuantitiesAdapter() : classic_svFit::DiTauSys
 	quantities_.push_back(new TauPhiSVfitQuantity(1));
 }
 
+void MCTauTauQuantitiesAdapter::ReleaseHistograms()
+{
+	for (classic_svFit::SVfitQuantity* quantity : quantities_)
+	{
+		TauSVfitQuantity* tauQuantity = dynamic_cast<TauSVfitQuantity*>(quantity);
+		if (tauQuantity)
+		{
+			tauQuantity->ReleaseHistogram();
+		}
+	}
+}
+
 RMFLV MCTauTauQuantitiesAdapter::GetFittedHiggsLV() const
 {
 	RMFLV momentum;
@@ -168,40 +212,6 @@ SvfitEventKey::IntegrationMethod SvfitEventKey::GetIntegrationMethod() const
 	return Utility::ToEnum<IntegrationMethod>(integrationMethod);
 }
 
-void SvfitEventKey::CreateBranches(TTree* tree)
-{
-	tree->Branch("runLumiEvent", &runLumiEvent, "runLumiEvent/l");
-	tree->Branch("decayType1", &decayType1);
-	tree->Branch("decayType2", &decayType2);
-	tree->Branch("systematicShift", &systematicShift);
-	tree->Branch("systematicShiftSigma", &systematicShiftSigma);
-	tree->Branch("integrationMethod", &integrationMethod);
-	tree->Branch("hash", &hash, "hash/l");
-}
-
-void SvfitEventKey::SetBranchAddresses(TTree* tree)
-{
-	tree->SetBranchAddress("runLumiEvent", &runLumiEvent);
-	tree->SetBranchAddress("decayType1", &decayType1);
-	tree->SetBranchAddress("decayType2", &decayType2);
-	tree->SetBranchAddress("systematicShift", &systematicShift);
-	tree->SetBranchAddress("systematicShiftSigma", &systematicShiftSigma);
-	tree->SetBranchAddress("integrationMethod", &integrationMethod);
-	tree->SetBranchAddress("hash", &hash);
-	ActivateBranches(tree, true);
-}
-
-void SvfitEventKey::ActivateBranches(TTree* tree, bool activate)
-{
-	tree->SetBranchStatus("runLumiEvent", activate);
-	tree->SetBranchStatus("decayType1", activate);
-	tree->SetBranchStatus("decayType2", activate);
-	tree->SetBranchStatus("systematicShift", activate);
-	tree->SetBranchStatus("systematicShiftSigma", activate);
-	tree->SetBranchStatus("integrationMethod", activate);
-	tree->SetBranchStatus("hash", activate);
-}
-
 bool SvfitEventKey::operator<(SvfitEventKey const& rhs) const
 {
 	if (runLumiEvent == rhs.runLumiEvent)
@@ -289,94 +299,24 @@ SvfitInputs::SvfitInputs(RMFLV const& leptonMomentum1, RMFLV const& leptonMoment
 	Set(leptonMomentum1, leptonMomentum2, metMomentum, metCovariance, decayMode1, decayMode2);
 }
 
-SvfitInputs::~SvfitInputs()
-{
-	/* TODO: freeing memory here creates segmentation faults
-	if (leptonMomentum1)
-	{
-		delete leptonMomentum1;
-	}
-	if (leptonMomentum2)
-	{
-		delete leptonMomentum2;
-	}
-	if (metMomentum)
-	{
-		delete metMomentum;
-	}
-	if (metCovariance)
-	{
-		delete metCovariance;
-	}
-	*/
-}
-
 void SvfitInputs::Set(RMFLV const& leptonMomentum1, RMFLV const& leptonMomentum2,
                       RMDataV const& metMomentum, RMSM2x2 const& metCovariance,
                       int const& decayMode1, int const& decayMode2)
 {
-	if (! this->leptonMomentum1)
-	{
-		this->leptonMomentum1 = new RMFLV();
-	}
-	if (! this->leptonMomentum2)
-	{
-		this->leptonMomentum2 = new RMFLV();
-	}
-	if (! this->metMomentum)
-	{
-		this->metMomentum = new RMDataV();
-	}
-	if (! this->metCovariance)
-	{
-		this->metCovariance = new RMSM2x2();
-	}
-	
-	*(this->leptonMomentum1) = leptonMomentum1;
-	*(this->leptonMomentum2) = leptonMomentum2;
-	*(this->metMomentum) = metMomentum;
-	*(this->metCovariance) = metCovariance;
+	this->leptonMomentum1 = leptonMomentum1;
+	this->leptonMomentum2 = leptonMomentum2;
+	this->metMomentum = metMomentum;
+	this->metCovariance = metCovariance;
 	this->decayMode1 = decayMode1;
 	this->decayMode2 = decayMode2;
 }
 
-void SvfitInputs::CreateBranches(TTree* tree)
-{
-	tree->Branch("leptonMomentum1", "RMFLV", &leptonMomentum1);
-	tree->Branch("leptonMomentum2", "RMFLV", &leptonMomentum2);
-	tree->Branch("metMomentum", "ROOT::Math::DisplacementVector3D<ROOT::Math::Cartesian3D<float>,ROOT::Math::DefaultCoordinateSystemTag>", &metMomentum);
-	tree->Branch("metCovariance", "ROOT::Math::SMatrix<double, 2, 2, ROOT::Math::MatRepSym<double, 2> >", &metCovariance);
-	tree->Branch("decayMode1", &decayMode1);
-	tree->Branch("decayMode2", &decayMode2);
-}
-
-void SvfitInputs::SetBranchAddresses(TTree* tree)
-{
-	tree->SetBranchAddress("leptonMomentum1", &leptonMomentum1);
-	tree->SetBranchAddress("leptonMomentum2", &leptonMomentum2);
-	tree->SetBranchAddress("metMomentum", &metMomentum);
-	tree->SetBranchAddress("metCovariance", &metCovariance);
-	tree->SetBranchAddress("decayMode1", &decayMode1);
-	tree->SetBranchAddress("decayMode2", &decayMode2);
-	ActivateBranches(tree, true);
-}
-
-void SvfitInputs::ActivateBranches(TTree* tree, bool activate)
-{
-	tree->SetBranchStatus("leptonMomentum1", activate);
-	tree->SetBranchStatus("leptonMomentum2", activate);
-	tree->SetBranchStatus("metMomentum", activate);
-	tree->SetBranchStatus("metCovariance", activate);
-	tree->SetBranchStatus("decayMode1", activate);
-	tree->SetBranchStatus("decayMode2", activate);
-}
-
 bool SvfitInputs::operator==(SvfitInputs const& rhs) const
 {
-	return (Utility::ApproxEqual(*leptonMomentum1, *(rhs.leptonMomentum1)) &&
-	        Utility::ApproxEqual(*leptonMomentum2, *(rhs.leptonMomentum2)) &&
-	        Utility::ApproxEqual(*metMomentum, *(rhs.metMomentum)) &&
-	        Utility::ApproxEqual(*metCovariance, *(rhs.metCovariance)) &&
+	return (Utility::ApproxEqual(leptonMomentum1, rhs.leptonMomentum1) &&
+	        Utility::ApproxEqual(leptonMomentum2, rhs.leptonMomentum2) &&
+	        Utility::ApproxEqual(metMomentum, rhs.metMomentum) &&
+	        Utility::ApproxEqual(metCovariance, rhs.metCovariance) &&
 	        (decayMode1 == rhs.decayMode1) &&
 	        (decayMode2 == rhs.decayMode2));
 }
@@ -386,13 +326,29 @@ bool SvfitInputs::operator!=(SvfitInputs const& rhs) const
 	return (! (*this == rhs));
 }
 
-ClassicSVfit SvfitInputs::GetSvfitAlgorithm(int verbosity, SvfitEventKey const& svfitEventKey, bool addLogM) const
+ULong64_t SvfitInputs::GetHash() const
+{
+	size_t hash = 0;
+	for (RMFLV const* leptonMomentum : {&leptonMomentum1, &leptonMomentum2})
+	{
+		boost::hash_combine(hash, leptonMomentum->Pt());
+		boost::hash_combine(hash, leptonMomentum->Eta());
+		boost::hash_combine(hash, leptonMomentum->Phi());
+		boost::hash_combine(hash, leptonMomentum->M());
+	}
+	boost::hash_combine(hash, metMomentum.x());
+	boost::hash_combine(hash, metMomentum.y());
+	boost::hash_combine(hash, metMomentum.z());
+	boost::hash_combine(hash, metCovariance.At(0, 0));
+	boost::hash_combine(hash, metCovariance.At(0, 1));
+	boost::hash_combine(hash, metCovariance.At(1, 1));
+	boost::hash_combine(hash, decayMode1);
+	boost::hash_combine(hash, decayMode2);
+	return hash;
+}
+
+void SvfitInputs::ConfigureSvfitAlgorithm(ClassicSVfit& svfitAlgorithm, SvfitEventKey const& svfitEventKey, bool addLogM) const
 {
-	ClassicSVfit svfitAlgorithm = ClassicSVfit(verbosity);
-	
-	svfitAlgorithm.setHistogramAdapter(new MCTauTauQuantitiesAdapter());
-	
-	
 	double kappa = 3.;
 	if (svfitEventKey.decayType1==1) kappa += 1.;
 	if (svfitEventKey.decayType2==1) kappa += 1.;
@@ -407,8 +363,6 @@ ClassicSVfit SvfitInputs::GetSvfitAlgorithm(int verbosity, SvfitEventKey const&
 		gFile = savefile;
 	}
 	svfitAlgorithm.shiftVisPt(true, visPtResolutionFile);*/
-	
-	return svfitAlgorithm;
 }
 
 std::vector<classic_svFit::MeasuredTauLepton> SvfitInputs::GetMeasuredTauLeptons(SvfitEventKey const& svfitEventKey) const
@@ -424,7 +378,7 @@ std::vector<classic_svFit::MeasuredTauLepton> SvfitInputs::GetMeasuredTauLeptons
 	}
 	else
 	{
-		leptonMass1 = leptonMomentum1->M();
+		leptonMass1 = leptonMomentum1.M();
 	}
 	if(svfitEventKey.decayType2 == 2)
 	{
@@ -436,11 +390,11 @@ std::vector<classic_svFit::MeasuredTauLepton> SvfitInputs::GetMeasuredTauLeptons
 	}
 	else
 	{
-		leptonMass2 = leptonMomentum2->M();
+		leptonMass2 = leptonMomentum2.M();
 	}
 	std::vector<classic_svFit::MeasuredTauLepton> measuredTauLeptons {
-		classic_svFit::MeasuredTauLepton(Utility::ToEnum<classic_svFit::MeasuredTauLepton::kDecayType>(svfitEventKey.decayType1), leptonMomentum1->pt(), leptonMomentum1->eta(), leptonMomentum1->phi(), leptonMass1, decayMode1),
-		classic_svFit::MeasuredTauLepton(Utility::ToEnum<classic_svFit::MeasuredTauLepton::kDecayType>(svfitEventKey.decayType2), leptonMomentum2->pt(), leptonMomentum2->eta(), leptonMomentum2->phi(), leptonMass2, decayMode2)
+		classic_svFit::MeasuredTauLepton(Utility::ToEnum<classic_svFit::MeasuredTauLepton::kDecayType>(svfitEventKey.decayType1), leptonMomentum1.pt(), leptonMomentum1.eta(), leptonMomentum1.phi(), leptonMass1, decayMode1),
+		classic_svFit::MeasuredTauLepton(Utility::ToEnum<classic_svFit::MeasuredTauLepton::kDecayType>(svfitEventKey.decayType2), leptonMomentum2.pt(), leptonMomentum2.eta(), leptonMomentum2.phi(), leptonMass2, decayMode2)
 	};
 	return measuredTauLeptons;
 }
@@ -448,13 +402,28 @@ std::vector<classic_svFit::MeasuredTauLepton> SvfitInputs::GetMeasuredTauLeptons
 TMatrixD SvfitInputs::GetMetCovarianceMatrix() const
 {
 	TMatrixD metCovarianceMatrix(2, 2);
-	metCovarianceMatrix[0][0] = metCovariance->At(0, 0);
-	metCovarianceMatrix[1][0] = metCovariance->At(1, 0);
-	metCovarianceMatrix[0][1] = metCovariance->At(0, 1);
-	metCovarianceMatrix[1][1] = metCovariance->At(1, 1);
+	metCovarianceMatrix[0][0] = metCovariance.At(0, 0);
+	metCovarianceMatrix[1][0] = metCovariance.At(1, 0);
+	metCovarianceMatrix[0][1] = metCovariance.At(0, 1);
+	metCovarianceMatrix[1][1] = metCovariance.At(1, 1);
 	return metCovarianceMatrix;
 }
 
+SvfitContentKey::SvfitContentKey(SvfitEventKey const& svfitEventKey, SvfitInputs const& svfitInputs) :
+	runLumiEvent(svfitEventKey.runLumiEvent),
+	decayType1(svfitEventKey.decayType1),
+	decayType2(svfitEventKey.decayType2),
+	integrationMethod(svfitEventKey.integrationMethod),
+	inputsHash(svfitInputs.GetHash())
+{
+}
+
+bool SvfitContentKey::operator<(SvfitContentKey const& rhs) const
+{
+	return (std::tie(runLumiEvent, inputsHash, decayType1, decayType2, integrationMethod) <
+	        std::tie(rhs.runLumiEvent, rhs.inputsHash, rhs.decayType1, rhs.decayType2, rhs.integrationMethod));
+}
+
 SvfitResults::SvfitResults(double fittedTransverseMass, RMFLV const& fittedHiggsLV, float fittedTau1ERatio, RMFLV const& fittedTau1LV, float fittedTau2ERatio, RMFLV const& fittedTau2LV) :
 	SvfitResults()
 {
@@ -468,45 +437,15 @@ SvfitResults::SvfitResults(ClassicSVfit const& svfitAlgorithm) :
 	Set(svfitAlgorithm);
 }
 
-SvfitResults::~SvfitResults()
-{
-	/* TODO: freeing memory here creates segmentation faults
-	if (fittedHiggsLV)
-	{
-		delete fittedHiggsLV;
-	}
-	if (fittedTau1LV)
-	{
-		delete fittedTau1LV;
-	}
-	if (fittedTau2LV)
-	{
-		delete fittedTau2LV;
-	}
-	*/
-}
-
 void SvfitResults::Set(double fittedTransverseMass, RMFLV const& fittedHiggsLV, float fittedTau1ERatio, RMFLV const& fittedTau1LV, float fittedTau2ERatio, RMFLV const& fittedTau2LV)
 {
-	if (! this->fittedHiggsLV)
-	{
-		this->fittedHiggsLV = new RMFLV();
-	}
-	if (! this->fittedTau1LV)
-	{
-		this->fittedTau1LV = new RMFLV();
-	}
-	if (! this->fittedTau2LV)
-	{
-		this->fittedTau2LV = new RMFLV();
-	}
-	
 	this->fittedTransverseMass = fittedTransverseMass;
-	*(this->fittedHiggsLV) = fittedHiggsLV;
+	this->fittedHiggsLV = fittedHiggsLV;
 	this->fittedTau1ERatio = fittedTau1ERatio;
-	*(this->fittedTau1LV) = fittedTau1LV;
+	this->fittedTau1LV = fittedTau1LV;
 	this->fittedTau2ERatio = fittedTau2ERatio;
-	*(this->fittedTau2LV) = fittedTau2LV;
+	this->fittedTau2LV = fittedTau2LV;
+	this->available = true;
 }
 
 void SvfitResults::Set(ClassicSVfit const& svfitAlgorithm)
@@ -531,45 +470,97 @@ void SvfitResults::Set(ClassicSVfit const& svfitAlgorithm)
 	}
 }
 
-void SvfitResults::CreateBranches(TTree* tree)
-{
-	tree->Branch("svfitTransverseMass", &fittedTransverseMass, "svfitTransverseMass/D");
-	tree->Branch("svfitHiggsLV", &fittedHiggsLV);
-	tree->Branch("svfitTau1ERatio", &fittedTau1ERatio, "svfitTau1ERatio/F");
-	tree->Branch("svfitTau1LV", &fittedTau1LV);
-	tree->Branch("svfitTau2ERatio", &fittedTau2ERatio, "svfitTau2ERatio/F");
-	tree->Branch("svfitTau2LV", &fittedTau2LV);
-}
-
-void SvfitResults::SetBranchAddresses(TTree* tree)
-{
-	tree->SetBranchAddress("svfitTransverseMass", &fittedTransverseMass);
-	tree->SetBranchAddress("svfitHiggsLV", &fittedHiggsLV);
-	tree->SetBranchAddress("svfitTau1ERatio", &fittedTau1ERatio);
-	tree->SetBranchAddress("svfitTau1LV", &fittedTau1LV);
-	tree->SetBranchAddress("svfitTau2ERatio", &fittedTau2ERatio);
-	tree->SetBranchAddress("svfitTau2LV", &fittedTau2LV);
-	ActivateBranches(tree, true);
-}
-
-void SvfitResults::ActivateBranches(TTree* tree, bool activate)
-{
-	tree->SetBranchStatus("svfitTransverseMass", activate);
-	tree->SetBranchStatus("svfitHiggsLV", activate);
-	tree->SetBranchStatus("svfitTau1ERatio", activate);
-	tree->SetBranchStatus("svfitTau1LV", activate);
-	tree->SetBranchStatus("svfitTau2ERatio", activate);
-	tree->SetBranchStatus("svfitTau2LV", activate);
+void SvfitResults::SetCollinearEstimate(SvfitInputs const& svfitInputs)
+{
+	// The neutrinos are assumed to be collinear with the visible decay products, p(tau) = (1 + a) * p(vis) with a = 1/x - 1 >= 0.
+	// The fractions are obtained by maximising the MET likelihood, which means minimising
+	// chi2 = r^T C^-1 r with r = MET - a1 * pT(vis1) - a2 * pT(vis2) under the constraints a1, a2 >= 0.
+	double vis1X = svfitInputs.leptonMomentum1.Px();
+	double vis1Y = svfitInputs.leptonMomentum1.Py();
+	double vis2X = svfitInputs.leptonMomentum2.Px();
+	double vis2Y = svfitInputs.leptonMomentum2.Py();
+	double metX = svfitInputs.metMomentum.x();
+	double metY = svfitInputs.metMomentum.y();
+	
+	// inverse of the MET covariance matrix, unit weights for singular matrices
+	double covariance00 = svfitInputs.metCovariance.At(0, 0);
+	double covariance01 = svfitInputs.metCovariance.At(0, 1);
+	double covariance11 = svfitInputs.metCovariance.At(1, 1);
+	double determinant = (covariance00 * covariance11) - (covariance01 * covariance01);
+	double weight00 = 1.0;
+	double weight01 = 0.0;
+	double weight11 = 1.0;
+	if (determinant > 0.0)
+	{
+		weight00 = covariance11 / determinant;
+		weight01 = -covariance01 / determinant;
+		weight11 = covariance00 / determinant;
+	}
+	auto scalarProduct = [&](double x1, double y1, double x2, double y2) {
+		return (x1 * weight00 * x2) + (((x1 * y2) + (y1 * x2)) * weight01) + (y1 * weight11 * y2);
+	};
+	auto chi2 = [&](double a1, double a2) {
+		double residualX = metX - (a1 * vis1X) - (a2 * vis2X);
+		double residualY = metY - (a1 * vis1Y) - (a2 * vis2Y);
+		return scalarProduct(residualX, residualY, residualX, residualY);
+	};
+	
+	double h11 = scalarProduct(vis1X, vis1Y, vis1X, vis1Y);
+	double h12 = scalarProduct(vis1X, vis1Y, vis2X, vis2Y);
+	double h22 = scalarProduct(vis2X, vis2Y, vis2X, vis2Y);
+	double g1 = scalarProduct(vis1X, vis1Y, metX, metY);
+	double g2 = scalarProduct(vis2X, vis2Y, metX, metY);
+	
+	// minimum with only one of the fractions free (includes a1 = a2 = 0)
+	double a1 = ((h11 > 0.0) ? std::max(0.0, g1 / h11) : 0.0);
+	double a2 = 0.0;
+	double minChi2 = chi2(a1, a2);
+	double a2Only = ((h22 > 0.0) ? std::max(0.0, g2 / h22) : 0.0);
+	if (chi2(0.0, a2Only) < minChi2)
+	{
+		a1 = 0.0;
+		a2 = a2Only;
+		minChi2 = chi2(a1, a2);
+	}
+	
+	// unconstrained minimum, if it fulfills the constraints it is the global one
+	double hessianDeterminant = (h11 * h22) - (h12 * h12);
+	if (hessianDeterminant > 0.0)
+	{
+		double a1Free = ((h22 * g1) - (h12 * g2)) / hessianDeterminant;
+		double a2Free = ((h11 * g2) - (h12 * g1)) / hessianDeterminant;
+		if ((a1Free >= 0.0) && (a2Free >= 0.0) && (chi2(a1Free, a2Free) <= minChi2))
+		{
+			a1 = a1Free;
+			a2 = a2Free;
+		}
+	}
+	
+	RMFLV fittedTau1LV(svfitInputs.leptonMomentum1.Pt() * (1.0 + a1), svfitInputs.leptonMomentum1.Eta(), svfitInputs.leptonMomentum1.Phi(), classic_svFit::tauLeptonMass);
+	RMFLV fittedTau2LV(svfitInputs.leptonMomentum2.Pt() * (1.0 + a2), svfitInputs.leptonMomentum2.Eta(), svfitInputs.leptonMomentum2.Phi(), classic_svFit::tauLeptonMass);
+	RMFLV fittedHiggsLV = fittedTau1LV + fittedTau2LV;
+	
+	// same definition as in ClassicSVfit
+	double transverseEnergy1 = std::sqrt((fittedTau1LV.Pt() * fittedTau1LV.Pt()) + (fittedTau1LV.M() * fittedTau1LV.M()));
+	double transverseEnergy2 = std::sqrt((fittedTau2LV.Pt() * fittedTau2LV.Pt()) + (fittedTau2LV.M() * fittedTau2LV.M()));
+	double fittedTransverseMass = std::sqrt(std::max(0.0, ((transverseEnergy1 + transverseEnergy2) * (transverseEnergy1 + transverseEnergy2)) - fittedHiggsLV.Perp2()));
+	
+	Set(fittedTransverseMass,
+	    fittedHiggsLV,
+	    svfitInputs.leptonMomentum1.E() / fittedTau1LV.E(),
+	    fittedTau1LV,
+	    svfitInputs.leptonMomentum2.E() / fittedTau2LV.E(),
+	    fittedTau2LV);
 }
 
 bool SvfitResults::operator==(SvfitResults const& rhs) const
 {
 	return (Utility::ApproxEqual(fittedTransverseMass, rhs.fittedTransverseMass) &&
-	        Utility::ApproxEqual(*fittedHiggsLV, *(rhs.fittedHiggsLV)) &&
+	        Utility::ApproxEqual(fittedHiggsLV, rhs.fittedHiggsLV) &&
 	        Utility::ApproxEqual(fittedTau1ERatio, rhs.fittedTau1ERatio) &&
-	        Utility::ApproxEqual(*fittedTau1LV, *(rhs.fittedTau1LV)) &&
+	        Utility::ApproxEqual(fittedTau1LV, rhs.fittedTau1LV) &&
 	        Utility::ApproxEqual(fittedTau2ERatio, rhs.fittedTau2ERatio) &&
-	        Utility::ApproxEqual(*fittedTau2LV, *(rhs.fittedTau2LV)));
+	        Utility::ApproxEqual(fittedTau2LV, rhs.fittedTau2LV));
 }
 
 bool SvfitResults::operator!=(SvfitResults const& rhs) const
@@ -603,9 +594,142 @@ RMFLV SvfitResults::GetFittedTau2LV(ClassicSVfit const& svfitAlgorithm) const
 }
 
 
+SvfitCacheBranches::SvfitCacheBranches() :
+	leptonMomentum1(&svfitInputs.leptonMomentum1),
+	leptonMomentum2(&svfitInputs.leptonMomentum2),
+	metMomentum(&svfitInputs.metMomentum),
+	metCovariance(&svfitInputs.metCovariance),
+	fittedHiggsLV(&svfitResults.fittedHiggsLV),
+	fittedTau1LV(&svfitResults.fittedTau1LV),
+	fittedTau2LV(&svfitResults.fittedTau2LV)
+{
+}
+
+void SvfitCacheBranches::Set(SvfitEventKey const& svfitEventKey, SvfitInputs const& svfitInputs, SvfitResults const& svfitResults)
+{
+	this->svfitEventKey = svfitEventKey;
+	this->svfitInputs = svfitInputs;
+	this->svfitResults = svfitResults;
+}
+
+void SvfitCacheBranches::CreateBranches(TTree* tree, bool withInputs)
+{
+	tree->Branch("runLumiEvent", &svfitEventKey.runLumiEvent, "runLumiEvent/l");
+	tree->Branch("decayType1", &svfitEventKey.decayType1);
+	tree->Branch("decayType2", &svfitEventKey.decayType2);
+	tree->Branch("systematicShift", &svfitEventKey.systematicShift);
+	tree->Branch("systematicShiftSigma", &svfitEventKey.systematicShiftSigma);
+	tree->Branch("integrationMethod", &svfitEventKey.integrationMethod);
+	tree->Branch("hash", &svfitEventKey.hash, "hash/l");
+	
+	if (withInputs)
+	{
+		tree->Branch("leptonMomentum1", "RMFLV", &leptonMomentum1);
+		tree->Branch("leptonMomentum2", "RMFLV", &leptonMomentum2);
+		tree->Branch("metMomentum", "ROOT::Math::DisplacementVector3D<ROOT::Math::Cartesian3D<float>,ROOT::Math::DefaultCoordinateSystemTag>", &metMomentum);
+		tree->Branch("metCovariance", "ROOT::Math::SMatrix<double, 2, 2, ROOT::Math::MatRepSym<double, 2> >", &metCovariance);
+		tree->Branch("decayMode1", &svfitInputs.decayMode1);
+		tree->Branch("decayMode2", &svfitInputs.decayMode2);
+	}
+	
+	tree->Branch("svfitTransverseMass", &svfitResults.fittedTransverseMass, "svfitTransverseMass/D");
+	tree->Branch("svfitHiggsLV", &fittedHiggsLV);
+	tree->Branch("svfitTau1ERatio", &svfitResults.fittedTau1ERatio, "svfitTau1ERatio/F");
+	tree->Branch("svfitTau1LV", &fittedTau1LV);
+	tree->Branch("svfitTau2ERatio", &svfitResults.fittedTau2ERatio, "svfitTau2ERatio/F");
+	tree->Branch("svfitTau2LV", &fittedTau2LV);
+}
+
+void SvfitCacheBranches::SetBranchAddresses(TTree* tree)
+{
+	tree->SetBranchAddress("runLumiEvent", &svfitEventKey.runLumiEvent);
+	tree->SetBranchAddress("decayType1", &svfitEventKey.decayType1);
+	tree->SetBranchAddress("decayType2", &svfitEventKey.decayType2);
+	tree->SetBranchAddress("systematicShift", &svfitEventKey.systematicShift);
+	tree->SetBranchAddress("systematicShiftSigma", &svfitEventKey.systematicShiftSigma);
+	tree->SetBranchAddress("integrationMethod", &svfitEventKey.integrationMethod);
+	tree->SetBranchAddress("hash", &svfitEventKey.hash);
+	ActivateEventKeyBranches(tree, true);
+	
+	if (tree->GetBranch("leptonMomentum1"))
+	{
+		tree->SetBranchAddress("leptonMomentum1", &leptonMomentum1);
+		tree->SetBranchAddress("leptonMomentum2", &leptonMomentum2);
+		tree->SetBranchAddress("metMomentum", &metMomentum);
+		tree->SetBranchAddress("metCovariance", &metCovariance);
+		tree->SetBranchAddress("decayMode1", &svfitInputs.decayMode1);
+		tree->SetBranchAddress("decayMode2", &svfitInputs.decayMode2);
+		ActivateInputsBranches(tree, true);
+	}
+	
+	tree->SetBranchAddress("svfitTransverseMass", &svfitResults.fittedTransverseMass);
+	tree->SetBranchAddress("svfitHiggsLV", &fittedHiggsLV);
+	tree->SetBranchAddress("svfitTau1ERatio", &svfitResults.fittedTau1ERatio);
+	tree->SetBranchAddress("svfitTau1LV", &fittedTau1LV);
+	tree->SetBranchAddress("svfitTau2ERatio", &svfitResults.fittedTau2ERatio);
+	tree->SetBranchAddress("svfitTau2LV", &fittedTau2LV);
+	ActivateResultsBranches(tree, true);
+}
+
+void SvfitCacheBranches::SetResultsBranchAddresses(TTree* tree)
+{
+	tree->SetBranchStatus("*", false);
+	tree->SetBranchAddress("svfitTransverseMass", &svfitResults.fittedTransverseMass);
+	tree->SetBranchAddress("svfitHiggsLV", &fittedHiggsLV);
+	tree->SetBranchAddress("svfitTau1ERatio", &svfitResults.fittedTau1ERatio);
+	tree->SetBranchAddress("svfitTau1LV", &fittedTau1LV);
+	tree->SetBranchAddress("svfitTau2ERatio", &svfitResults.fittedTau2ERatio);
+	tree->SetBranchAddress("svfitTau2LV", &fittedTau2LV);
+	ActivateResultsBranches(tree, true);
+}
+
+void SvfitCacheBranches::ActivateEventKeyBranches(TTree* tree, bool activate)
+{
+	tree->SetBranchStatus("runLumiEvent", activate);
+	tree->SetBranchStatus("decayType1", activate);
+	tree->SetBranchStatus("decayType2", activate);
+	tree->SetBranchStatus("systematicShift", activate);
+	tree->SetBranchStatus("systematicShiftSigma", activate);
+	tree->SetBranchStatus("integrationMethod", activate);
+	tree->SetBranchStatus("hash", activate);
+}
+
+void SvfitCacheBranches::ActivateInputsBranches(TTree* tree, bool activate)
+{
+	tree->SetBranchStatus("leptonMomentum1", activate);
+	tree->SetBranchStatus("leptonMomentum2", activate);
+	tree->SetBranchStatus("metMomentum", activate);
+	tree->SetBranchStatus("metCovariance", activate);
+	tree->SetBranchStatus("decayMode1", activate);
+	tree->SetBranchStatus("decayMode2", activate);
+}
+
+void SvfitCacheBranches::ActivateResultsBranches(TTree* tree, bool activate)
+{
+	tree->SetBranchStatus("svfitTransverseMass", activate);
+	tree->SetBranchStatus("svfitHiggsLV", activate);
+	tree->SetBranchStatus("svfitTau1ERatio", activate);
+	tree->SetBranchStatus("svfitTau1LV", activate);
+	tree->SetBranchStatus("svfitTau2ERatio", activate);
+	tree->SetBranchStatus("svfitTau2LV", activate);
+}
+
+
 std::map<std::string, TFile*> SvfitTools::svfitCacheInputFiles;
 std::map<std::string, TTree*> SvfitTools::svfitCacheInputTrees;
 std::map<std::string, std::map<SvfitEventKey, uint64_t>> SvfitTools::svfitCacheInputTreeIndices;
+std::map<SvfitContentKey, std::pair<TTree*, uint64_t>> SvfitTools::svfitCacheInputContentIndices;
+std::map<TTree*, SvfitCacheBranches*> SvfitTools::svfitCacheInputTreeBranchAddresses;
+std::set<TTree*> SvfitTools::svfitCacheInputUnindexedTrees;
+size_t SvfitTools::inJobCacheCapacity = 0;
+std::list<SvfitTools::InJobCacheEntry> SvfitTools::inJobCache;
+std::map<SvfitContentKey, std::list<SvfitTools::InJobCacheEntry>::iterator> SvfitTools::inJobCacheIndex;
+
+void SvfitTools::SetInJobCacheSize(size_t inJobCacheSize)
+{
+	this->inJobCacheSize = inJobCacheSize;
+	SvfitTools::inJobCacheCapacity = std::max(SvfitTools::inJobCacheCapacity, inJobCacheSize);
+}
 
 void SvfitTools::Init(std::string const& cacheFileName, std::string const& cacheTreeName)
 {
@@ -635,7 +759,15 @@ void SvfitTools::Init(std::string const& cacheFileName, std::string const& cache
 				LOG(DEBUG) << "\tLoaded SVfit cache trees from file...";
 				LOG(DEBUG) << "\t\t" << cacheFileTreeName << " with " << svfitCacheInputTree->GetEntries() << " Entries";
 
-				svfitEventKey.SetBranchAddresses(svfitCacheInputTree);
+				svfitCacheBranches.SetBranchAddresses(svfitCacheInputTree);
+				svfitCacheBranches.ActivateResultsBranches(svfitCacheInputTree, false);
+				if (svfitCacheInputTree->GetBranch("leptonMomentum1") != nullptr)
+				{
+					// the content is only indexed when it is needed for the first time
+					svfitCacheBranches.ActivateInputsBranches(svfitCacheInputTree, false);
+					SvfitTools::svfitCacheInputUnindexedTrees.insert(svfitCacheInputTree);
+				}
+				SvfitEventKey const& svfitEventKey = svfitCacheBranches.svfitEventKey;
 				std::map<SvfitEventKey, uint64_t> svfitCacheInputTreeIndices;
 				for (uint64_t svfitCacheInputTreeIndex = 0;
 					 svfitCacheInputTreeIndex < uint64_t(svfitCacheInputTree->GetEntries());
@@ -647,10 +779,10 @@ void SvfitTools::Init(std::string const& cacheFileName, std::string const& cache
 					LOG_N_TIMES(10, DEBUG) << std::to_string(svfitEventKey) << " --> " << svfitCacheInputTreeIndex;
 					LOG_N_TIMES(10, DEBUG) << svfitEventKey << " --> " << svfitCacheInputTreeIndex;
 				}
-				svfitEventKey.ActivateBranches(svfitCacheInputTree, false);
+				svfitCacheBranches.SetResultsBranchAddresses(svfitCacheInputTree);
 				LOG(DEBUG) << "\t\t" << svfitCacheInputTreeIndices.size() << " entries found.";
-		
-				svfitResults.SetBranchAddresses(svfitCacheInputTree);
+				
+				SvfitTools::svfitCacheInputTreeBranchAddresses[svfitCacheInputTree] = &svfitCacheBranches;
 			
 				SvfitTools::svfitCacheInputTrees[cacheFileTreeName] = svfitCacheInputTree;
 				SvfitTools::svfitCacheInputTreeIndices[cacheFileTreeName] = svfitCacheInputTreeIndices;
@@ -676,17 +808,48 @@ void SvfitTools::Init(std::string const& cacheFileName, std::string const& cache
 	}
 }
 
-SvfitResults SvfitTools::GetResults(SvfitEventKey const& svfitEventKey,
-                                    SvfitInputs const& svfitInputs,
-                                    bool& neededRecalculation,
-                                    HttEnumTypes::SvfitCacheMissBehaviour svfitCacheMissBehaviour)
+SvfitResults const& SvfitTools::GetResults(SvfitEventKey const& svfitEventKey,
+                                           SvfitInputs const& svfitInputs,
+                                           bool& neededRecalculation,
+                                           HttEnumTypes::SvfitCacheMissBehaviour svfitCacheMissBehaviour)
 {
+	// fast estimates are neither searched for in the cache nor marked for being written to it
+	if (svfitEventKey.GetIntegrationMethod() == SvfitEventKey::IntegrationMethod::COLLINEAR)
+	{
+		neededRecalculation = false;
+		svfitResults.SetCollinearEstimate(svfitInputs);
+		svfitResults.FromFastEstimate();
+		return svfitResults;
+	}
+	
 	neededRecalculation = true;
 	if (Utility::Contains(SvfitTools::svfitCacheInputTrees, cacheFileTreeName) && Utility::Contains(SvfitTools::svfitCacheInputTreeIndices, cacheFileTreeName))
 	{
 		if (Utility::Contains(SafeMap::Get(SvfitTools::svfitCacheInputTreeIndices, cacheFileTreeName), svfitEventKey))
 		{
-			SafeMap::Get(SvfitTools::svfitCacheInputTrees, cacheFileTreeName)->GetEntry(SafeMap::Get(SafeMap::Get(SvfitTools::svfitCacheInputTreeIndices, cacheFileTreeName), svfitEventKey));
+			ReadCacheEntry(SafeMap::Get(SvfitTools::svfitCacheInputTrees, cacheFileTreeName), SafeMap::Get(SafeMap::Get(SvfitTools::svfitCacheInputTreeIndices, cacheFileTreeName), svfitEventKey));
+			svfitResults.FromCache();
+			neededRecalculation = false;
+		}
+	}
+	
+	SvfitContentKey contentKey(svfitEventKey, svfitInputs);
+	if (neededRecalculation)
+	{
+		// identical inputs already processed in this job, e.g. in pipelines with shifts that do not change the inputs.
+		// Results recalculated in this job are reported as such, in order to be written to the caches of all pipelines.
+		if (ReadInJobCache(contentKey))
+		{
+			neededRecalculation = svfitResults.recalculated;
+			return svfitResults;
+		}
+		
+		// identical inputs in any of the loaded cache trees
+		IndexCacheContents();
+		std::map<SvfitContentKey, std::pair<TTree*, uint64_t> >::const_iterator contentIndex = SvfitTools::svfitCacheInputContentIndices.find(contentKey);
+		if (contentIndex != SvfitTools::svfitCacheInputContentIndices.end())
+		{
+			ReadCacheEntry(contentIndex->second.first, contentIndex->second.second);
 			svfitResults.FromCache();
 			neededRecalculation = false;
 		}
@@ -704,12 +867,16 @@ SvfitResults SvfitTools::GetResults(SvfitEventKey const& svfitEventKey,
 		}
 		if(svfitCacheMissBehaviour == HttEnumTypes::SvfitCacheMissBehaviour::undefined)
 		{
+			// no results available, the member still holds the results of the previous event
+			svfitResults = SvfitResults();
 			svfitResults.FromRecalculation();
 			return svfitResults;
 		}
 		
-		// construct algorithm
-		ClassicSVfit svfitAlgorithm = svfitInputs.GetSvfitAlgorithm(0, svfitEventKey, true);
+		// configure algorithm
+		ClassicSVfit& svfitAlgorithm = GetSvfitAlgorithm();
+		svfitInputs.ConfigureSvfitAlgorithm(svfitAlgorithm, svfitEventKey, true);
+		static_cast<MCTauTauQuantitiesAdapter*>(svfitAlgorithm.getHistogramAdapter())->ReleaseHistograms();
 	
 		// execute integration
 		if (svfitEventKey.GetIntegrationMethod() == SvfitEventKey::IntegrationMethod::VEGAS)
@@ -719,8 +886,8 @@ SvfitResults SvfitTools::GetResults(SvfitEventKey const& svfitEventKey,
 		else if (svfitEventKey.GetIntegrationMethod() == SvfitEventKey::IntegrationMethod::MARKOV_CHAIN)
 		{
 			svfitAlgorithm.integrate(svfitInputs.GetMeasuredTauLeptons(svfitEventKey),
-	                                                                             svfitInputs.metMomentum->x(),
-	                                                                             svfitInputs.metMomentum->y(),
+	                                                                             svfitInputs.metMomentum.x(),
+	                                                                             svfitInputs.metMomentum.y(),
 	                                                                             svfitInputs.GetMetCovarianceMatrix());
 		}
 		else if (svfitEventKey.GetIntegrationMethod() == SvfitEventKey::IntegrationMethod::FIT)
@@ -737,9 +904,99 @@ SvfitResults SvfitTools::GetResults(SvfitEventKey const& svfitEventKey,
 		svfitResults.FromRecalculation();
 	}
 	
+	WriteInJobCache(contentKey);
 	return svfitResults;
 }
 
+void SvfitTools::IndexCacheContents()
+{
+	for (TTree* svfitCacheInputTree : SvfitTools::svfitCacheInputUnindexedTrees)
+	{
+		svfitCacheBranches.SetBranchAddresses(svfitCacheInputTree);
+		svfitCacheBranches.ActivateResultsBranches(svfitCacheInputTree, false);
+		for (uint64_t svfitCacheInputTreeIndex = 0;
+			 svfitCacheInputTreeIndex < uint64_t(svfitCacheInputTree->GetEntries());
+			 ++svfitCacheInputTreeIndex)
+		{
+			svfitCacheInputTree->GetEntry(svfitCacheInputTreeIndex);
+			
+			// the first entry with the same content is kept
+			SvfitTools::svfitCacheInputContentIndices.emplace(SvfitContentKey(svfitCacheBranches.svfitEventKey, svfitCacheBranches.svfitInputs),
+			                                                  std::make_pair(svfitCacheInputTree, svfitCacheInputTreeIndex));
+		}
+		svfitCacheBranches.SetResultsBranchAddresses(svfitCacheInputTree);
+		SvfitTools::svfitCacheInputTreeBranchAddresses[svfitCacheInputTree] = &svfitCacheBranches;
+		LOG(DEBUG) << "\tIndexed the contents of SVfit cache tree with " << svfitCacheInputTree->GetEntries() << " entries.";
+	}
+	SvfitTools::svfitCacheInputUnindexedTrees.clear();
+}
+
+void SvfitTools::ReadCacheEntry(TTree* svfitCacheInputTree, uint64_t svfitCacheInputTreeIndex)
+{
+	// cache trees are shared between all instances, the branch addresses might point to the branches of another one
+	SvfitCacheBranches*& branchAddresses = SvfitTools::svfitCacheInputTreeBranchAddresses[svfitCacheInputTree];
+	if (branchAddresses != &svfitCacheBranches)
+	{
+		svfitCacheBranches.SetResultsBranchAddresses(svfitCacheInputTree);
+		branchAddresses = &svfitCacheBranches;
+	}
+	svfitCacheInputTree->GetEntry(svfitCacheInputTreeIndex);
+	svfitResults = svfitCacheBranches.svfitResults;
+	svfitResults.available = true;
+}
+
+ClassicSVfit& SvfitTools::GetSvfitAlgorithm()
+{
+	if (! svfitAlgorithm)
+	{
+		svfitAlgorithm.reset(new ClassicSVfit(0));
+		svfitAlgorithm->setHistogramAdapter(new MCTauTauQuantitiesAdapter());
+	}
+	return *svfitAlgorithm;
+}
+
+bool SvfitTools::ReadInJobCache(SvfitContentKey const& contentKey)
+{
+	if (inJobCacheSize == 0)
+	{
+		return false;
+	}
+	
+	std::map<SvfitContentKey, std::list<InJobCacheEntry>::iterator>::iterator entry = SvfitTools::inJobCacheIndex.find(contentKey);
+	if (entry == SvfitTools::inJobCacheIndex.end())
+	{
+		return false;
+	}
+	
+	SvfitTools::inJobCache.splice(SvfitTools::inJobCache.begin(), SvfitTools::inJobCache, entry->second);
+	svfitResults = entry->second->svfitResults;
+	return true;
+}
+
+void SvfitTools::WriteInJobCache(SvfitContentKey const& contentKey)
+{
+	if ((inJobCacheSize == 0) || (! svfitResults.available))
+	{
+		return;
+	}
+	
+	std::map<SvfitContentKey, std::list<InJobCacheEntry>::iterator>::iterator entry = SvfitTools::inJobCacheIndex.find(contentKey);
+	if (entry != SvfitTools::inJobCacheIndex.end())
+	{
+		SvfitTools::inJobCache.splice(SvfitTools::inJobCache.begin(), SvfitTools::inJobCache, entry->second);
+		return;
+	}
+	
+	SvfitTools::inJobCache.push_front(InJobCacheEntry{contentKey, svfitResults});
+	SvfitTools::inJobCacheIndex[contentKey] = SvfitTools::inJobCache.begin();
+	
+	if (SvfitTools::inJobCache.size() > SvfitTools::inJobCacheCapacity)
+	{
+		SvfitTools::inJobCacheIndex.erase(SvfitTools::inJobCache.back().contentKey);
+		SvfitTools::inJobCache.pop_back();
+	}
+}
+
 SvfitTools::~SvfitTools()
 {
 	/*if (m_visPtResolutionFile)
@@ -749,10 +1006,52 @@ SvfitTools::~SvfitTools()
 	
 	if (Utility::Contains(SvfitTools::svfitCacheInputFiles, cacheFileName) && SafeMap::Get(SvfitTools::svfitCacheInputFiles, cacheFileName)->IsOpen())
 	{
+		// the trees of the file are deleted when closing it and must not be referenced by any of the indices
+		std::set<TTree*> closedTrees;
+		std::string treeNamePrefix = cacheFileName + "/";
+		for (std::map<std::string, TTree*>::iterator tree = SvfitTools::svfitCacheInputTrees.begin(); tree != SvfitTools::svfitCacheInputTrees.end();)
+		{
+			if (tree->first.compare(0, treeNamePrefix.size(), treeNamePrefix) == 0)
+			{
+				closedTrees.insert(tree->second);
+				SvfitTools::svfitCacheInputTreeIndices.erase(tree->first);
+				tree = SvfitTools::svfitCacheInputTrees.erase(tree);
+			}
+			else
+			{
+				++tree;
+			}
+		}
+		for (std::map<SvfitContentKey, std::pair<TTree*, uint64_t> >::iterator contentIndex = SvfitTools::svfitCacheInputContentIndices.begin();
+		     contentIndex != SvfitTools::svfitCacheInputContentIndices.end();)
+		{
+			if (closedTrees.count(contentIndex->second.first) > 0)
+			{
+				contentIndex = SvfitTools::svfitCacheInputContentIndices.erase(contentIndex);
+			}
+			else
+			{
+				++contentIndex;
+			}
+		}
+		for (TTree* closedTree : closedTrees)
+		{
+			SvfitTools::svfitCacheInputTreeBranchAddresses.erase(closedTree);
+			SvfitTools::svfitCacheInputUnindexedTrees.erase(closedTree);
+		}
+		
 		SafeMap::Get(SvfitTools::svfitCacheInputFiles, cacheFileName)->Close();
 		SvfitTools::svfitCacheInputFiles.erase(cacheFileName);
 	}
 	
+	for (std::pair<TTree* const, SvfitCacheBranches*>& branchAddresses : SvfitTools::svfitCacheInputTreeBranchAddresses)
+	{
+		if (branchAddresses.second == &svfitCacheBranches)
+		{
+			branchAddresses.second = nullptr;
+		}
+	}
+	
 	// do NOT call destructor for TTree and TFile here. They are static and the destructor is called several times when running the factory
 	// We have to trust the OS does handle freeing the memory properly
 }
@@ -0,0 +1,94 @@
+
+#include <algorithm>
+#include <cmath>
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/TabulatedQuantileShifter.h"
+
+
+void TabulatedQuantileShifter::Build(mapping_function const& mapping, double xMin, double xMax,
+                                     size_t nInitialPoints, size_t nMaxPoints, double tolerance)
+{
+	m_x.clear();
+	m_y.clear();
+	m_maxDeviation = 0.0;
+	m_monotone = true;
+
+	if ((! (xMin < xMax)) || (nInitialPoints < 2))
+	{
+		return;
+	}
+	nMaxPoints = std::max(nMaxPoints, nInitialPoints);
+
+	for (size_t index = 0; index < nInitialPoints; ++index)
+	{
+		double x = xMin + (xMax - xMin) * double(index) / double(nInitialPoints - 1);
+		m_x.push_back(x);
+		m_y.push_back(mapping(x));
+	}
+
+	// refine intervals with too large midpoint deviation until the table converges or is full
+	bool refined = true;
+	while (refined)
+	{
+		refined = false;
+		m_maxDeviation = 0.0;
+
+		std::vector<double> x;
+		std::vector<double> y;
+		x.reserve(std::min(2 * m_x.size(), nMaxPoints));
+		y.reserve(std::min(2 * m_y.size(), nMaxPoints));
+		size_t nRemainingPoints = nMaxPoints - m_x.size();
+
+		for (size_t index = 0; index + 1 < m_x.size(); ++index)
+		{
+			x.push_back(m_x[index]);
+			y.push_back(m_y[index]);
+
+			double xMid = 0.5 * (m_x[index] + m_x[index + 1]);
+			double yMid = mapping(xMid);
+			double deviation = std::abs(yMid - 0.5 * (m_y[index] + m_y[index + 1]));
+			if ((deviation > tolerance) && (nRemainingPoints > 0))
+			{
+				x.push_back(xMid);
+				y.push_back(yMid);
+				--nRemainingPoints;
+				refined = true;
+			}
+			else
+			{
+				m_maxDeviation = std::max(m_maxDeviation, deviation);
+			}
+		}
+		x.push_back(m_x.back());
+		y.push_back(m_y.back());
+
+		m_x.swap(x);
+		m_y.swap(y);
+	}
+
+	for (size_t index = 0; index + 1 < m_y.size(); ++index)
+	{
+		if (m_y[index + 1] < m_y[index])
+		{
+			m_monotone = false;
+			break;
+		}
+	}
+}
+
+double TabulatedQuantileShifter::Shift(double x) const
+{
+	size_t upper = std::upper_bound(m_x.begin(), m_x.end(), x) - m_x.begin();
+	if (upper >= m_x.size())
+	{
+		return m_y.back();
+	}
+	else if (upper == 0)
+	{
+		return m_y.front();
+	}
+	size_t lower = upper - 1;
+	double fraction = (x - m_x[lower]) / (m_x[upper] - m_x[lower]);
+	return m_y[lower] + fraction * (m_y[upper] - m_y[lower]);
+}
+
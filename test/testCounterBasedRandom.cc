@@ -0,0 +1,14 @@
+#include <iostream>
+
+#include "HiggsAnalysis/KITHiggsToTauTau/interface/Utility/CounterBasedRandom.h"
+
+// Philox4x32-10 has to reproduce the known answers of the Random123 reference implementation
+int main()
+{
+	if (! CounterBasedRandom::CheckKnownAnswers())
+	{
+		std::cerr << "Philox4x32-10 does not reproduce the known answers of the reference implementation!" << std::endl;
+		return 1;
+	}
+	return 0;
+}